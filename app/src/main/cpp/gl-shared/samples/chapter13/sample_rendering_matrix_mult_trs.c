@@ -143,6 +143,7 @@ void sample_ShaderMatrixMultiplyTRS_rendering(GLApplication *app) {
 
         // 行列をアップロードする
         {
+#if 1
             // 移動行列
             const mat4 translate = mat4_translate(0.5f, 0.5f, 0.0f);
             // 拡大縮小行列
@@ -153,6 +154,11 @@ void sample_ShaderMatrixMultiplyTRS_rendering(GLApplication *app) {
             // シェーダーに渡す前に行列を計算済みにしておく
             mat4 matrix = mat4_multiply(translate, rotate);
             matrix = mat4_multiply(matrix, scale);
+#else
+            // 0になる項を省いて、移動・回転・拡縮を1度に計算する
+            mat4 matrix;
+            mat4_createTRSZ(&matrix, 0.5f, 0.5f, 0.0f, extension->rotate, 0.5f, 2.0f, 1.0f);
+#endif
 
             glUniformMatrix4fv(extension->unif_matrix, 1, GL_FALSE, (GLfloat*) matrix.m);
 
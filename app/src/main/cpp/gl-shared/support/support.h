@@ -12,6 +12,7 @@
 #include    <stdio.h>
 #include    <stdlib.h>
 #include    <stdbool.h>
+#include    <stdint.h>
 #include    <assert.h>
 #include    <string.h>
 #include    <math.h>
@@ -30,12 +31,17 @@
 
 #endif
 
-#else // ANDROID
+#elif defined(__ANDROID__) // ANDROID
 #include    <android/log.h>
 #define __LOG_TAG   "GLES20"
 #define __log(msg)       __android_log_print(ANDROID_LOG_DEBUG, __LOG_TAG, "%s", msg)
 #define __logf(...)      __android_log_print(ANDROID_LOG_DEBUG, __LOG_TAG, __VA_ARGS__)
 
+#else
+// Host (tools/texture_cooker等)
+#define     __log(message)        printf("%s\n", message)
+#define     __logf(...)           (printf(__VA_ARGS__), printf("\n"))
+
 #endif
 
 /**
@@ -140,6 +146,12 @@ extern char* util_getFileName(char* __file__);
  */
 extern void GLApplication_abortWithMessage(GLApplication *app, const char* message);
 
+/**
+ * アプリ専用のキャッシュディレクトリのパスを取得する。
+ * 取得できない場合はNULLを返す。
+ */
+extern const char* GLApplication_getCacheDirectory(GLApplication *app);
+
 /**
  * アプリ実行を停止している場合はapp_TRUE
  */
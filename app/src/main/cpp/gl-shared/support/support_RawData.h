@@ -23,11 +23,46 @@ typedef struct RawData {
     uint8_t *read_head;
 } RawData;
 
+/**
+ * 全体を読み込まずに、必要な範囲だけを読み込むファイル
+ * タイルパック等、メモリに収まらない大きなファイルを扱うために利用する。
+ */
+typedef struct RawFile {
+    /**
+     * ファイルの長さ（byte）
+     */
+    int64_t length;
+
+    /**
+     * プラットフォーム固有データを格納する。
+     */
+    void* platform;
+} RawFile;
+
 /**
  * assets配下からファイルを読み込む
  */
 extern RawData* RawData_loadFile(GLApplication *app, const char* file_name);
 
+/**
+ * ファイルを範囲読込用に開く。
+ * '/'から始まる場合はファイルシステム上の絶対パス、それ以外はassets配下のファイルとして扱う。
+ * assets配下のファイルはAPK内で圧縮されていると読込のたびに先頭から展開されるため、非圧縮で格納する必要がある。
+ * 開いたファイルはRawFile_close()で閉じる。
+ */
+extern RawFile* RawFile_open(GLApplication *app, const char* file_name);
+
+/**
+ * offsetの位置からbytesを読み込む。
+ * 指定範囲を全て読み込めた場合trueを返す。
+ */
+extern bool RawFile_read(RawFile *file, const int64_t offset, void *result, const int bytes);
+
+/**
+ * RawFile_open()で開いたファイルを閉じる
+ */
+extern void RawFile_close(GLApplication *app, RawFile *file);
+
 /**
  * 読み込んだファイルを解放する
  */
@@ -48,14 +48,75 @@ int ES20_printFramebufferError(char* file, int line) {
     return ES20_ERROR;
 }
 
+/**
+ * Extension一覧のキャッシュ
+ * glGetString(GL_EXTENSIONS)は1度だけ取得し、空白区切りの名前をソートして保持する。
+ */
+static char *g_extensions_buffer = NULL;
+static const char **g_extensions = NULL;
+static int g_extensions_num = 0;
+
+/**
+ * qsort/bsearch用の比較関数
+ */
+static int ES20_compareExtension(const void *a, const void *b) {
+    return strcmp(*(const char**) a, *(const char**) b);
+}
+
+/**
+ * Extension一覧を読み込み、キャッシュする。
+ * 読み込み済みの場合は何も行わない。
+ */
+void ES20_loadExtensions() {
+    if (g_extensions_buffer) {
+        return;
+    }
+
+    const char *extensions = (const char*) glGetString(GL_EXTENSIONS);
+    if (!extensions) {
+        // コンテキストが無い場合、次回に読み込みを行う
+        return;
+    }
+
+    g_extensions_buffer = strdup(extensions);
+
+    {
+        // 名前の最大数は空白の数+1を超えない
+        int capacity = 1;
+        const char *p = g_extensions_buffer;
+        while (*p) {
+            if (*p == ' ') {
+                ++capacity;
+            }
+            ++p;
+        }
+        g_extensions = (const char**) malloc(sizeof(const char*) * capacity);
+    }
+
+    {
+        char *save = NULL;
+        char *name = strtok_r(g_extensions_buffer, " ", &save);
+        while (name) {
+            g_extensions[g_extensions_num++] = name;
+            name = strtok_r(NULL, " ", &save);
+        }
+    }
+
+    qsort(g_extensions, g_extensions_num, sizeof(const char*), ES20_compareExtension);
+}
+
 /**
  * 特定のExtensionに対応していればtrueを返す。
  * 対応していない場合、falseを返す
  */
 bool ES20_hasExtension(const char* extension) {
-    const GLubyte* EXTENSIONS = glGetString(GL_EXTENSIONS);
+    ES20_loadExtensions();
+
+    if (!g_extensions_num) {
+        return false;
+    }
 
-    // 文字列が見つかればtrue、見つからなければfalse
-    return strstr((const char* const) EXTENSIONS, extension) != NULL;
+    // 前方一致で別のExtensionを誤判定しないよう、名前単位で比較する
+    return bsearch(&extension, g_extensions, g_extensions_num, sizeof(const char*), ES20_compareExtension) != NULL;
 }
 
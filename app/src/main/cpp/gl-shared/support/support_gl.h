@@ -43,9 +43,16 @@ extern int ES20_printGLError(char* file, int line);
  */
 extern int ES20_printFramebufferError(char* file, int line);
 
+/**
+ * Extension一覧をglGetString(GL_EXTENSIONS)から読み込み、キャッシュする。
+ * 起動時に1度呼び出す。呼び出していない場合はES20_hasExtension()の初回に読み込まれる。
+ */
+extern void ES20_loadExtensions();
+
 /**
  * 特定のExtensionに対応していればtrueを返す。
  * 対応していない場合、falseを返す
+ * Extension名は単語単位で比較するため、前方一致する別のExtensionには反応しない。
  */
 extern bool ES20_hasExtension(const char* extension);
 
@@ -75,7 +82,17 @@ extern void ES20_sjis2utf8(GLchar *str, const int array_length);
 #include    "support_gl_Shader.h"
 #include    "support_gl_Texture.h"
 #include    "support_gl_CompressedTexture.h"
+#include    "support_gl_TextureManifest.h"
+#include    "support_gl_TextureUploader.h"
+#include    "support_gl_TextureResidency.h"
+#include    "support_gl_VirtualTexture.h"
 #include    "support_gl_Vector.h"
 #include    "support_gl_Sprite.h"
+#include    "support_gl_TextureAtlas.h"
+#include    "support_gl_TextureCache.h"
+#include    "support_gl_Transform.h"
+#include    "support_gl_Camera.h"
+#include    "support_gl_Cull.h"
+#include    "support_gl_SpatialGrid.h"
 
 #endif
@@ -0,0 +1,201 @@
+/*
+ * support_gl_Camera.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+
+/**
+ * カメラを生成する。
+ * mat4を16byte境界へ配置するため、posix_memalign()で確保する。
+ */
+Camera* Camera_create(const int projection_type) {
+    Camera *result = NULL;
+
+    assert(projection_type == CAMERA_PROJECTION_ORTHO || projection_type == CAMERA_PROJECTION_PERSPECTIVE || projection_type == CAMERA_PROJECTION_PIXEL);
+
+    if (posix_memalign((void**) &result, 16, sizeof(Camera)) != 0) {
+        __log("Camera_create alloc failed");
+        return NULL;
+    }
+    memset(result, 0, sizeof(Camera));
+
+    result->projection_type = projection_type;
+    result->surface_width = 1;
+    result->surface_height = 1;
+    result->ortho_height = 2.0f;
+    result->fovy = 45.0f;
+    result->near = 0.1f;
+    result->far = 100.0f;
+
+    result->eye = vec3_create(0.0f, 0.0f, 1.0f);
+    result->target = vec3_create(0.0f, 0.0f, 0.0f);
+    result->up = vec3_create(0.0f, 1.0f, 0.0f);
+
+    result->projection_dirty = true;
+    result->view_dirty = true;
+    result->view_projection_dirty = true;
+
+    return result;
+}
+
+/**
+ * サーフェイスサイズを設定する。
+ */
+void Camera_resize(Camera *camera, const int surface_width, const int surface_height) {
+    assert(camera);
+    assert(surface_width > 0 && surface_height > 0);
+
+    if (camera->surface_width == surface_width && camera->surface_height == surface_height) {
+        return;
+    }
+
+    camera->surface_width = surface_width;
+    camera->surface_height = surface_height;
+    camera->projection_dirty = true;
+    camera->view_projection_dirty = true;
+}
+
+/**
+ * 正射影に切り替え、表示する高さと奥行きを設定する
+ */
+void Camera_setOrtho(Camera *camera, const GLfloat height, const GLfloat near, const GLfloat far) {
+    assert(camera);
+
+    camera->projection_type = CAMERA_PROJECTION_ORTHO;
+    camera->ortho_height = height;
+    camera->near = near;
+    camera->far = far;
+    camera->projection_dirty = true;
+    camera->view_projection_dirty = true;
+}
+
+/**
+ * 透視射影に切り替え、垂直画角と奥行きを設定する
+ */
+void Camera_setPerspective(Camera *camera, const GLfloat fovy, const GLfloat near, const GLfloat far) {
+    assert(camera);
+    assert(near > 0.0f);
+
+    camera->projection_type = CAMERA_PROJECTION_PERSPECTIVE;
+    camera->fovy = fovy;
+    camera->near = near;
+    camera->far = far;
+    camera->projection_dirty = true;
+    camera->view_projection_dirty = true;
+}
+
+/**
+ * ピクセル座標の正射影に切り替える
+ */
+void Camera_setPixel(Camera *camera) {
+    assert(camera);
+
+    camera->projection_type = CAMERA_PROJECTION_PIXEL;
+    camera->projection_dirty = true;
+    camera->view_projection_dirty = true;
+}
+
+/**
+ * カメラの位置・注視点・上方向を設定する
+ */
+void Camera_lookAt(Camera *camera, const vec3 *eye, const vec3 *target, const vec3 *up) {
+    assert(camera);
+
+    camera->eye = (*eye);
+    camera->target = (*target);
+    camera->up = (*up);
+    camera->view_dirty = true;
+    camera->view_projection_dirty = true;
+}
+
+/**
+ * 射影行列を取得する
+ */
+const mat4* Camera_getProjection(Camera *camera) {
+    assert(camera);
+
+    if (!camera->projection_dirty) {
+        return &camera->projection;
+    }
+
+    const GLfloat width = (GLfloat) camera->surface_width;
+    const GLfloat height = (GLfloat) camera->surface_height;
+    const GLfloat aspect = width / height;
+
+    switch (camera->projection_type) {
+        case CAMERA_PROJECTION_ORTHO: {
+            const GLfloat half_height = camera->ortho_height * 0.5f;
+            const GLfloat half_width = half_height * aspect;
+            mat4_ortho_to(&camera->projection, -half_width, half_width, -half_height, half_height, camera->near, camera->far);
+        }
+            break;
+        case CAMERA_PROJECTION_PERSPECTIVE:
+            mat4_perspective_to(&camera->projection, camera->fovy, aspect, camera->near, camera->far);
+            break;
+        default:
+            // 上下を反転し、左上を原点とする
+            mat4_ortho_to(&camera->projection, 0.0f, width, height, 0.0f, camera->near, camera->far);
+            break;
+    }
+
+    camera->projection_dirty = false;
+    return &camera->projection;
+}
+
+/**
+ * ビュー行列を取得する
+ */
+const mat4* Camera_getView(Camera *camera) {
+    assert(camera);
+
+    if (camera->view_dirty) {
+        mat4_lookAt_to(&camera->view, &camera->eye, &camera->target, &camera->up);
+        camera->view_dirty = false;
+    }
+
+    return &camera->view;
+}
+
+/**
+ * 射影行列×ビュー行列を取得する
+ */
+const mat4* Camera_getViewProjection(Camera *camera) {
+    assert(camera);
+
+    if (camera->view_projection_dirty) {
+        mat4_multiply_to(&camera->view_projection, Camera_getProjection(camera), Camera_getView(camera));
+        camera->view_projection_dirty = false;
+    }
+
+    return &camera->view_projection;
+}
+
+/**
+ * モデル行列にビュー・射影を適用した行列をresultへ書き込む
+ */
+void Camera_createMVP(Camera *camera, const mat4 *model, mat4 *result) {
+    mat4_multiply_to(result, Camera_getViewProjection(camera), model);
+}
+
+/**
+ * スプライトを描画する行列をresultへ書き込む。
+ * ポリゴンは上方向が+Yのため、Y方向へ-heightで拡縮してピクセル座標（下方向が+Y）へ合わせる。
+ * 下方向が+Yの座標系では回転方向が反転するため、角度の符号も反転する。
+ */
+void Camera_createSpriteMatrix(Camera *camera, const GLfloat x, const GLfloat y, const GLfloat width, const GLfloat height, const GLfloat rotate, mat4 *result) {
+    mat4 model;
+
+    assert(camera->projection_type == CAMERA_PROJECTION_PIXEL);
+
+    mat4_createTRSZ(&model, x + width * 0.5f, y + height * 0.5f, 0.0f, -rotate, width, -height, 1.0f);
+    Camera_createMVP(camera, &model, result);
+}
+
+/**
+ * カメラを解放する
+ */
+void Camera_free(Camera *camera) {
+    free(camera);
+}
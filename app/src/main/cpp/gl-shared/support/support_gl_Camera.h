@@ -0,0 +1,185 @@
+/*
+ * support_gl_Camera.h
+ *
+ *  Created on: 2026/10/19
+ */
+
+#ifndef SUPPORT_GL_CAMERA_H_
+#define SUPPORT_GL_CAMERA_H_
+
+#include    "support.h"
+
+/**
+ * 正射影
+ * 画面の高さをortho_height、幅をアスペクト比から決める。
+ */
+#define CAMERA_PROJECTION_ORTHO          0
+
+/**
+ * 透視射影
+ */
+#define CAMERA_PROJECTION_PERSPECTIVE    1
+
+/**
+ * ピクセル座標の正射影
+ * 左上を(0, 0)、右下を(surface_width, surface_height)とし、1単位が1pixelに一致する。
+ */
+#define CAMERA_PROJECTION_PIXEL          2
+
+/**
+ * 射影行列とビュー行列を保持するカメラ
+ *
+ * 射影行列はサーフェイスサイズか射影設定の変更時、ビュー行列はカメラの移動時にだけ再計算され、
+ * ビュー×射影行列はその次の取得時に1度だけ計算される。
+ * 描画ごとの処理はCamera_createMVP()による1回の乗算で済む。
+ */
+typedef struct Camera {
+    /**
+     * CAMERA_PROJECTION_XXX
+     */
+    int projection_type;
+
+    /**
+     * サーフェイス幅(pixel)
+     */
+    int surface_width;
+
+    /**
+     * サーフェイス高さ(pixel)
+     */
+    int surface_height;
+
+    /**
+     * CAMERA_PROJECTION_ORTHOで表示する高さ
+     */
+    GLfloat ortho_height;
+
+    /**
+     * CAMERA_PROJECTION_PERSPECTIVEの垂直画角(360度系)
+     */
+    GLfloat fovy;
+
+    /**
+     * 描画する手前の距離
+     */
+    GLfloat near;
+
+    /**
+     * 描画する奥の距離
+     */
+    GLfloat far;
+
+    /**
+     * カメラの位置
+     */
+    vec3 eye;
+
+    /**
+     * カメラの注視点
+     */
+    vec3 target;
+
+    /**
+     * カメラの上方向
+     */
+    vec3 up;
+
+    /**
+     * 射影行列の再計算が必要な場合true
+     */
+    bool projection_dirty;
+
+    /**
+     * ビュー行列の再計算が必要な場合true
+     */
+    bool view_dirty;
+
+    /**
+     * ビュー×射影行列の再計算が必要な場合true
+     */
+    bool view_projection_dirty;
+
+    /**
+     * 射影行列
+     */
+    mat4 projection;
+
+    /**
+     * ビュー行列
+     */
+    mat4 view;
+
+    /**
+     * 射影行列×ビュー行列
+     */
+    mat4 view_projection;
+} Camera;
+
+/**
+ * カメラを生成する。
+ * projection_typeにはCAMERA_PROJECTION_XXXを指定する。
+ * カメラは(0, 0, 1)から原点を向き、上方向は(0, 1, 0)で初期化される。
+ * 不要になったらCamera_free()で解放する。
+ */
+extern Camera* Camera_create(const int projection_type);
+
+/**
+ * サーフェイスサイズを設定する。
+ * アプリのresized時に呼び出す。サイズが変わらない場合は何もしない。
+ */
+extern void Camera_resize(Camera *camera, const int surface_width, const int surface_height);
+
+/**
+ * 正射影に切り替え、表示する高さと奥行きを設定する
+ */
+extern void Camera_setOrtho(Camera *camera, const GLfloat height, const GLfloat near, const GLfloat far);
+
+/**
+ * 透視射影に切り替え、垂直画角(360度系)と奥行きを設定する
+ */
+extern void Camera_setPerspective(Camera *camera, const GLfloat fovy, const GLfloat near, const GLfloat far);
+
+/**
+ * ピクセル座標の正射影に切り替える
+ */
+extern void Camera_setPixel(Camera *camera);
+
+/**
+ * カメラの位置・注視点・上方向を設定する
+ */
+extern void Camera_lookAt(Camera *camera, const vec3 *eye, const vec3 *target, const vec3 *up);
+
+/**
+ * 射影行列を取得する
+ */
+extern const mat4* Camera_getProjection(Camera *camera);
+
+/**
+ * ビュー行列を取得する
+ */
+extern const mat4* Camera_getView(Camera *camera);
+
+/**
+ * 射影行列×ビュー行列を取得する
+ */
+extern const mat4* Camera_getViewProjection(Camera *camera);
+
+/**
+ * モデル行列にビュー・射影を適用した行列をresultへ書き込む
+ */
+extern void Camera_createMVP(Camera *camera, const mat4 *model, mat4 *result);
+
+/**
+ * スプライトを描画する行列をresultへ書き込む。
+ * CAMERA_PROJECTION_PIXELでのみ利用でき、x/y/width/heightはpixel単位で指定する。
+ * 描画元となるポリゴンはSprite_createPositionMatrix()と同じく、原点を中心に幅1.0/高さ1.0の四角形である必要がある。
+ * 回転方向もSprite_createPositionMatrix()と一致する。
+ */
+extern void Camera_createSpriteMatrix(Camera *camera, const GLfloat x, const GLfloat y, const GLfloat width, const GLfloat height, const GLfloat rotate, mat4 *result);
+
+/**
+ * カメラを解放する
+ */
+extern void Camera_free(Camera *camera);
+
+#endif /* SUPPORT_GL_CAMERA_H_ */
@@ -10,6 +10,9 @@
 #include    "support.h"
 #include    "support_RawData.h"
 
+struct Texture;
+struct RawPixelImage;
+
 /**
  * 圧縮テクスチャ ETC1-PKM形式
  * Android標準サポート
@@ -28,10 +31,29 @@
  */
 #define TEXTURE_COMPRESS_KTX          12
 
+/**
+ * 圧縮テクスチャ ETC1A形式（ETC1-PKM形式の拡張）
+ * 1枚のPKMの上部にカラー、ETC1A_GUTTER_HEIGHTの隙間を空けて下部にアルファ（グレースケール）をETC1で格納する。
+ * サンプリングにはSHADER_SOURCE_ETC1A_SAMPLERを利用する。
+ *
+ * 8bit / pixel
+ */
+#define TEXTURE_COMPRESS_ETC1A        13
+
+/**
+ * ETC1Aのカラー/アルファ間の隙間（1ブロック分）
+ * GL_LINEARでカラーの最終行とアルファの先頭行が混ざらないよう、カラーの最終ブロック行を複製して埋める。
+ */
+#define ETC1A_GUTTER_HEIGHT           4
+
+/**
+ * ETC1A画像全体の高さから、カラー（アルファ）1面分の高さを求める
+ */
+#define ETC1A_getPlaneHeight(image_height)      (((image_height) - ETC1A_GUTTER_HEIGHT) / 2)
 
 /**
  * PKMフォーマット画像
- * Android標準ツールで作成可能
+ * Android標準ツール、またはtools/texture_cookerで作成可能
  */
 typedef struct PkmImage {
     /**
@@ -82,11 +104,40 @@ typedef struct PkmImage {
  */
 extern PkmImage* PkmImage_load(GLApplication *app, const char* file_name);
 
+/**
+ * 読み込み済みのファイルからPKM圧縮画像を作成する。
+ * rawの所有権は戻り値へ移り、失敗した場合はrawを解放してNULLを返す。
+ */
+extern PkmImage* PkmImage_loadFromRawData(GLApplication *app, RawData *raw);
+
+/**
+ * 読み込み済みのPKM圧縮画像からテクスチャを作成する。
+ * pixel_formatにはTEXTURE_COMPRESS_ETC1かTEXTURE_COMPRESS_ETC1Aを指定する。
+ */
+extern struct Texture* PkmImage_createTexture(GLApplication *app, PkmImage *pkm, const int pixel_format);
+
 /**
  * PKM圧縮画像を解放する
  */
 extern void PkmImage_free(GLApplication *app, PkmImage *pkm);
 
+/**
+ * RGBA8888/RGB888のピクセル配列をETC1ブロックへ圧縮する。
+ * widthとheightは4の倍数に切り上げて扱われ、はみ出した領域は端のピクセルで埋められる。
+ * alpha_planeがtrueの場合、カラーの代わりにアルファ値をグレースケールとして圧縮する。
+ * dst_blocksには ((width + 3) / 4) * ((height + 3) / 4) * 8 byteの領域が必要になる。
+ */
+extern void Etc1_encodeImage(const void *pixels, const int pixel_format, const int width, const int height, const bool alpha_plane, void *dst_blocks);
+
+/**
+ * 画像をETC1圧縮し、PKMファイルイメージを作成する。
+ * with_alphaがtrueの場合、カラーとアルファを隙間を空けて上下に並べたETC1A形式で作成する。
+ * 画像はTEXTURE_RAW_RGBA8かTEXTURE_RAW_RGB8である必要がある。
+ * 戻り値はfree()で解放し、長さはresult_bytesへ格納される。
+ * メモリを確保できなかった場合はNULLを返す。
+ */
+extern void* PkmImage_encode(const struct RawPixelImage *image, const bool with_alpha, int *result_bytes);
+
 
 /**
  * PVRTCフォーマット画像
@@ -148,6 +199,18 @@ typedef struct PvrtcImage {
  */
 extern PvrtcImage* PvrtcImage_load(GLApplication *app, const char *file_name);
 
+/**
+ * 読み込み済みのファイルからPVRTC圧縮画像を作成する。
+ * PVR v2(legacy)とPVR v3のヘッダに対応する。
+ * rawの所有権は戻り値へ移り、失敗した場合はrawを解放してNULLを返す。
+ */
+extern PvrtcImage* PvrtcImage_loadFromRawData(GLApplication *app, RawData *raw);
+
+/**
+ * 読み込み済みのPVRTC圧縮画像からテクスチャを作成する。
+ */
+extern struct Texture* PvrtcImage_createTexture(GLApplication *app, PvrtcImage *pvrtc);
+
 /**
  * PVRTC圧縮画像を解放する
  */
@@ -157,7 +220,8 @@ extern void PvrtcImage_free(GLApplication *app, PvrtcImage *pvrtc);
 /**
  * KTXフォーマットデータ
  * 詳細：http://www.khronos.org/opengles/sdk/tools/KTX/file_format_spec/
- * Qualcomm Texture Tool(Windows専用）で作成可能
+ * Qualcomm Texture Tool(Windows専用）、またはtools/texture_cookerで作成可能
+ * 圧縮テクスチャ(glType == 0)と非圧縮テクスチャの両方に対応する
  */
 typedef struct KtxImage {
     /**
@@ -167,14 +231,14 @@ typedef struct KtxImage {
 
     /**
      * 格納されたテクスチャのフォーマット
-     * RGB, RGBA, BGRA, etc.
+     * 非圧縮の場合はglFormat(RGB, RGBA, etc.)、圧縮の場合はglInternalFormat(ETC1_RGB8_OES, etc.)
      */
     GLenum format;
 
     /**
      * 格納されたテクスチャのピクセルタイプ
      * UNSIGNED_BYTE, UNSIGNED_SHORT_5_6_5, etc.
-     * 必ず0以外の値が格納される
+     * 圧縮テクスチャの場合は0が格納される
      */
     GLenum type;
 
@@ -214,6 +278,17 @@ typedef struct KtxImage {
  */
 extern KtxImage* KtxImage_load(GLApplication *app, const char* file_name);
 
+/**
+ * 読み込み済みのファイルからKTX画像を作成する。
+ * rawの所有権は戻り値へ移り、失敗した場合はrawを解放してNULLを返す。
+ */
+extern KtxImage* KtxImage_loadFromRawData(GLApplication *app, RawData *raw);
+
+/**
+ * 読み込み済みのKTX画像からテクスチャを作成する。
+ */
+extern struct Texture* KtxImage_createTexture(GLApplication *app, KtxImage *ktx);
+
 /**
  * KTXファイルを解放する
  */
@@ -0,0 +1,245 @@
+/*
+ * support_gl_CompressedTexture_Etc1Encoder.c
+ *
+ *  Created on: 2026/10/19
+ */
+#include    "support.h"
+
+/**
+ * ETC1の輝度変調テーブル
+ * 各テーブルは{小さい変調値, 大きい変調値}を保持する
+ */
+static const int ETC1_MODIFIER_TABLE[8][2] = { { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 } };
+
+/**
+ * 0〜255に丸める
+ */
+static int Etc1_clamp(const int value) {
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+/**
+ * ピクセルインデックス(0〜3)から変調値を取得する
+ * 00 = +a / 01 = +b / 10 = -a / 11 = -b
+ */
+static int Etc1_modifier(const int table, const int index) {
+    const int value = ETC1_MODIFIER_TABLE[table][index & 0x1];
+    return (index & 0x2) ? -value : value;
+}
+
+/**
+ * サブブロック（8ピクセル）を圧縮する。
+ * 戻り値は二乗誤差の合計。
+ */
+static int Etc1_encodeSubBlock(const int rgb[8][3], int base[3], int *result_table, int result_indices[8]) {
+    int i = 0;
+    int ch = 0;
+
+    // 平均色を4bitへ量子化したものをベースカラーにする
+    for (ch = 0; ch < 3; ++ch) {
+        int sum = 0;
+        for (i = 0; i < 8; ++i) {
+            sum += rgb[i][ch];
+        }
+        base[ch] = ((sum / 8) * 15 + 127) / 255;
+    }
+
+    int best_error = 0x7FFFFFFF;
+    int table = 0;
+    for (table = 0; table < 8; ++table) {
+        int error = 0;
+        int indices[8];
+        for (i = 0; i < 8; ++i) {
+            int best_pixel_error = 0x7FFFFFFF;
+            int index = 0;
+            for (index = 0; index < 4; ++index) {
+                const int modifier = Etc1_modifier(table, index);
+                int pixel_error = 0;
+                for (ch = 0; ch < 3; ++ch) {
+                    const int diff = Etc1_clamp(base[ch] * 17 + modifier) - rgb[i][ch];
+                    pixel_error += diff * diff;
+                }
+                if (pixel_error < best_pixel_error) {
+                    best_pixel_error = pixel_error;
+                    indices[i] = index;
+                }
+            }
+            error += best_pixel_error;
+        }
+
+        if (error < best_error) {
+            best_error = error;
+            (*result_table) = table;
+            memcpy(result_indices, indices, sizeof(indices));
+        }
+    }
+
+    return best_error;
+}
+
+/**
+ * 4x4ピクセルのブロックを圧縮し、8byteのETC1ブロックを書き込む。
+ * 差分モードは利用せず、個別モード(RGB444 x2)のみで圧縮する。
+ */
+static void Etc1_encodeBlock(const int block[4][4][3], uint8_t *dst) {
+    uint32_t best_high = 0;
+    uint32_t best_low = 0;
+    int best_error = 0x7FFFFFFF;
+
+    int flip = 0;
+    for (flip = 0; flip < 2; ++flip) {
+        int sub_rgb[2][8][3];
+        int sub_x[2][8];
+        int sub_y[2][8];
+        int counts[2] = { 0, 0 };
+
+        // サブブロックへ振り分ける
+        // flip == 0 : 左右2x4, flip == 1 : 上下4x2
+        int x = 0;
+        int y = 0;
+        for (x = 0; x < 4; ++x) {
+            for (y = 0; y < 4; ++y) {
+                const int sub = flip ? (y >= 2) : (x >= 2);
+                const int n = counts[sub]++;
+                memcpy(sub_rgb[sub][n], block[y][x], sizeof(int) * 3);
+                sub_x[sub][n] = x;
+                sub_y[sub][n] = y;
+            }
+        }
+
+        int base[2][3];
+        int table[2];
+        int indices[2][8];
+        const int error = Etc1_encodeSubBlock(sub_rgb[0], base[0], &table[0], indices[0]) + Etc1_encodeSubBlock(sub_rgb[1], base[1], &table[1], indices[1]);
+
+        if (error < best_error) {
+            best_error = error;
+            best_high = ((uint32_t) base[0][0] << 28) | ((uint32_t) base[1][0] << 24) | ((uint32_t) base[0][1] << 20) | ((uint32_t) base[1][1] << 16) | ((uint32_t) base[0][2] << 12) | ((uint32_t) base[1][2] << 8) | ((uint32_t) table[0] << 5) | ((uint32_t) table[1] << 2) | (uint32_t) flip;
+            best_low = 0;
+
+            int sub = 0;
+            int i = 0;
+            for (sub = 0; sub < 2; ++sub) {
+                for (i = 0; i < 8; ++i) {
+                    // ピクセルは列優先で並ぶ
+                    const int bit = sub_x[sub][i] * 4 + sub_y[sub][i];
+                    const uint32_t index = (uint32_t) indices[sub][i];
+                    best_low |= ((index >> 1) & 0x1) << (bit + 16);
+                    best_low |= (index & 0x1) << bit;
+                }
+            }
+        }
+    }
+
+    // Big Endianで書き込む
+    dst[0] = (uint8_t) (best_high >> 24);
+    dst[1] = (uint8_t) (best_high >> 16);
+    dst[2] = (uint8_t) (best_high >> 8);
+    dst[3] = (uint8_t) (best_high);
+    dst[4] = (uint8_t) (best_low >> 24);
+    dst[5] = (uint8_t) (best_low >> 16);
+    dst[6] = (uint8_t) (best_low >> 8);
+    dst[7] = (uint8_t) (best_low);
+}
+
+/**
+ * RGBA8888/RGB888のピクセル配列をETC1ブロックへ圧縮する。
+ */
+void Etc1_encodeImage(const void *pixels, const int pixel_format, const int width, const int height, const bool alpha_plane, void *dst_blocks) {
+    assert(pixel_format == TEXTURE_RAW_RGBA8 || pixel_format == TEXTURE_RAW_RGB8);
+    assert(!alpha_plane || pixel_format == TEXTURE_RAW_RGBA8);
+
+    const uint8_t *src = (const uint8_t*) pixels;
+    const int pixel_size = pixel_format == TEXTURE_RAW_RGBA8 ? 4 : 3;
+    uint8_t *dst = (uint8_t*) dst_blocks;
+
+    int block_x = 0;
+    int block_y = 0;
+    for (block_y = 0; block_y < height; block_y += 4) {
+        for (block_x = 0; block_x < width; block_x += 4) {
+            int block[4][4][3];
+
+            int x = 0;
+            int y = 0;
+            for (y = 0; y < 4; ++y) {
+                for (x = 0; x < 4; ++x) {
+                    // はみ出したピクセルは端の色で埋める
+                    const int px = (block_x + x) < width ? (block_x + x) : (width - 1);
+                    const int py = (block_y + y) < height ? (block_y + y) : (height - 1);
+                    const uint8_t *p = src + (py * width + px) * pixel_size;
+
+                    if (alpha_plane) {
+                        block[y][x][0] = block[y][x][1] = block[y][x][2] = p[3];
+                    } else {
+                        block[y][x][0] = p[0];
+                        block[y][x][1] = p[1];
+                        block[y][x][2] = p[2];
+                    }
+                }
+            }
+
+            Etc1_encodeBlock((const int (*)[4][3]) block, dst);
+            dst += 8;
+        }
+    }
+}
+
+/**
+ * Big Endianで16bit整数を書き込む
+ */
+static uint8_t* PkmImage_writeBE16(uint8_t *dst, const int value) {
+    dst[0] = (uint8_t) ((value >> 8) & 0xFF);
+    dst[1] = (uint8_t) (value & 0xFF);
+    return dst + 2;
+}
+
+/**
+ * 画像をETC1圧縮し、PKMファイルイメージを作成する。
+ */
+void* PkmImage_encode(const struct RawPixelImage *image, const bool with_alpha, int *result_bytes) {
+    assert(image != NULL);
+    assert(result_bytes != NULL);
+
+    // ETC1は4x4ブロック単位で格納する
+    const int ext_width = (image->width + 3) & ~0x3;
+    const int ext_height = (image->height + 3) & ~0x3;
+    const int plane_bytes = (ext_width / 4) * (ext_height / 4) * 8;
+    const int PKM_HEADER_BYTES = 16;
+
+    const int block_row_bytes = (ext_width / 4) * 8;
+    const int gutter_bytes = with_alpha ? block_row_bytes * (ETC1A_GUTTER_HEIGHT / 4) : 0;
+
+    (*result_bytes) = PKM_HEADER_BYTES + plane_bytes * (with_alpha ? 2 : 1) + gutter_bytes;
+    uint8_t *result = (uint8_t*) malloc(*result_bytes);
+    if (!result) {
+        __logf("PkmImage_encode alloc failed(%d bytes)", *result_bytes);
+        return NULL;
+    }
+
+    {
+        // ヘッダを書き込む
+        uint8_t *header = result;
+        memcpy(header, "PKM 10", 6);
+        header = PkmImage_writeBE16(header + 6, 0);
+        header = PkmImage_writeBE16(header, ext_width);
+        header = PkmImage_writeBE16(header, with_alpha ? ext_height * 2 + ETC1A_GUTTER_HEIGHT : ext_height);
+        header = PkmImage_writeBE16(header, image->width);
+        header = PkmImage_writeBE16(header, with_alpha ? ext_height + ETC1A_GUTTER_HEIGHT + image->height : image->height);
+    }
+
+    // 上部にカラー、隙間を空けて下部にアルファを格納する
+    uint8_t *color_plane = result + PKM_HEADER_BYTES;
+    Etc1_encodeImage(image->pixel_data, image->format, image->width, image->height, false, color_plane);
+    if (with_alpha) {
+        uint8_t *gutter = color_plane + plane_bytes;
+        int i = 0;
+
+        // 隙間はカラーの最終ブロック行を複製し、端の色を延長する
+        for (i = 0; i < (ETC1A_GUTTER_HEIGHT / 4); ++i) {
+            memcpy(gutter + block_row_bytes * i, color_plane + plane_bytes - block_row_bytes, block_row_bytes);
+        }
+        Etc1_encodeImage(image->pixel_data, image->format, image->width, image->height, true, gutter + gutter_bytes);
+    }
+
+    return (void*) result;
+}
@@ -16,9 +16,23 @@ KtxImage* KtxImage_load(GLApplication *app, const char* file_name) {
     if (rawData == NULL) {
         return NULL;
     }
+
+    return KtxImage_loadFromRawData(app, rawData);
+}
+
+/**
+ * 読み込み済みのファイルからKTX画像を作成する。
+ */
+KtxImage* KtxImage_loadFromRawData(GLApplication *app, RawData *rawData) {
     // ファイルの識別子を確認する
     // サンプルでは詳細なエラー処理を行わない。
     {
+        if (RawData_getAvailableBytes(rawData) < 64) {
+            __log("KTX header error");
+            RawData_freeFile(app, rawData);
+            return NULL;
+        }
+
         const uint8_t KTXFileIdentifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
 
         const uint8_t *header = (uint8_t*) RawData_getReadHeader(rawData);
@@ -26,7 +40,7 @@ KtxImage* KtxImage_load(GLApplication *app, const char* file_name) {
         int index = 0;
         for (index = 0; index < 12; ++index) {
             if (header[index] != KTXFileIdentifier[index]) {
-                __logf("header error(%s)", file_name);
+                __log("KTX header error");
                 RawData_freeFile(app, rawData);
                 return NULL;
             }
@@ -46,7 +60,7 @@ KtxImage* KtxImage_load(GLApplication *app, const char* file_name) {
         // サンプルのため、エンディアンは固定であると想定する。
         if (check_endian == 0x01020304) {
             // エンディアンが想定と違うため、読み込まない
-            __logf("endian error(%s)", file_name);
+            __log("KTX endian error");
             RawData_freeFile(app, rawData);
             return NULL;
         }
@@ -82,7 +96,10 @@ KtxImage* KtxImage_load(GLApplication *app, const char* file_name) {
     __logf("image key value data (%d bytes)", pImageHeader->bytesOfKeyValueData);
 
     {
-        result->format = pImageHeader->glBaseInternalFormat;
+        // 圧縮テクスチャはglInternalFormatに圧縮形式が格納される(glBaseInternalFormatはGL_RGB等)
+        // 非圧縮テクスチャのglInternalFormatはGL_RGBA8等のサイズ付きの値となり、GLES2のglTexImage2Dには渡せないためglFormatを利用する
+        result->format = pImageHeader->glType ? pImageHeader->glFormat : pImageHeader->glInternalFormat;
+        result->type = pImageHeader->glType;
         result->width = pImageHeader->pixelWidth;
         result->height = pImageHeader->pixelHeight;
         result->mipmaps = pImageHeader->numberOfMipmapLevels;
@@ -106,6 +123,8 @@ KtxImage* KtxImage_load(GLApplication *app, const char* file_name) {
             result->image_table[mip_level] = RawData_getReadHeader(rawData);
 
             RawData_offsetHeader(rawData, image_size);
+            // 各レベルの先頭は4byte境界に揃えられている(mipPadding)
+            RawData_offsetHeader(rawData, 3 - ((image_size + 3) % 4));
         }
     }
 
@@ -135,12 +154,25 @@ Texture* KtxImage_loadTexture(GLApplication *app, const char* file_name) {
         return NULL;
     }
 
+    Texture *texture = KtxImage_createTexture(app, ktx);
+
+    // 元画像を解放
+    KtxImage_free(app, ktx);
+    return texture;
+}
+
+/**
+ * 読み込み済みのKTX画像からテクスチャを作成する。
+ */
+Texture* KtxImage_createTexture(GLApplication *app, KtxImage *ktx) {
     Texture *texture = (Texture*) malloc(sizeof(Texture));
 
     {
         // 元画像から必要情報をコピーする
         texture->width = ktx->width;
         texture->height = ktx->height;
+        texture->upload_completed = true;
+        texture->vram_bytes = 0;
     }
 
     {
@@ -152,6 +184,11 @@ Texture* KtxImage_loadTexture(GLApplication *app, const char* file_name) {
 
     glBindTexture(GL_TEXTURE_2D, texture->id);
 
+    // KTXの各ラインは4byte境界に揃えられているため、呼び出し元の設定によらず4で転送する
+    GLint unpack_alignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
     {
         // VRAMへピクセル情報をコピーする
         int width = ktx->width;
@@ -159,14 +196,22 @@ Texture* KtxImage_loadTexture(GLApplication *app, const char* file_name) {
         int miplevel = 0;
 
         for (miplevel = 0; miplevel < ktx->mipmaps; ++miplevel) {
-            glCompressedTexImage2D(GL_TEXTURE_2D, miplevel, ktx->format, width, height, 0, ktx->image_length_table[miplevel], ktx->image_table[miplevel]);
+            if (ktx->type) {
+                // 非圧縮テクスチャ
+                glTexImage2D(GL_TEXTURE_2D, miplevel, ktx->format, width, height, 0, ktx->format, ktx->type, ktx->image_table[miplevel]);
+            } else {
+                glCompressedTexImage2D(GL_TEXTURE_2D, miplevel, ktx->format, width, height, 0, ktx->image_length_table[miplevel], ktx->image_table[miplevel]);
+            }
+            texture->vram_bytes += ktx->image_length_table[miplevel];
 
-            width /= 2;
-            height /= 2;
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
             assert(glGetError() == GL_NO_ERROR);
         }
     }
 
+    glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+
     {
         // wrapの初期設定
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -192,7 +237,5 @@ Texture* KtxImage_loadTexture(GLApplication *app, const char* file_name) {
     glBindTexture(GL_TEXTURE_2D, 0);
     assert(glGetError() == GL_NO_ERROR);
 
-    // 元画像を解放
-    KtxImage_free(app, ktx);
     return texture;
 }
@@ -17,32 +17,34 @@ PkmImage* PkmImage_load(GLApplication *app, const char* file_name) {
         return NULL;
     }
 
-    PkmImage *image = (PkmImage*) malloc(sizeof(PkmImage));
+    return PkmImage_loadFromRawData(app, raw);
+}
 
-    image->raw = raw;
-    image->image_bytes = RawData_getLength(raw);
+/**
+ * 読み込み済みのファイルからPKM圧縮画像を作成する。
+ */
+PkmImage* PkmImage_loadFromRawData(GLApplication *app, RawData *raw) {
+    if (RawData_getAvailableBytes(raw) < 16) {
+        __log("PKM header error");
+        RawData_freeFile(app, raw);
+        return NULL;
+    }
 
     {
-        // ヘッダが"PKM"であることをチェックする
-        char magic[4] = { 0 };
-        magic[0] = RawData_read8(raw);
-        magic[1] = RawData_read8(raw);
-        magic[2] = RawData_read8(raw);
-        magic[3] = RawData_read8(raw);
-
-        assert(magic[0] == 'P');
-        assert(magic[1] == 'K');
-        assert(magic[2] == 'M');
+        // ヘッダが"PKM"、バージョンが"10"であることをチェックする
+        char magic[6] = { 0 };
+        RawData_readBytes(raw, magic, 6);
+
+        if (magic[0] != 'P' || magic[1] != 'K' || magic[2] != 'M' || magic[4] != '1' || magic[5] != '0') {
+            __log("PKM header error");
+            RawData_freeFile(app, raw);
+            return NULL;
+        }
     }
-    {
-        // バージョンが"10"であることをチェックする
-        char version[2] = { 0 };
-        version[0] = RawData_read8(raw);
-        version[1] = RawData_read8(raw);
 
-        assert(version[0] == '1');
-        assert(version[1] == '0');
-    }
+    PkmImage *image = (PkmImage*) malloc(sizeof(PkmImage));
+    image->raw = raw;
+
     // データ種別をチェックする
     image->data_type = RawData_readBE16(raw);
     // 圧縮後の幅と高さを読み込む
@@ -76,14 +78,9 @@ void PkmImage_free(GLApplication *app, PkmImage *pkm) {
 /**
  * 画像をテクスチャとして読み込む。
  * 読み込んだ画像はes20_freeTexture()で解放する
+ * pixel_formatがTEXTURE_COMPRESS_ETC1Aの場合、上下に並んだカラー/アルファの片方の大きさをテクスチャサイズとする。
  */
-Texture* PkmImage_loadTexture(GLApplication *app, const char* file_name) {
-    // TODO 解説
-    // GL_OES_compressed_ETC1_RGB8_textureがサポートされていないプラットフォームではifdefで切る
-#ifndef GL_OES_compressed_ETC1_RGB8_texture
-    __log("サポート外のテクスチャ形式(GL_OES_compressed_ETC1_RGB8_texture)");
-    return NULL;
-#else
+Texture* PkmImage_loadTexture(GLApplication *app, const char* file_name, const int pixel_format) {
     PkmImage *pkm = PkmImage_load(app, file_name);
 
     // error images
@@ -91,12 +88,37 @@ Texture* PkmImage_loadTexture(GLApplication *app, const char* file_name) {
         return NULL;
     }
 
+    Texture *texture = PkmImage_createTexture(app, pkm, pixel_format);
+
+    // 元画像を解放
+    PkmImage_free(app, pkm);
+    return texture;
+}
+
+/**
+ * 読み込み済みのPKM圧縮画像からテクスチャを作成する。
+ */
+Texture* PkmImage_createTexture(GLApplication *app, PkmImage *pkm, const int pixel_format) {
+    // TODO 解説
+    // GL_OES_compressed_ETC1_RGB8_textureがサポートされていないプラットフォームではifdefで切る
+#ifndef GL_OES_compressed_ETC1_RGB8_texture
+    __log("サポート外のテクスチャ形式(GL_OES_compressed_ETC1_RGB8_texture)");
+    return NULL;
+#else
     Texture *texture = (Texture*) malloc(sizeof(Texture));
 
     {
         // 元画像から必要情報をコピーする
         texture->width = pkm->width;
         texture->height = pkm->height;
+        texture->upload_completed = true;
+        texture->vram_bytes = pkm->image_bytes;
+
+        if (pixel_format == TEXTURE_COMPRESS_ETC1A) {
+            // 隙間より下はアルファ用の領域
+            assert(((pkm->height - ETC1A_GUTTER_HEIGHT) % 8) == 0);
+            texture->height = ETC1A_getPlaneHeight(pkm->height);
+        }
     }
 
     {
@@ -133,8 +155,6 @@ Texture* PkmImage_loadTexture(GLApplication *app, const char* file_name) {
     glBindTexture(GL_TEXTURE_2D, 0);
     assert(glGetError() == GL_NO_ERROR);
 
-// 元画像を解放
-    PkmImage_free(app, pkm);
     return texture;
 #endif
 }
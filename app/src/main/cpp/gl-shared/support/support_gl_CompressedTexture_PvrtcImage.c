@@ -21,18 +21,37 @@ typedef struct PVRTexHeader {
 
 #define PVR_TEXTURE_FLAG_TYPE_MASK  0xff
 
+/**
+ * PVR v3テクスチャヘッダ。
+ * 参考：PowerVR Texture Tool PVR File Format Specification
+ */
+typedef struct PVRTexHeaderV3 {
+    uint32_t version;
+    uint32_t flags;
+    uint32_t pixelFormat;
+    uint32_t pixelFormatHigh;
+    uint32_t colourSpace;
+    uint32_t channelType;
+    uint32_t height;
+    uint32_t width;
+    uint32_t depth;
+    uint32_t numSurfaces;
+    uint32_t numFaces;
+    uint32_t mipMapCount;
+    uint32_t metaDataSize;
+} PVRTexHeaderV3;
+
+/**
+ * PVR v3ヘッダの識別子 'P' 'V' 'R' 3
+ */
+#define PVR_V3_VERSION    0x03525650
+
 /**
  * PVRTC圧縮画像を読み込む
  * 読み込んだ画像はPvrtcImage_free()で解放する
  * 参考：https://developer.apple.com/library/ios/samplecode/GLTextureAtlas/Listings/Classes_PVRTexture_m.html
  */
 PvrtcImage* PvrtcImage_load(GLApplication *app, const char *file_name) {
-
-    enum {
-        kPVRTextureFlagTypePVRTC_2 = 24,
-        kPVRTextureFlagTypePVRTC_4
-    };
-
     RawData *raw = RawData_loadFile(app, file_name);
 
     if (!raw) {
@@ -40,24 +59,87 @@ PvrtcImage* PvrtcImage_load(GLApplication *app, const char *file_name) {
         return NULL;
     }
 
-    PVRTexHeader *header = (PVRTexHeader*) RawData_getReadHeader(raw);
+    PvrtcImage *result = PvrtcImage_loadFromRawData(app, raw);
+    if (!result) {
+        __logf("texture format error(%s)", file_name);
+    }
+    return result;
+}
+
+/**
+ * 読み込み済みのファイルからPVRTC圧縮画像を作成する。
+ * PVR v2(legacy)とPVR v3のヘッダに対応する。
+ */
+PvrtcImage* PvrtcImage_loadFromRawData(GLApplication *app, RawData *raw) {
 
-    // check tag
-    if (header->pvrTag[0] != 'P' || header->pvrTag[1] != 'V' || header->pvrTag[2] != 'R' || header->pvrTag[3] != '!') {
+    enum {
+        kPVRTextureFlagTypePVRTC_2 = 24,
+        kPVRTextureFlagTypePVRTC_4
+    };
+
+    enum {
+        kPVR3PixelFormatPVRTC_2BPP_RGB = 0,
+        kPVR3PixelFormatPVRTC_2BPP_RGBA,
+        kPVR3PixelFormatPVRTC_4BPP_RGB,
+        kPVR3PixelFormatPVRTC_4BPP_RGBA
+    };
+
+    if (RawData_getAvailableBytes(raw) < (int) sizeof(PVRTexHeader)) {
         RawData_freeFile(app, raw);
-        __logf("texture format error(%s)", file_name);
         return NULL;
     }
 
-    __logf("pvrtc mipmaps(%d) surfs(%d)", header->numMipmaps, header->numSurfs);
-
     PvrtcImage *result = (PvrtcImage*) malloc(sizeof(PvrtcImage));
+    int header_length = 0;
+    int mipmaps = 0;
+
+    if (((PVRTexHeaderV3*) RawData_getReadHeader(raw))->version == PVR_V3_VERSION) {
+        PVRTexHeaderV3 *header = (PVRTexHeaderV3*) RawData_getReadHeader(raw);
+
+        __logf("pvr v3 mipmaps(%d) surfs(%d) faces(%d)", header->mipMapCount, header->numSurfaces, header->numFaces);
+
+        result->width = header->width;
+        result->height = header->height;
+        // v3のmipmap数は等倍テクスチャを含む
+        mipmaps = header->mipMapCount;
+        header_length = sizeof(PVRTexHeaderV3) + header->metaDataSize;
+
+        switch (header->pixelFormatHigh ? -1 : (int) header->pixelFormat) {
+            case kPVR3PixelFormatPVRTC_2BPP_RGB:
+            case kPVR3PixelFormatPVRTC_2BPP_RGBA:
+                result->format = GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG;
+                result->bits_per_pixel = 2;
+                break;
+            case kPVR3PixelFormatPVRTC_4BPP_RGB:
+            case kPVR3PixelFormatPVRTC_4BPP_RGBA:
+                result->format = GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG;
+                result->bits_per_pixel = 4;
+                break;
+            default:
+                // PVRTC以外のフォーマットは非対応
+                free(result);
+                RawData_freeFile(app, raw);
+                return NULL;
+        }
+    } else {
+        PVRTexHeader *header = (PVRTexHeader*) RawData_getReadHeader(raw);
+
+        // check tag
+        if (header->pvrTag[0] != 'P' || header->pvrTag[1] != 'V' || header->pvrTag[2] != 'R' || header->pvrTag[3] != '!') {
+            free(result);
+            RawData_freeFile(app, raw);
+            return NULL;
+        }
+
+        __logf("pvrtc mipmaps(%d) surfs(%d)", header->numMipmaps, header->numSurfs);
+
+        result->width = header->width;
+        result->height = header->height;
+        // 等倍テクスチャ+mipmap数を保持するため、例えば等倍テクスチャであればnumMpmapは0になる。
+        // +1を行うことでfor文で回すことができる。
+        mipmaps = header->numMipmaps + 1;
+        header_length = header->headerLength;
 
-    // データコピー
-    result->raw = raw;
-    result->width = header->width;
-    result->height = header->height;
-    {
         // 詳細フォーマットのチェック
         switch (header->flags & PVR_TEXTURE_FLAG_TYPE_MASK) {
             case kPVRTextureFlagTypePVRTC_2:
@@ -75,28 +157,28 @@ PvrtcImage* PvrtcImage_load(GLApplication *app, const char *file_name) {
         }
     }
 
+    // データコピー
+    result->raw = raw;
+
     // 各圧縮画像へのポインタを計算する
     // 画像は固定ビットレートで格納されるため、ポインタ位置を計算可能。
     {
-        // mipmap対応チェック
-        // 等倍テクスチャ+mipmap数を保持するため、例えば等倍テクスチャであればnumMpmapは0になる。
-        // +1を行うことでfor文で回すことができる。
-        result->mipmaps = header->numMipmaps + 1;
+        result->mipmaps = mipmaps;
         result->image_table = (void**) malloc(sizeof(void*) * result->mipmaps);
-        result->image_length_table = (int*) malloc(sizeof(void*) * result->mipmaps);
+        result->image_length_table = (int*) malloc(sizeof(int) * result->mipmaps);
 
         int miplevel = 0;
         int texWidth = result->width;
         int texHeight = result->height;
-        RawData_setHeaderPosition(raw, header->headerLength);
+        RawData_setHeaderPosition(raw, header_length);
         uint8_t *image_header = RawData_getReadHeader(raw);
         for (miplevel = 0; miplevel < result->mipmaps; ++miplevel) {
 
             // 1ブロックのサイズは圧縮時オプションで変動する
-            const int blockSize = header->flags == kPVRTextureFlagTypePVRTC_4 ? (4 * 4) : (8 * 4);
-            int widthBlocks = texWidth / (header->flags == kPVRTextureFlagTypePVRTC_4 ? 4 : 8);
+            const int bpp = result->bits_per_pixel;
+            const int blockSize = bpp == 4 ? (4 * 4) : (8 * 4);
+            int widthBlocks = texWidth / (bpp == 4 ? 4 : 8);
             int heightBlocks = texHeight / 4;
-            const int bpp = header->flags == kPVRTextureFlagTypePVRTC_4 ? 4 : 2;
 
             // 最低限のブロック数は持たなければならない
             if (widthBlocks < 2) {
@@ -157,12 +239,25 @@ Texture* PvrtcImage_loadTexture(GLApplication *app, const char* file_name) {
         return NULL;
     }
 
+    Texture *texture = PvrtcImage_createTexture(app, pvrtc);
+
+    // 元画像を解放
+    PvrtcImage_free(app, pvrtc);
+    return texture;
+}
+
+/**
+ * 読み込み済みのPVRTC圧縮画像からテクスチャを作成する。
+ */
+Texture* PvrtcImage_createTexture(GLApplication *app, PvrtcImage *pvrtc) {
     Texture *texture = (Texture*) malloc(sizeof(Texture));
 
     {
         // 元画像から必要情報をコピーする
         texture->width = pvrtc->width;
         texture->height = pvrtc->height;
+        texture->upload_completed = true;
+        texture->vram_bytes = 0;
     }
 
     {
@@ -182,6 +277,7 @@ Texture* PvrtcImage_loadTexture(GLApplication *app, const char* file_name) {
 
         for (miplevel = 0; miplevel < pvrtc->mipmaps; ++miplevel) {
             glCompressedTexImage2D(GL_TEXTURE_2D, miplevel, pvrtc->format, width, height, 0, pvrtc->image_length_table[miplevel], pvrtc->image_table[miplevel]);
+            texture->vram_bytes += pvrtc->image_length_table[miplevel];
 
             width /= 2;
             height /= 2;
@@ -214,7 +310,5 @@ Texture* PvrtcImage_loadTexture(GLApplication *app, const char* file_name) {
     glBindTexture(GL_TEXTURE_2D, 0);
     assert(glGetError() == GL_NO_ERROR);
 
-    // 元画像を解放
-    PvrtcImage_free(app, pvrtc);
     return texture;
 }
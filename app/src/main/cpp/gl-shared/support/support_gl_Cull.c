@@ -0,0 +1,246 @@
+/*
+ * support_gl_Cull.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+#include    "support_gl_Vector_Simd.h"
+
+#if defined(VECTOR_SIMD_NEON) || defined(VECTOR_SIMD_SSE)
+/**
+ * 4要素分の判定結果(bit0-3)から、見えている要素のインデックスを詰めて書き込む。
+ * 分岐を避けるため常に書き込み、見えている場合だけ書き込み位置を進める。
+ * 書き込み位置はbase + 3を超えないため、num個の領域からはみ出さない。
+ */
+static int Cull_compact(const int mask, const int base, int *visible_indices) {
+    int n = 0;
+
+    visible_indices[n] = base;
+    n += (mask & 0x01);
+    visible_indices[n] = base + 1;
+    n += (mask >> 1) & 0x01;
+    visible_indices[n] = base + 2;
+    n += (mask >> 2) & 0x01;
+    visible_indices[n] = base + 3;
+    n += (mask >> 3) & 0x01;
+
+    return n;
+}
+#endif
+
+#if defined(VECTOR_SIMD_NEON)
+/**
+ * 比較結果をbit0-3のマスクへ変換する
+ */
+static int Cull_toMask(const uint32x4_t visible) {
+    static const uint32_t bits[4] = { 1, 2, 4, 8 };
+    const uint32x4_t masked = vandq_u32(visible, vld1q_u32(bits));
+    uint32x2_t sum = vpadd_u32(vget_low_u32(masked), vget_high_u32(masked));
+    sum = vpadd_u32(sum, sum);
+    return (int) vget_lane_u32(sum, 0);
+}
+#endif
+
+/**
+ * 視錐台をビュー×射影行列から作成する。
+ * クリップ座標で-w <= x,y,z <= wとなる条件を、行列の行の和・差として取り出す。
+ */
+void CullFrustum_fromMatrix(CullFrustum *result, const mat4 *view_projection) {
+    const mat4 *m = view_projection;
+    int i = 0;
+
+    for (i = 0; i < 4; ++i) {
+        // 列iの各行
+        const GLfloat row0 = m->m[i][0];
+        const GLfloat row1 = m->m[i][1];
+        const GLfloat row2 = m->m[i][2];
+        const GLfloat row3 = m->m[i][3];
+
+        // left / right
+        result->planes[0][i] = row3 + row0;
+        result->planes[1][i] = row3 - row0;
+        // bottom / top
+        result->planes[2][i] = row3 + row1;
+        result->planes[3][i] = row3 - row1;
+        // near / far
+        result->planes[4][i] = row3 + row2;
+        result->planes[5][i] = row3 - row2;
+    }
+
+    // 判定を距離で行えるよう正規化する
+    for (i = 0; i < 6; ++i) {
+        GLfloat *plane = result->planes[i];
+        const GLfloat len = sqrtf(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (len > 0.0f) {
+            plane[0] /= len;
+            plane[1] /= len;
+            plane[2] /= len;
+            plane[3] /= len;
+        }
+    }
+}
+
+/**
+ * 矩形配列のうち、指定領域と重なるもののインデックスを詰めて書き込む。
+ */
+int Cull_rects(const CullRectArray *rects, const int num, const GLfloat left, const GLfloat top, const GLfloat right, const GLfloat bottom, int *visible_indices) {
+    int result = 0;
+    int i = 0;
+
+    assert(rects);
+    assert(visible_indices);
+
+#if defined(VECTOR_SIMD_NEON)
+    const float32x4_t view_left = vdupq_n_f32(left);
+    const float32x4_t view_top = vdupq_n_f32(top);
+    const float32x4_t view_right = vdupq_n_f32(right);
+    const float32x4_t view_bottom = vdupq_n_f32(bottom);
+
+    for (; (i + 4) <= num; i += 4) {
+        uint32x4_t visible = vcgeq_f32(vld1q_f32(rects->max_x + i), view_left);
+        visible = vandq_u32(visible, vcleq_f32(vld1q_f32(rects->min_x + i), view_right));
+        visible = vandq_u32(visible, vcgeq_f32(vld1q_f32(rects->max_y + i), view_top));
+        visible = vandq_u32(visible, vcleq_f32(vld1q_f32(rects->min_y + i), view_bottom));
+
+        result += Cull_compact(Cull_toMask(visible), i, visible_indices + result);
+    }
+#elif defined(VECTOR_SIMD_SSE)
+    const __m128 view_left = _mm_set1_ps(left);
+    const __m128 view_top = _mm_set1_ps(top);
+    const __m128 view_right = _mm_set1_ps(right);
+    const __m128 view_bottom = _mm_set1_ps(bottom);
+
+    for (; (i + 4) <= num; i += 4) {
+        __m128 visible = _mm_cmpge_ps(_mm_loadu_ps(rects->max_x + i), view_left);
+        visible = _mm_and_ps(visible, _mm_cmple_ps(_mm_loadu_ps(rects->min_x + i), view_right));
+        visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_loadu_ps(rects->max_y + i), view_top));
+        visible = _mm_and_ps(visible, _mm_cmple_ps(_mm_loadu_ps(rects->min_y + i), view_bottom));
+
+        result += Cull_compact(_mm_movemask_ps(visible), i, visible_indices + result);
+    }
+#endif
+
+    // 端数を処理する
+    for (; i < num; ++i) {
+        const bool visible = rects->max_x[i] >= left && rects->min_x[i] <= right && rects->max_y[i] >= top && rects->min_y[i] <= bottom;
+        visible_indices[result] = i;
+        result += visible ? 1 : 0;
+    }
+
+    return result;
+}
+
+/**
+ * AABB配列のうち、視錐台と重なるもののインデックスを詰めて書き込む。
+ * ボックスの中心と半径（各軸の半分の長さ）を求め、
+ * 平面の法線方向へ最も突き出した点が平面の外側にあれば見えないと判定する。
+ */
+int Cull_boxes(const CullBoxArray *boxes, const int num, const CullFrustum *frustum, int *visible_indices) {
+    int result = 0;
+    int i = 0;
+    int p = 0;
+
+    assert(boxes);
+    assert(frustum);
+    assert(visible_indices);
+
+#if defined(VECTOR_SIMD_NEON)
+    for (; (i + 4) <= num; i += 4) {
+        const float32x4_t min_x = vld1q_f32(boxes->min_x + i);
+        const float32x4_t min_y = vld1q_f32(boxes->min_y + i);
+        const float32x4_t min_z = vld1q_f32(boxes->min_z + i);
+        const float32x4_t max_x = vld1q_f32(boxes->max_x + i);
+        const float32x4_t max_y = vld1q_f32(boxes->max_y + i);
+        const float32x4_t max_z = vld1q_f32(boxes->max_z + i);
+
+        const float32x4_t center_x = vmulq_n_f32(vaddq_f32(min_x, max_x), 0.5f);
+        const float32x4_t center_y = vmulq_n_f32(vaddq_f32(min_y, max_y), 0.5f);
+        const float32x4_t center_z = vmulq_n_f32(vaddq_f32(min_z, max_z), 0.5f);
+        const float32x4_t extent_x = vmulq_n_f32(vsubq_f32(max_x, min_x), 0.5f);
+        const float32x4_t extent_y = vmulq_n_f32(vsubq_f32(max_y, min_y), 0.5f);
+        const float32x4_t extent_z = vmulq_n_f32(vsubq_f32(max_z, min_z), 0.5f);
+
+        uint32x4_t visible = vdupq_n_u32(0xFFFFFFFF);
+        for (p = 0; p < 6; ++p) {
+            const GLfloat *plane = frustum->planes[p];
+
+            float32x4_t distance = vdupq_n_f32(plane[3]);
+            distance = vmlaq_n_f32(distance, center_x, plane[0]);
+            distance = vmlaq_n_f32(distance, center_y, plane[1]);
+            distance = vmlaq_n_f32(distance, center_z, plane[2]);
+
+            float32x4_t radius = vmulq_n_f32(extent_x, fabsf(plane[0]));
+            radius = vmlaq_n_f32(radius, extent_y, fabsf(plane[1]));
+            radius = vmlaq_n_f32(radius, extent_z, fabsf(plane[2]));
+
+            visible = vandq_u32(visible, vcgeq_f32(vaddq_f32(distance, radius), vdupq_n_f32(0.0f)));
+        }
+
+        result += Cull_compact(Cull_toMask(visible), i, visible_indices + result);
+    }
+#elif defined(VECTOR_SIMD_SSE)
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; (i + 4) <= num; i += 4) {
+        const __m128 min_x = _mm_loadu_ps(boxes->min_x + i);
+        const __m128 min_y = _mm_loadu_ps(boxes->min_y + i);
+        const __m128 min_z = _mm_loadu_ps(boxes->min_z + i);
+        const __m128 max_x = _mm_loadu_ps(boxes->max_x + i);
+        const __m128 max_y = _mm_loadu_ps(boxes->max_y + i);
+        const __m128 max_z = _mm_loadu_ps(boxes->max_z + i);
+
+        const __m128 center_x = _mm_mul_ps(_mm_add_ps(min_x, max_x), half);
+        const __m128 center_y = _mm_mul_ps(_mm_add_ps(min_y, max_y), half);
+        const __m128 center_z = _mm_mul_ps(_mm_add_ps(min_z, max_z), half);
+        const __m128 extent_x = _mm_mul_ps(_mm_sub_ps(max_x, min_x), half);
+        const __m128 extent_y = _mm_mul_ps(_mm_sub_ps(max_y, min_y), half);
+        const __m128 extent_z = _mm_mul_ps(_mm_sub_ps(max_z, min_z), half);
+
+        __m128 visible = _mm_cmpeq_ps(zero, zero);
+        for (p = 0; p < 6; ++p) {
+            const GLfloat *plane = frustum->planes[p];
+
+            __m128 distance = _mm_set1_ps(plane[3]);
+            distance = _mm_add_ps(distance, _mm_mul_ps(center_x, _mm_set1_ps(plane[0])));
+            distance = _mm_add_ps(distance, _mm_mul_ps(center_y, _mm_set1_ps(plane[1])));
+            distance = _mm_add_ps(distance, _mm_mul_ps(center_z, _mm_set1_ps(plane[2])));
+
+            __m128 radius = _mm_mul_ps(extent_x, _mm_set1_ps(fabsf(plane[0])));
+            radius = _mm_add_ps(radius, _mm_mul_ps(extent_y, _mm_set1_ps(fabsf(plane[1]))));
+            radius = _mm_add_ps(radius, _mm_mul_ps(extent_z, _mm_set1_ps(fabsf(plane[2]))));
+
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        result += Cull_compact(_mm_movemask_ps(visible), i, visible_indices + result);
+    }
+#endif
+
+    // 端数を処理する
+    for (; i < num; ++i) {
+        const GLfloat center_x = (boxes->min_x[i] + boxes->max_x[i]) * 0.5f;
+        const GLfloat center_y = (boxes->min_y[i] + boxes->max_y[i]) * 0.5f;
+        const GLfloat center_z = (boxes->min_z[i] + boxes->max_z[i]) * 0.5f;
+        const GLfloat extent_x = (boxes->max_x[i] - boxes->min_x[i]) * 0.5f;
+        const GLfloat extent_y = (boxes->max_y[i] - boxes->min_y[i]) * 0.5f;
+        const GLfloat extent_z = (boxes->max_z[i] - boxes->min_z[i]) * 0.5f;
+
+        bool visible = true;
+        for (p = 0; p < 6; ++p) {
+            const GLfloat *plane = frustum->planes[p];
+            const GLfloat distance = plane[0] * center_x + plane[1] * center_y + plane[2] * center_z + plane[3];
+            const GLfloat radius = extent_x * fabsf(plane[0]) + extent_y * fabsf(plane[1]) + extent_z * fabsf(plane[2]);
+            if (distance + radius < 0.0f) {
+                visible = false;
+                break;
+            }
+        }
+
+        visible_indices[result] = i;
+        result += visible ? 1 : 0;
+    }
+
+    return result;
+}
@@ -0,0 +1,81 @@
+/*
+ * support_gl_Cull.h
+ *
+ *  Created on: 2026/10/19
+ */
+
+#ifndef SUPPORT_GL_CULL_H_
+#define SUPPORT_GL_CULL_H_
+
+#include    "support.h"
+
+/**
+ * 2次元の矩形配列(SoA)
+ * 回転したスプライトは、回転後の頂点を囲む矩形を格納する。
+ */
+typedef struct CullRectArray {
+    /**
+     * 左端
+     */
+    const GLfloat *min_x;
+
+    /**
+     * 上端（ピクセル座標の場合）
+     */
+    const GLfloat *min_y;
+
+    /**
+     * 右端
+     */
+    const GLfloat *max_x;
+
+    /**
+     * 下端（ピクセル座標の場合）
+     */
+    const GLfloat *max_y;
+} CullRectArray;
+
+/**
+ * 3次元の軸平行境界ボックス(AABB)配列(SoA)
+ */
+typedef struct CullBoxArray {
+    const GLfloat *min_x;
+    const GLfloat *min_y;
+    const GLfloat *min_z;
+
+    const GLfloat *max_x;
+    const GLfloat *max_y;
+    const GLfloat *max_z;
+} CullBoxArray;
+
+/**
+ * 視錐台を構成する6平面
+ * 各平面は(a, b, c, d)で、a*x + b*y + c*z + d >= 0が内側となる。
+ */
+typedef struct CullFrustum {
+    GLfloat planes[6][4];
+} CullFrustum;
+
+/**
+ * 視錐台をビュー×射影行列から作成する。
+ * Camera_getViewProjection()の戻り値を渡せば、カメラの視錐台が得られる。
+ */
+extern void CullFrustum_fromMatrix(CullFrustum *result, const mat4 *view_projection);
+
+/**
+ * 矩形配列のうち、(left, top)-(right, bottom)の領域と重なるもののインデックスをvisible_indicesへ詰めて書き込む。
+ * 戻り値は書き込んだインデックス数となる。
+ * visible_indicesにはnum個の領域が必要になる。
+ * NEON/SSEが利用できる場合は4要素ずつ判定する。
+ */
+extern int Cull_rects(const CullRectArray *rects, const int num, const GLfloat left, const GLfloat top, const GLfloat right, const GLfloat bottom, int *visible_indices);
+
+/**
+ * AABB配列のうち、視錐台と重なる（可能性がある）もののインデックスをvisible_indicesへ詰めて書き込む。
+ * 戻り値は書き込んだインデックス数となる。
+ * 視錐台の角付近では、実際には見えないボックスが残る場合がある。
+ * visible_indicesにはnum個の領域が必要になる。
+ */
+extern int Cull_boxes(const CullBoxArray *boxes, const int num, const CullFrustum *frustum, int *visible_indices);
+
+#endif /* SUPPORT_GL_CULL_H_ */
@@ -12,5 +12,32 @@
  */
 extern GLuint Shader_createProgramFromSource(const char* vertex_shader_source, const char* fragment_shader_source);
 
+/**
+ * マクロを展開してからシェーダーソースの文字列にする
+ */
+#define SHADER_SOURCE_STRINGIFY(value)      #value
+#define SHADER_SOURCE_EXPAND(value)         SHADER_SOURCE_STRINGIFY(value)
+
+/**
+ * ETC1A形式(TEXTURE_COMPRESS_ETC1A)のテクスチャをサンプリングする関数。
+ * 上部のカラーと下部のアルファを合成して返す。
+ * etc1a_heightにはTexture::height（カラー1面分の高さ）を指定する。
+ * GL_LINEARで隣の面が混ざらないよう、v座標を各面の内側へ半テクセル分制限する。
+ * カラーとアルファの隙間はエンコーダーと同じETC1A_GUTTER_HEIGHTから埋め込む。
+ * フラグメントシェーダーのmain()より前に連結して利用する。
+ *
+ * 例："uniform sampler2D texture; uniform mediump float height;" SHADER_SOURCE_ETC1A_SAMPLER "void main() { gl_FragColor = texture2D_etc1a(texture, vary_uv, height); }"
+ */
+#define SHADER_SOURCE_ETC1A_SAMPLER \
+        "lowp vec4 texture2D_etc1a(sampler2D etc1a_texture, mediump vec2 etc1a_uv, mediump float etc1a_height) {" \
+        "   const mediump float etc1a_gutter = float(" SHADER_SOURCE_EXPAND(ETC1A_GUTTER_HEIGHT) ");" \
+        "   mediump float image_height = etc1a_height * 2.0 + etc1a_gutter;" \
+        "   mediump float v = clamp(etc1a_uv.y * etc1a_height, 0.5, etc1a_height - 0.5) / image_height;" \
+        "   mediump vec2 uv_color = vec2(etc1a_uv.x, v);" \
+        "   lowp vec4 color = texture2D(etc1a_texture, uv_color);" \
+        "   color.a = texture2D(etc1a_texture, uv_color + vec2(0.0, (etc1a_height + etc1a_gutter) / image_height)).g;" \
+        "   return color;" \
+        "}"
+
 
 #endif /* SUPPORT_GL_SHADER_H_ */
@@ -0,0 +1,393 @@
+/*
+ * support_gl_SpatialGrid.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+
+/**
+ * 空のリンクを示す
+ */
+#define SPATIALGRID_NONE    -1
+
+/**
+ * セル座標の上限(絶対値)
+ * 巨大な座標やinf/NaNをintへ変換しないよう、この範囲へ丸める。
+ */
+#define SPATIALGRID_CELL_LIMIT  (1 << 20)
+
+/**
+ * 空間ハッシュを生成する。
+ * バケット数はエンティティ数の2倍以上の2のべき乗とする。
+ */
+SpatialGrid* SpatialGrid_create(const int entity_capacity, const GLfloat cell_size) {
+    int i = 0;
+
+    assert(entity_capacity > 0);
+    assert(cell_size > 0.0f);
+
+    SpatialGrid *result = (SpatialGrid*) calloc(1, sizeof(SpatialGrid));
+    if (!result) {
+        __log("SpatialGrid_create alloc failed");
+        return NULL;
+    }
+
+    result->cell_size = cell_size;
+    result->inv_cell_size = 1.0f / cell_size;
+    result->entity_capacity = entity_capacity;
+
+    result->bucket_num = 64;
+    while (result->bucket_num < entity_capacity * 2) {
+        result->bucket_num *= 2;
+    }
+    result->buckets = (int*) malloc(sizeof(int) * result->bucket_num);
+    result->node_free = SPATIALGRID_NONE;
+
+    result->min_x = (GLfloat*) malloc(sizeof(GLfloat) * entity_capacity);
+    result->min_y = (GLfloat*) malloc(sizeof(GLfloat) * entity_capacity);
+    result->max_x = (GLfloat*) malloc(sizeof(GLfloat) * entity_capacity);
+    result->max_y = (GLfloat*) malloc(sizeof(GLfloat) * entity_capacity);
+
+    result->cell_left = (int*) malloc(sizeof(int) * entity_capacity);
+    result->cell_top = (int*) malloc(sizeof(int) * entity_capacity);
+    result->cell_right = (int*) malloc(sizeof(int) * entity_capacity);
+    result->cell_bottom = (int*) malloc(sizeof(int) * entity_capacity);
+
+    result->inserted = (uint8_t*) calloc(entity_capacity, sizeof(uint8_t));
+    result->query_stamp = (uint32_t*) calloc(entity_capacity, sizeof(uint32_t));
+
+    if (!result->buckets || !result->min_x || !result->min_y || !result->max_x || !result->max_y || !result->cell_left || !result->cell_top || !result->cell_right || !result->cell_bottom || !result->inserted || !result->query_stamp) {
+        // 確保できた配列はSpatialGrid_free()で解放する
+        __logf("SpatialGrid_create alloc failed(%d entities)", entity_capacity);
+        SpatialGrid_free(result);
+        return NULL;
+    }
+
+    for (i = 0; i < result->bucket_num; ++i) {
+        result->buckets[i] = SPATIALGRID_NONE;
+    }
+
+    return result;
+}
+
+/**
+ * 座標からセル座標を求める
+ * 範囲外の座標はSPATIALGRID_CELL_LIMITへ丸め、NaNは下限として扱う。
+ */
+static int SpatialGrid_toCell(const SpatialGrid *grid, const GLfloat position) {
+    const GLfloat cell = position * grid->inv_cell_size;
+    if (!(cell >= (GLfloat) -SPATIALGRID_CELL_LIMIT)) {
+        return -SPATIALGRID_CELL_LIMIT;
+    }
+    if (cell > (GLfloat) SPATIALGRID_CELL_LIMIT) {
+        return SPATIALGRID_CELL_LIMIT;
+    }
+    return (int) floorf(cell);
+}
+
+/**
+ * セル範囲がバケット数を超える場合true
+ * セルを1つずつ辿るより全バケットを1度ずつ辿る方が少なく済むため、全バケットを対象とする。
+ */
+static bool SpatialGrid_coversAllBuckets(const SpatialGrid *grid, const int left, const int top, const int right, const int bottom) {
+    const int64_t cells = ((int64_t) right - left + 1) * ((int64_t) bottom - top + 1);
+    return cells > (int64_t) grid->bucket_num;
+}
+
+/**
+ * セル座標からバケット番号を求める
+ */
+static int SpatialGrid_getBucket(const SpatialGrid *grid, const int cell_x, const int cell_y) {
+    const uint32_t hash = ((uint32_t) cell_x * 73856093u) ^ ((uint32_t) cell_y * 19349663u);
+    return (int) (hash & (uint32_t) (grid->bucket_num - 1));
+}
+
+/**
+ * ノードを1つ確保する。
+ * 未使用ノードが無い場合、ノード配列を2倍に拡張する。
+ * 拡張できなかった場合はSPATIALGRID_NONEを返し、既存のノード配列はそのまま残す。
+ */
+static int SpatialGrid_allocNode(SpatialGrid *grid) {
+    if (grid->node_free == SPATIALGRID_NONE) {
+        const int old_capacity = grid->node_capacity;
+        const int new_capacity = old_capacity ? old_capacity * 2 : grid->entity_capacity;
+        int i = 0;
+
+        SpatialGridNode *nodes = (SpatialGridNode*) realloc(grid->nodes, sizeof(SpatialGridNode) * new_capacity);
+        if (!nodes) {
+            __logf("SpatialGrid node alloc failed(%d nodes)", new_capacity);
+            return SPATIALGRID_NONE;
+        }
+        grid->nodes = nodes;
+        for (i = old_capacity; i < new_capacity; ++i) {
+            grid->nodes[i].next = (i + 1) < new_capacity ? (i + 1) : SPATIALGRID_NONE;
+        }
+
+        grid->node_capacity = new_capacity;
+        grid->node_free = old_capacity;
+    }
+
+    const int result = grid->node_free;
+    grid->node_free = grid->nodes[result].next;
+    return result;
+}
+
+/**
+ * エンティティをバケットへ連結する
+ * ノードを確保できなかった場合はfalseを返す。
+ */
+static bool SpatialGrid_linkBucket(SpatialGrid *grid, const int entity, const int bucket) {
+    const int node = SpatialGrid_allocNode(grid);
+    if (node == SPATIALGRID_NONE) {
+        return false;
+    }
+
+    grid->nodes[node].entity = entity;
+    grid->nodes[node].next = grid->buckets[bucket];
+    grid->buckets[bucket] = node;
+    return true;
+}
+
+/**
+ * エンティティをバケットから1つだけ外す
+ */
+static void SpatialGrid_unlinkBucket(SpatialGrid *grid, const int entity, const int bucket) {
+    int *link = &grid->buckets[bucket];
+
+    // ハッシュが衝突したセルに同じエンティティが登録されている場合もあるため、1つだけ外す
+    while ((*link) != SPATIALGRID_NONE) {
+        const int node = (*link);
+        if (grid->nodes[node].entity == entity) {
+            (*link) = grid->nodes[node].next;
+            grid->nodes[node].next = grid->node_free;
+            grid->node_free = node;
+            break;
+        }
+        link = &grid->nodes[node].next;
+    }
+}
+
+/**
+ * エンティティをセル範囲の全バケットへ連結する
+ * 途中でノードを確保できなかった場合はfalseを返す。連結済みのノードは呼び出し側でSpatialGrid_unlink()する。
+ */
+static bool SpatialGrid_link(SpatialGrid *grid, const int entity) {
+    int cell_x = 0;
+    int cell_y = 0;
+
+    if (SpatialGrid_coversAllBuckets(grid, grid->cell_left[entity], grid->cell_top[entity], grid->cell_right[entity], grid->cell_bottom[entity])) {
+        int bucket = 0;
+        for (bucket = 0; bucket < grid->bucket_num; ++bucket) {
+            if (!SpatialGrid_linkBucket(grid, entity, bucket)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    for (cell_y = grid->cell_top[entity]; cell_y <= grid->cell_bottom[entity]; ++cell_y) {
+        for (cell_x = grid->cell_left[entity]; cell_x <= grid->cell_right[entity]; ++cell_x) {
+            if (!SpatialGrid_linkBucket(grid, entity, SpatialGrid_getBucket(grid, cell_x, cell_y))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * エンティティをセル範囲の全バケットから外す
+ */
+static void SpatialGrid_unlink(SpatialGrid *grid, const int entity) {
+    int cell_x = 0;
+    int cell_y = 0;
+
+    if (SpatialGrid_coversAllBuckets(grid, grid->cell_left[entity], grid->cell_top[entity], grid->cell_right[entity], grid->cell_bottom[entity])) {
+        int bucket = 0;
+        for (bucket = 0; bucket < grid->bucket_num; ++bucket) {
+            SpatialGrid_unlinkBucket(grid, entity, bucket);
+        }
+        return;
+    }
+
+    for (cell_y = grid->cell_top[entity]; cell_y <= grid->cell_bottom[entity]; ++cell_y) {
+        for (cell_x = grid->cell_left[entity]; cell_x <= grid->cell_right[entity]; ++cell_x) {
+            SpatialGrid_unlinkBucket(grid, entity, SpatialGrid_getBucket(grid, cell_x, cell_y));
+        }
+    }
+}
+
+/**
+ * エンティティを登録する。
+ */
+bool SpatialGrid_insert(SpatialGrid *grid, const int entity, const GLfloat min_x, const GLfloat min_y, const GLfloat max_x, const GLfloat max_y) {
+    return SpatialGrid_update(grid, entity, min_x, min_y, max_x, max_y);
+}
+
+/**
+ * エンティティの矩形を更新する。
+ */
+bool SpatialGrid_update(SpatialGrid *grid, const int entity, const GLfloat min_x, const GLfloat min_y, const GLfloat max_x, const GLfloat max_y) {
+    assert(grid);
+    assert(entity >= 0 && entity < grid->entity_capacity);
+    assert(min_x <= max_x && min_y <= max_y);
+
+    const int left = SpatialGrid_toCell(grid, min_x);
+    const int top = SpatialGrid_toCell(grid, min_y);
+    const int right = SpatialGrid_toCell(grid, max_x);
+    const int bottom = SpatialGrid_toCell(grid, max_y);
+
+    grid->min_x[entity] = min_x;
+    grid->min_y[entity] = min_y;
+    grid->max_x[entity] = max_x;
+    grid->max_y[entity] = max_y;
+
+    if (grid->inserted[entity]) {
+        // 同じセルに収まっていれば、バケットを変更する必要はない
+        if (grid->cell_left[entity] == left && grid->cell_top[entity] == top && grid->cell_right[entity] == right && grid->cell_bottom[entity] == bottom) {
+            return true;
+        }
+        SpatialGrid_unlink(grid, entity);
+    }
+
+    grid->cell_left[entity] = left;
+    grid->cell_top[entity] = top;
+    grid->cell_right[entity] = right;
+    grid->cell_bottom[entity] = bottom;
+    grid->inserted[entity] = true;
+
+    if (!SpatialGrid_link(grid, entity)) {
+        // 一部のバケットだけに残らないよう、登録を取り消す
+        SpatialGrid_unlink(grid, entity);
+        grid->inserted[entity] = false;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * 矩形配列(SoA)をまとめて登録・更新する。
+ */
+void SpatialGrid_updateFromRects(SpatialGrid *grid, const CullRectArray *rects, const int num) {
+    int i = 0;
+
+    assert(rects);
+    assert(num <= grid->entity_capacity);
+
+    for (i = 0; i < num; ++i) {
+        SpatialGrid_update(grid, i, rects->min_x[i], rects->min_y[i], rects->max_x[i], rects->max_y[i]);
+    }
+}
+
+/**
+ * エンティティの登録を解除する
+ */
+void SpatialGrid_remove(SpatialGrid *grid, const int entity) {
+    assert(grid);
+    assert(entity >= 0 && entity < grid->entity_capacity);
+
+    if (!grid->inserted[entity]) {
+        return;
+    }
+
+    SpatialGrid_unlink(grid, entity);
+    grid->inserted[entity] = false;
+}
+
+/**
+ * バケット内で矩形と重なるエンティティを検索し、見つかった数を加算して返す。
+ */
+static int SpatialGrid_queryBucket(SpatialGrid *grid, const int bucket, const GLfloat min_x, const GLfloat min_y, const GLfloat max_x, const GLfloat max_y, int *result, const int result_max, int found) {
+    int node = grid->buckets[bucket];
+
+    while (node != SPATIALGRID_NONE) {
+        const int entity = grid->nodes[node].entity;
+        node = grid->nodes[node].next;
+
+        // 他のセルで判定済み
+        if (grid->query_stamp[entity] == grid->stamp) {
+            continue;
+        }
+        grid->query_stamp[entity] = grid->stamp;
+
+        // ハッシュの衝突で別のセルの要素が含まれるため、矩形で判定する
+        if (grid->max_x[entity] < min_x || grid->min_x[entity] > max_x || grid->max_y[entity] < min_y || grid->min_y[entity] > max_y) {
+            continue;
+        }
+
+        if (found < result_max) {
+            result[found] = entity;
+        }
+        ++found;
+    }
+    return found;
+}
+
+/**
+ * 矩形と重なるエンティティを検索する。
+ */
+int SpatialGrid_queryRect(SpatialGrid *grid, const GLfloat min_x, const GLfloat min_y, const GLfloat max_x, const GLfloat max_y, int *result, const int result_max) {
+    int found = 0;
+    int cell_x = 0;
+    int cell_y = 0;
+
+    assert(grid);
+
+    const int left = SpatialGrid_toCell(grid, min_x);
+    const int top = SpatialGrid_toCell(grid, min_y);
+    const int right = SpatialGrid_toCell(grid, max_x);
+    const int bottom = SpatialGrid_toCell(grid, max_y);
+
+    // stampが一周した場合は記録を消す
+    if (++grid->stamp == 0) {
+        memset(grid->query_stamp, 0, sizeof(uint32_t) * grid->entity_capacity);
+        grid->stamp = 1;
+    }
+
+    if (SpatialGrid_coversAllBuckets(grid, left, top, right, bottom)) {
+        int bucket = 0;
+        for (bucket = 0; bucket < grid->bucket_num; ++bucket) {
+            found = SpatialGrid_queryBucket(grid, bucket, min_x, min_y, max_x, max_y, result, result_max, found);
+        }
+        return found;
+    }
+
+    for (cell_y = top; cell_y <= bottom; ++cell_y) {
+        for (cell_x = left; cell_x <= right; ++cell_x) {
+            found = SpatialGrid_queryBucket(grid, SpatialGrid_getBucket(grid, cell_x, cell_y), min_x, min_y, max_x, max_y, result, result_max, found);
+        }
+    }
+
+    return found;
+}
+
+/**
+ * 点を含むエンティティを検索する。
+ */
+int SpatialGrid_queryPoint(SpatialGrid *grid, const GLfloat x, const GLfloat y, int *result, const int result_max) {
+    return SpatialGrid_queryRect(grid, x, y, x, y, result, result_max);
+}
+
+/**
+ * 空間ハッシュを解放する
+ */
+void SpatialGrid_free(SpatialGrid *grid) {
+    if (!grid) {
+        return;
+    }
+
+    free(grid->buckets);
+    free(grid->nodes);
+    free(grid->min_x);
+    free(grid->min_y);
+    free(grid->max_x);
+    free(grid->max_y);
+    free(grid->cell_left);
+    free(grid->cell_top);
+    free(grid->cell_right);
+    free(grid->cell_bottom);
+    free(grid->inserted);
+    free(grid->query_stamp);
+    free(grid);
+}
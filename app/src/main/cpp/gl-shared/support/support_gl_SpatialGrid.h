@@ -0,0 +1,168 @@
+/*
+ * support_gl_SpatialGrid.h
+ *
+ *  Created on: 2026/10/19
+ */
+
+#ifndef SUPPORT_GL_SPATIALGRID_H_
+#define SUPPORT_GL_SPATIALGRID_H_
+
+#include    "support.h"
+
+struct CullRectArray;
+
+/**
+ * バケットに登録された要素
+ * ポインタではなく配列のインデックスで連結し、ノードは1つの配列にまとめて確保する。
+ */
+typedef struct SpatialGridNode {
+    /**
+     * 登録されたエンティティID
+     */
+    int entity;
+
+    /**
+     * 同じバケットの次のノード
+     * 末尾の場合は-1
+     */
+    int next;
+} SpatialGridNode;
+
+/**
+ * 一様グリッドによる空間ハッシュ
+ *
+ * 平面をcell_size四方のセルに区切り、セル座標のハッシュ値でバケットを選ぶ。
+ * エンティティは矩形が重なる全てのセルへ登録されるため、
+ * タッチ位置のスプライト検索や矩形同士の近傍検索を、総数によらず周辺のセルを調べるだけで行える。
+ * セル数がバケット数を超える大きな矩形は、セルを辿らずに全バケットへ1度ずつ登録・検索する。
+ *
+ * エンティティIDは0〜entity_capacity-1で、スプライトの配列インデックスをそのまま利用できる。
+ */
+typedef struct SpatialGrid {
+    /**
+     * セルの一辺の長さ
+     * 一般的なスプライトの大きさ程度にすると効率が良い。
+     */
+    GLfloat cell_size;
+
+    /**
+     * 1 / cell_size
+     */
+    GLfloat inv_cell_size;
+
+    /**
+     * バケット数（2のべき乗）
+     */
+    int bucket_num;
+
+    /**
+     * バケットごとの先頭ノード
+     * 空の場合は-1
+     */
+    int *buckets;
+
+    /**
+     * ノード配列
+     */
+    SpatialGridNode *nodes;
+
+    /**
+     * 確保済みのノード数
+     */
+    int node_capacity;
+
+    /**
+     * 未使用ノードのリスト先頭
+     */
+    int node_free;
+
+    /**
+     * 登録できるエンティティ数
+     */
+    int entity_capacity;
+
+    /**
+     * エンティティの矩形(SoA)
+     */
+    GLfloat *min_x;
+    GLfloat *min_y;
+    GLfloat *max_x;
+    GLfloat *max_y;
+
+    /**
+     * エンティティが登録されているセルの範囲
+     */
+    int *cell_left;
+    int *cell_top;
+    int *cell_right;
+    int *cell_bottom;
+
+    /**
+     * 登録済みの場合true
+     */
+    uint8_t *inserted;
+
+    /**
+     * 検索時の重複除去用
+     * 複数のセルにまたがるエンティティを1度だけ返すため、検索ごとにstampを進めて記録する。
+     */
+    uint32_t *query_stamp;
+
+    /**
+     * 最後に行った検索の番号
+     */
+    uint32_t stamp;
+} SpatialGrid;
+
+/**
+ * 空間ハッシュを生成する。
+ * entity_capacityは登録するエンティティIDの上限、cell_sizeはセルの一辺の長さを指定する。
+ * メモリを確保できなかった場合はNULLを返す。
+ * 不要になったらSpatialGrid_free()で解放する。
+ */
+extern SpatialGrid* SpatialGrid_create(const int entity_capacity, const GLfloat cell_size);
+
+/**
+ * エンティティを登録する。
+ * 登録済みの場合はSpatialGrid_update()と同じ動作となる。
+ * ノードを確保できなかった場合はfalseを返し、エンティティは未登録となる。
+ */
+extern bool SpatialGrid_insert(SpatialGrid *grid, const int entity, const GLfloat min_x, const GLfloat min_y, const GLfloat max_x, const GLfloat max_y);
+
+/**
+ * エンティティの矩形を更新する。
+ * 移動後も同じセルの範囲に収まっている場合、バケットは変更せず矩形だけを更新する。
+ * ノードを確保できなかった場合はfalseを返し、エンティティは未登録となる。
+ */
+extern bool SpatialGrid_update(SpatialGrid *grid, const int entity, const GLfloat min_x, const GLfloat min_y, const GLfloat max_x, const GLfloat max_y);
+
+/**
+ * 矩形配列(SoA)の0〜num-1番目を、同じIDのエンティティとしてまとめて登録・更新する。
+ * Cull_rects()と同じ境界データを共有できる。
+ */
+extern void SpatialGrid_updateFromRects(SpatialGrid *grid, const struct CullRectArray *rects, const int num);
+
+/**
+ * エンティティの登録を解除する
+ */
+extern void SpatialGrid_remove(SpatialGrid *grid, const int entity);
+
+/**
+ * 矩形と重なるエンティティを検索し、IDをresultへ書き込む。
+ * 戻り値は見つかったエンティティ数で、result_maxを超えた分は書き込まれない。
+ * 結果の並び順は不定となる。
+ */
+extern int SpatialGrid_queryRect(SpatialGrid *grid, const GLfloat min_x, const GLfloat min_y, const GLfloat max_x, const GLfloat max_y, int *result, const int result_max);
+
+/**
+ * 点を含むエンティティを検索し、IDをresultへ書き込む。
+ * タッチ位置のスプライト検索に利用する。
+ */
+extern int SpatialGrid_queryPoint(SpatialGrid *grid, const GLfloat x, const GLfloat y, int *result, const int result_max);
+
+/**
+ * 空間ハッシュを解放する
+ */
+extern void SpatialGrid_free(SpatialGrid *grid);
+
+#endif /* SUPPORT_GL_SPATIALGRID_H_ */
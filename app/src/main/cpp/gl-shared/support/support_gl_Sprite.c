@@ -7,59 +7,107 @@
 #include    "support.h"
 
 /**
- * スプライト座標への変換行列を作成する。
- * 描画元となるポリゴンは原点を中心に幅1.0/高さ1.0の大きさを持つ四角形である必要がある。
+ * translate <- aspect <- rotate <- scale順の行列を閉じた式で計算する。
+ * 4x4行列の乗算を繰り返した場合と同じ順序で乗算するため、同じ値が得られる。
  */
-mat4 Sprite_createPositionMatrix(const int surface_width, const int surface_height, const GLint x, const GLint y, const GLint width, const GLint height, const GLfloat rotate) {
-    // アスペクト補正用行列
-    const GLfloat surfaceAspect = (GLfloat) surface_width / (GLfloat) surface_height;
-    const mat4 aspect = mat4_scale(1, surfaceAspect, 1);
-
+static void Sprite_composePositionAffine(mat2x3 *result, const GLfloat surfaceAspect, const int surface_width, const int surface_height, const GLint x, const GLint y, const GLint width, const GLint height, const GLfloat rotate) {
     // 拡大率を作成
     // 四角形は長さ1.0のため、描画したい幅 / サーフェイス幅を求め、それを正規化ディスプレイ幅（2倍）をかければいい
     const GLfloat xScale = (GLfloat) width / (GLfloat) surface_width * 2.0f;
     const GLfloat yScale = (GLfloat) height / (GLfloat) surface_width * 2.0f;
 
-    const mat4 scale = mat4_scale(xScale, yScale, 0);
-
-    // 移動行列を作成
+    // 移動量を作成
     // 左上座標は元座標とスケーリング値から計算可能。1.0f - xScaleしているのは目減りした量を計算するため。
     const GLfloat vertexLeft = 0.5f + (1.0f - xScale) * 0.5f;
     const GLfloat vertexTop = 0.5f + (1.0f - (yScale * surfaceAspect)) * 0.5f;
     const GLfloat moveX = (GLfloat) x / (GLfloat) surface_width * 2.0f;
     const GLfloat moveY = -((GLfloat) y / (GLfloat) surface_height * 2.0f);
 
+    // Z軸回転
+    GLfloat s;
+    GLfloat c;
+    trig_sincos(rotate, &s, &c);
+
+    result->m[0][0] = c * xScale;
+    result->m[0][1] = (surfaceAspect * -s) * xScale;
+    result->m[1][0] = s * yScale;
+    result->m[1][1] = (surfaceAspect * c) * yScale;
+
     // 左上に移動し、さらに右下方へオフセットさせる
-    const mat4 translate = mat4_translate(-vertexLeft + moveX, vertexTop + moveY, 0);
+    result->m[2][0] = -vertexLeft + moveX;
+    result->m[2][1] = vertexTop + moveY;
+}
 
-    // 回転を行う
-    const mat4 rotateM = mat4_rotate(vec3_create(0, 0, 1), rotate);
+/**
+ * スプライト座標へのアフィン変換行列を作成する。
+ */
+void Sprite_createPositionAffine(mat2x3 *result, const int surface_width, const int surface_height, const GLint x, const GLint y, const GLint width, const GLint height, const GLfloat rotate) {
+    // アスペクト補正値
+    const GLfloat surfaceAspect = (GLfloat) surface_width / (GLfloat) surface_height;
 
-    // 描画用の行列を生成する translate <- aspect <- rotate <- scale順
-    mat4 matrix = mat4_multiply(translate, aspect);
-    matrix = mat4_multiply(matrix, rotateM);
-    matrix = mat4_multiply(matrix, scale);
-    return matrix;
+    Sprite_composePositionAffine(result, surfaceAspect, surface_width, surface_height, x, y, width, height, rotate);
 }
 
 /**
- * UV座標の変換行列を作成する。
- * 描画元となるポリゴンのUVは0.0->1.0の座標を持つ四角形である必要がある。
+ * 複数のスプライト座標へのアフィン変換行列をまとめて作成する。
  */
-mat4 Sprite_createUvMatrix(const int texture_width, const int texture_height, const GLint x, const GLint y, const GLint width, const GLint height) {
+void Sprite_createPositionAffineArray(mat2x3 *result, const int surface_width, const int surface_height, const SpriteRect *sprites, const int sprite_num) {
+    // アスペクト補正値は全スプライトで共通になる
+    const GLfloat surfaceAspect = (GLfloat) surface_width / (GLfloat) surface_height;
+    int i = 0;
 
-    // スケーリングを行う
+    assert(result);
+    assert(sprites);
+
+    for (i = 0; i < sprite_num; ++i) {
+        const SpriteRect *sprite = sprites + i;
+        Sprite_composePositionAffine(result + i, surfaceAspect, surface_width, surface_height, sprite->x, sprite->y, sprite->width, sprite->height, sprite->rotate);
+    }
+}
+
+/**
+ * スプライト座標への変換行列を作成する。
+ * 描画元となるポリゴンは原点を中心に幅1.0/高さ1.0の大きさを持つ四角形である必要がある。
+ */
+mat4 Sprite_createPositionMatrix(const int surface_width, const int surface_height, const GLint x, const GLint y, const GLint width, const GLint height, const GLfloat rotate) {
+    mat2x3 affine;
+    mat4 matrix;
 
-    const GLfloat xScale = (GLfloat) width / (GLfloat) texture_width;
-    const GLfloat yScale = (GLfloat) height / (GLfloat) texture_height;
+    Sprite_createPositionAffine(&affine, surface_width, surface_height, x, y, width, height, rotate);
+    mat4_fromMat2x3(&matrix, &affine);
 
-    const mat4 scale = mat4_scale(xScale, yScale, 0);
+    // 拡縮行列はZを0へ潰していたため、同じ行列になるよう合わせる
+    matrix.m[2][2] = 0.0f;
+    return matrix;
+}
 
-    // 移動を行う
-    const GLfloat xMove = (GLfloat) x / (GLfloat) texture_width;
-    const GLfloat yMove = (GLfloat) y / (GLfloat) texture_height;
-    const mat4 translate = mat4_translate(xMove, yMove, 0);
+/**
+ * UV座標へのアフィン変換行列を作成する。
+ */
+void Sprite_createUvAffine(mat2x3 *result, const int texture_width, const int texture_height, const GLint x, const GLint y, const GLint width, const GLint height) {
+    // スケーリングを行う
+    result->m[0][0] = (GLfloat) width / (GLfloat) texture_width;
+    result->m[0][1] = 0.0f;
+    result->m[1][0] = 0.0f;
+    result->m[1][1] = (GLfloat) height / (GLfloat) texture_height;
 
-    return mat4_multiply(translate, scale);
+    // 移動を行う
+    result->m[2][0] = (GLfloat) x / (GLfloat) texture_width;
+    result->m[2][1] = (GLfloat) y / (GLfloat) texture_height;
 }
 
+/**
+ * UV座標の変換行列を作成する。
+ * 描画元となるポリゴンのUVは0.0->1.0の座標を持つ四角形である必要がある。
+ */
+mat4 Sprite_createUvMatrix(const int texture_width, const int texture_height, const GLint x, const GLint y, const GLint width, const GLint height) {
+    mat2x3 affine;
+    mat4 matrix;
+
+    Sprite_createUvAffine(&affine, texture_width, texture_height, x, y, width, height);
+    mat4_fromMat2x3(&matrix, &affine);
+
+    // 拡縮行列はZを0へ潰していたため、同じ行列になるよう合わせる
+    matrix.m[2][2] = 0.0f;
+    return matrix;
+}
@@ -9,6 +9,37 @@
 
 #include    "support_gl.h"
 
+/**
+ * スプライトの描画位置
+ * Sprite_createPositionAffineArray()へ渡す
+ */
+typedef struct SpriteRect {
+    /**
+     * 左上X座標(pixel)
+     */
+    GLint x;
+
+    /**
+     * 左上Y座標(pixel)
+     */
+    GLint y;
+
+    /**
+     * 幅(pixel)
+     */
+    GLint width;
+
+    /**
+     * 高さ(pixel)
+     */
+    GLint height;
+
+    /**
+     * 回転角度(360度系)
+     */
+    GLfloat rotate;
+} SpriteRect;
+
 /**
  * スプライト座標への変換行列を作成する。
  * 描画元となるポリゴンは原点を中心に幅1.0/高さ1.0の大きさを持つ四角形である必要がある。
@@ -21,4 +52,22 @@ extern mat4 Sprite_createPositionMatrix(const int surface_width, const int surfa
  */
 extern mat4 Sprite_createUvMatrix(const int texture_width, const int texture_height, const GLint x, const GLint y, const GLint width, const GLint height);
 
+/**
+ * スプライト座標へのアフィン変換行列を作成する。
+ * Sprite_createPositionMatrix()と同じ変換を、4x4行列の乗算を行わずに計算する。
+ */
+extern void Sprite_createPositionAffine(mat2x3 *result, const int surface_width, const int surface_height, const GLint x, const GLint y, const GLint width, const GLint height, const GLfloat rotate);
+
+/**
+ * 複数のスプライト座標へのアフィン変換行列をまとめて作成する。
+ * resultにはsprite_num個の領域が必要になる。
+ */
+extern void Sprite_createPositionAffineArray(mat2x3 *result, const int surface_width, const int surface_height, const SpriteRect *sprites, const int sprite_num);
+
+/**
+ * UV座標へのアフィン変換行列を作成する。
+ * Sprite_createUvMatrix()と同じ変換を、4x4行列の乗算を行わずに計算する。
+ */
+extern void Sprite_createUvAffine(mat2x3 *result, const int texture_width, const int texture_height, const GLint x, const GLint y, const GLint width, const GLint height);
+
 #endif /* SUPPORT_GL_SPRITE_H_ */
@@ -6,11 +6,6 @@
 
 #include    "support.h"
 
-extern Texture* PkmImage_loadTexture(GLApplication *app, const char* file_name);
-extern Texture* PvrtcImage_loadTexture(GLApplication *app, const char* file_name);
-extern Texture* KtxImage_loadTexture(GLApplication *app, const char* file_name);
-extern Texture* RawPixelImage_loadTexture(GLApplication *app, const char* file_name, const int pixel_fotmat);
-
 /**
  * サイズがpotならTEXTURE_POTを返す。npotなら、TEXTURE_NPOTを返す。
  */
@@ -40,21 +35,553 @@ bool Texture_checkPowerOfTwoWH(const int width, const int height) {
     return Texture_checkPowerOfTwo(width) && Texture_checkPowerOfTwo(height);
 }
 
+/**
+ * size以上で最小の2のn乗を取得する
+ */
+int Texture_nextPowerOfTwo(const int size) {
+    int result = 1;
+    while (result < size) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * sizeに最も近い2のn乗を取得する
+ */
+static int Texture_nearestPowerOfTwo(const int size) {
+    const int next = Texture_nextPowerOfTwo(size);
+    const int prev = next / 2;
+    return (prev > 0 && (size - prev) < (next - size)) ? prev : next;
+}
+
+/**
+ * 読込設定に従って画像を縮小・リサイズする。
+ * 新たな画像を作成した場合、imageは解放される。
+ */
+static RawPixelImage* Texture_applyLoadOption(GLApplication *app, RawPixelImage *image, const TextureLoadOption *option) {
+    if (option->scale > 0.0f && option->scale < 1.0f) {
+        // 端末性能に合わせて縮小する
+        int width = (int) ((float) image->width * option->scale + 0.5f);
+        int height = (int) ((float) image->height * option->scale + 0.5f);
+        width = width > 0 ? width : 1;
+        height = height > 0 ? height : 1;
+
+        // 縮小できなかった場合は元の画像のまま転送する
+        RawPixelImage *scaled = RawPixelImage_resample(image, width, height, option->filter);
+        if (scaled) {
+            RawPixelImage_free(app, image);
+            image = scaled;
+        }
+    }
+
+    if (!Texture_checkPowerOfTwoWH(image->width, image->height)) {
+        RawPixelImage *pot = NULL;
+        switch (option->npot) {
+            case TEXTURE_NPOT_PAD:
+                pot = RawPixelImage_pad(image, Texture_nextPowerOfTwo(image->width), Texture_nextPowerOfTwo(image->height));
+                break;
+            case TEXTURE_NPOT_SCALE:
+                pot = RawPixelImage_resample(image, Texture_nearestPowerOfTwo(image->width), Texture_nearestPowerOfTwo(image->height), option->filter);
+                break;
+        }
+
+        if (pot) {
+            __logf("npot(%d x %d) -> pot(%d x %d)", image->width, image->height, pot->width, pot->height);
+            RawPixelImage_free(app, image);
+            image = pot;
+        }
+    }
+
+    return image;
+}
+
+/**
+ * デコード済みの画像を指定フォーマットへ変換する。
+ * 新たな画像を作成した場合、imageは解放される。
+ */
+static RawPixelImage* Texture_convertImage(GLApplication *app, RawPixelImage *image, const int pixel_format) {
+    if (image->format == pixel_format) {
+        return image;
+    }
+
+    RawPixelImage *result = (RawPixelImage*) malloc(sizeof(RawPixelImage));
+    result->format = pixel_format;
+    result->width = image->width;
+    result->height = image->height;
+    result->pixel_data = malloc(image->width * image->height * RawPixelImage_getPixelBytes(pixel_format));
+
+    if (image->format == TEXTURE_RAW_RGBA8) {
+        RawPixelImage_convertColorRGBA(image->pixel_data, pixel_format, result->pixel_data, image->width * image->height);
+    } else {
+        RawPixelImage_convertColorRGB(image->pixel_data, pixel_format, result->pixel_data, image->width * image->height);
+    }
+
+    RawPixelImage_free(app, image);
+    return result;
+}
+
+
+/**
+ * ファイル先頭のマジックナンバーからファイル形式を判定する。
+ */
+int Texture_detectFileFormat(RawData *raw) {
+    const uint8_t *header = (const uint8_t*) RawData_getReadHeader(raw);
+    const int bytes = RawData_getAvailableBytes(raw);
+
+    // "PKM 10"
+    if (bytes >= 16 && memcmp(header, "PKM ", 4) == 0) {
+        return TEXTURE_FILE_PKM;
+    }
+
+    // «KTX 11»\r\n\x1A\n
+    {
+        const uint8_t KTX_IDENTIFIER[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+        if (bytes >= 64 && memcmp(header, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)) == 0) {
+            return TEXTURE_FILE_KTX;
+        }
+    }
+
+    // PVR v3は先頭に"PVR\x03"、v2は44byte目に"PVR!"を持つ
+    if (bytes >= 52 && (memcmp(header, "PVR\x03", 4) == 0 || memcmp(header + 44, "PVR!", 4) == 0)) {
+        return TEXTURE_FILE_PVR;
+    }
+
+    // \x89PNG\r\n\x1A\n
+    {
+        const uint8_t PNG_SIGNATURE[8] = { 0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A };
+        if (bytes >= 8 && memcmp(header, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) == 0) {
+            return TEXTURE_FILE_PNG;
+        }
+    }
+
+    // SOIマーカー
+    if (bytes >= 3 && header[0] == 0xFF && header[1] == 0xD8 && header[2] == 0xFF) {
+        return TEXTURE_FILE_JPEG;
+    }
+
+    return TEXTURE_FILE_UNKNOWN;
+}
+
+/**
+ * Big Endianで16bit整数を読み込む
+ */
+static int Texture_readBE16(const uint8_t *p) {
+    return ((int) p[0] << 8) | (int) p[1];
+}
+
+/**
+ * PNG/JPEGのヘッダから画像サイズを取得する。
+ * ピクセルをデコードせずにサイズだけを知るために利用する。
+ */
+static bool Texture_readImageSize(RawData *raw, const int file_format, int *width, int *height) {
+    const uint8_t *header = (const uint8_t*) RawData_getReadHeader(raw);
+    const int bytes = RawData_getAvailableBytes(raw);
+
+    if (file_format == TEXTURE_FILE_PNG) {
+        // シグネチャ直後のIHDRチャンクに格納されている
+        if (bytes < 24 || memcmp(header + 12, "IHDR", 4) != 0) {
+            return false;
+        }
+        (*width) = (Texture_readBE16(header + 16) << 16) | Texture_readBE16(header + 18);
+        (*height) = (Texture_readBE16(header + 20) << 16) | Texture_readBE16(header + 22);
+        return true;
+    }
+
+    if (file_format == TEXTURE_FILE_JPEG) {
+        // SOFマーカーが見つかるまでセグメントを読み飛ばす
+        int offset = 2;
+        while (offset + 9 <= bytes) {
+            if (header[offset] != 0xFF) {
+                return false;
+            }
+
+            // マーカーの前には任意個の0xFF(fill byte)を置くことができる
+            if (header[offset + 1] == 0xFF) {
+                ++offset;
+                continue;
+            }
+
+            const int marker = header[offset + 1];
+            const bool sof = (marker >= 0xC0 && marker <= 0xCF) && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+            if (sof) {
+                (*height) = Texture_readBE16(header + offset + 5);
+                (*width) = Texture_readBE16(header + offset + 7);
+                return true;
+            }
+            offset += 2 + Texture_readBE16(header + offset + 2);
+        }
+    }
+
+    return false;
+}
 
 /**
  * 画像をテクスチャとして読み込む。
  * 読み込んだ画像はes20_freeTexture()で解放する
  */
 Texture* Texture_load(GLApplication *app, const char* file_name, const int pixel_fotmat) {
-    if (pixel_fotmat == TEXTURE_COMPRESS_ETC1) {
-        return PkmImage_loadTexture(app, file_name);
-    } else if (pixel_fotmat == TEXTURE_COMPRESS_PVRTC) {
-        return PvrtcImage_loadTexture(app, file_name);
-    } else if (pixel_fotmat == TEXTURE_COMPRESS_KTX) {
-        return KtxImage_loadTexture(app, file_name);
+    return Texture_loadWithOption(app, file_name, pixel_fotmat, NULL);
+}
+
+/**
+ * コンテキスト復帰用に保持しているテクスチャ
+ */
+typedef struct TextureRetained {
+    /**
+     * 復帰対象のテクスチャ
+     */
+    Texture *texture;
+
+    /**
+     * 読込時のファイル名
+     * 復帰に失敗した場合のログに利用する。
+     */
+    char file_name[128];
+
+    /**
+     * 元ファイルのコピー
+     */
+    void *source;
+
+    /**
+     * 元ファイルの長さ
+     */
+    int source_bytes;
+
+    /**
+     * 読込時のフォーマット
+     */
+    int pixel_format;
+
+    /**
+     * 短冊状に転送する場合の作業メモリの上限(byte)
+     * 0の場合は分割しない。
+     */
+    int strip_bytes;
+
+    /**
+     * 読込設定を利用した場合true
+     */
+    bool has_option;
+
+    /**
+     * 読込設定
+     * 呼び出し元が先に解放する可能性があるため、cacheは保持しない。
+     */
+    TextureLoadOption option;
+} TextureRetained;
+
+/**
+ * 元ファイルの保持方針
+ * TEXTURE_RETAIN_XXX
+ */
+static int texture_retain_policy = TEXTURE_RETAIN_NONE;
+
+/**
+ * 保持しているテクスチャ数
+ */
+static int texture_retained_num = 0;
+
+/**
+ * texture_retainedの確保数
+ */
+static int texture_retained_capacity = 0;
+
+/**
+ * 保持しているテクスチャ
+ */
+static TextureRetained *texture_retained = NULL;
+
+/**
+ * 読み込み済みのファイルからテクスチャを作成する。
+ * rawの所有権は移動する。
+ * strip_bytesが0より大きい場合、それを超えるPNG/JPEGは短冊状に分割して転送する。
+ */
+static Texture* Texture_createFromRawData(GLApplication *app, RawData *raw, const char* file_name, const int pixel_fotmat, const TextureLoadOption *option, const int strip_bytes) {
+    Texture *texture = NULL;
+    const int file_format = Texture_detectFileFormat(raw);
+
+    // ファイルの中身に合わせて読み込み方法を切り替える
+    // 各loadFromRawData()はrawの所有権を持つため、ここでは解放しない
+    switch (file_format) {
+        case TEXTURE_FILE_PKM: {
+            PkmImage *pkm = PkmImage_loadFromRawData(app, raw);
+            if (pkm) {
+                texture = PkmImage_createTexture(app, pkm, pixel_fotmat == TEXTURE_COMPRESS_ETC1A ? TEXTURE_COMPRESS_ETC1A : TEXTURE_COMPRESS_ETC1);
+                PkmImage_free(app, pkm);
+            }
+        }
+            break;
+        case TEXTURE_FILE_KTX: {
+            KtxImage *ktx = KtxImage_loadFromRawData(app, raw);
+            if (ktx) {
+                texture = KtxImage_createTexture(app, ktx);
+                KtxImage_free(app, ktx);
+            }
+        }
+            break;
+        case TEXTURE_FILE_PVR: {
+            PvrtcImage *pvrtc = PvrtcImage_loadFromRawData(app, raw);
+            if (pvrtc) {
+                texture = PvrtcImage_createTexture(app, pvrtc);
+                PvrtcImage_free(app, pvrtc);
+            }
+        }
+            break;
+        case TEXTURE_FILE_PNG:
+        case TEXTURE_FILE_JPEG: {
+            // 圧縮形式が指定されていた場合はRGBA8888として読み込む
+            const int raw_format = (pixel_fotmat >= TEXTURE_RAW_RGBA8 && pixel_fotmat <= TEXTURE_RAW_RGB565) ? pixel_fotmat : TEXTURE_RAW_RGBA8;
+
+            uint64_t cache_key = 0;
+            if (option && option->cache) {
+                // 変換済みのキャッシュがあれば、デコードせずにそのまま転送する
+                cache_key = TextureCache_createKey(raw->head, raw->length, raw_format, option);
+                TextureCacheImage *cached = TextureCache_find(option->cache, cache_key);
+                if (cached) {
+                    texture = RawPixelImage_createTexture(app, cached->image);
+                    TextureCache_release(cached);
+                    RawData_freeFile(app, raw);
+                    break;
+                }
+            }
+
+            if (option) {
+                // リサンプリングは8bit/chで行い、最後に指定フォーマットへ変換する
+                const bool has_alpha = (raw_format == TEXTURE_RAW_RGBA8 || raw_format == TEXTURE_RAW_RGBA5551);
+                RawPixelImage *image = RawPixelImage_loadFromRawData(app, raw, has_alpha ? TEXTURE_RAW_RGBA8 : TEXTURE_RAW_RGB8);
+                if (image) {
+                    image = Texture_applyLoadOption(app, image, option);
+                    image = Texture_convertImage(app, image, raw_format);
+                    if (option->cache) {
+                        TextureCache_store(option->cache, cache_key, image);
+                    }
+                    texture = RawPixelImage_createTexture(app, image);
+                    RawPixelImage_free(app, image);
+                }
+                break;
+            }
+
+            // 大きな画像は全ピクセルをデコードせず、短冊状に分割して転送する
+            int width = 0;
+            int height = 0;
+            if (strip_bytes > 0 && Texture_readImageSize(raw, file_format, &width, &height) && ((int64_t) width * (int64_t) height * 4) > (int64_t) strip_bytes) {
+                RawPixelImageStream *stream = RawPixelImageStream_open(app, raw);
+                if (stream) {
+                    texture = RawPixelImage_createTextureWithStream(app, stream, raw_format, strip_bytes);
+                    RawPixelImageStream_close(app, stream);
+                    RawData_freeFile(app, raw);
+                    break;
+                }
+                // 分割デコードに対応していない場合は通常通り読み込む
+            }
+
+            RawPixelImage *image = RawPixelImage_loadFromRawData(app, raw, raw_format);
+            if (image) {
+                texture = RawPixelImage_createTexture(app, image);
+                RawPixelImage_free(app, image);
+            }
+        }
+            break;
+        default:
+            __logf("unknown texture file(%s)", file_name);
+            RawData_freeFile(app, raw);
+            break;
+    }
+
+    if (!texture) {
+        __logf("texture load fail...(%s)", file_name);
+    }
+    return texture;
+}
+
+/**
+ * ファイルを読み込み、テクスチャを作成する。
+ * 保持方針に従って元ファイルを復帰用に登録する。
+ */
+static Texture* Texture_loadFile(GLApplication *app, const char* file_name, const int pixel_fotmat, const TextureLoadOption *option, const int strip_bytes) {
+    RawData *raw = RawData_loadFile(app, file_name);
+    if (!raw) {
+        return NULL;
+    }
+
+    void *source = NULL;
+    const int source_bytes = raw->length;
+    if (texture_retain_policy == TEXTURE_RETAIN_SOURCE) {
+        // 各loaderがrawを解放する前に、元ファイルをコピーしておく
+        source = malloc(source_bytes);
+        memcpy(source, raw->head, source_bytes);
+    }
+
+    Texture *texture = Texture_createFromRawData(app, raw, file_name, pixel_fotmat, option, strip_bytes);
+    if (!source) {
+        return texture;
+    }
+    if (!texture) {
+        free(source);
+        return NULL;
+    }
+
+    {
+        // 復帰用に登録する
+        if (texture_retained_num == texture_retained_capacity) {
+            texture_retained_capacity = texture_retained_capacity ? texture_retained_capacity * 2 : 16;
+            texture_retained = (TextureRetained*) realloc(texture_retained, sizeof(TextureRetained) * texture_retained_capacity);
+        }
+
+        TextureRetained *retained = texture_retained + texture_retained_num;
+        retained->texture = texture;
+        snprintf(retained->file_name, sizeof(retained->file_name), "%s", file_name);
+        retained->source = source;
+        retained->source_bytes = source_bytes;
+        retained->pixel_format = pixel_fotmat;
+        retained->strip_bytes = strip_bytes;
+        retained->has_option = (option != NULL);
+        if (option) {
+            retained->option = (*option);
+            retained->option.cache = NULL;
+        }
+        ++texture_retained_num;
+    }
+    return texture;
+}
+
+/**
+ * 画像をリサンプリングしてからテクスチャとして読み込む。
+ */
+Texture* Texture_loadWithOption(GLApplication *app, const char* file_name, const int pixel_fotmat, const TextureLoadOption *option) {
+    return Texture_loadFile(app, file_name, pixel_fotmat, option, 0);
+}
+
+/**
+ * 大きなPNG/JPEGを短冊状にデコードしながらテクスチャとして読み込む。
+ */
+Texture* Texture_loadStreaming(GLApplication *app, const char* file_name, const int pixel_fotmat, const int strip_bytes) {
+    assert(strip_bytes > 0);
+    return Texture_loadFile(app, file_name, pixel_fotmat, NULL, strip_bytes);
+}
+
+/**
+ * 読み込んだテクスチャの元ファイルを保持するかを設定する。
+ */
+void Texture_setRetainPolicy(const int policy) {
+    assert(policy == TEXTURE_RETAIN_NONE || policy == TEXTURE_RETAIN_SOURCE);
+    texture_retain_policy = policy;
+}
+
+/**
+ * 保持している元ファイルの合計バイト数を取得する。
+ */
+int Texture_getRetainedBytes() {
+    int result = 0;
+    int i = 0;
+    for (i = 0; i < texture_retained_num; ++i) {
+        result += texture_retained[i].source_bytes;
+    }
+    return result;
+}
+
+/**
+ * 保持している元ファイルから、全てのテクスチャのGLオブジェクトを作り直す。
+ */
+int Texture_restoreAll(GLApplication *app) {
+    int result = 0;
+    int i = 0;
+    for (i = 0; i < texture_retained_num; ++i) {
+        TextureRetained *retained = texture_retained + i;
+
+        RawData *raw = (RawData*) malloc(sizeof(RawData));
+        raw->head = malloc(retained->source_bytes);
+        raw->length = retained->source_bytes;
+        raw->read_head = (uint8_t*) raw->head;
+        memcpy(raw->head, retained->source, retained->source_bytes);
+
+        Texture *restored = Texture_createFromRawData(app, raw, retained->file_name, retained->pixel_format, retained->has_option ? &retained->option : NULL, retained->strip_bytes);
+        if (!restored) {
+            __logf("texture restore skipped(%s)", retained->file_name);
+            continue;
+        }
+
+        // 失われたIDは既に無効なため、削除せずに差し替える
+        Texture *texture = retained->texture;
+        texture->id = restored->id;
+        texture->width = restored->width;
+        texture->height = restored->height;
+        texture->vram_bytes = restored->vram_bytes;
+        texture->upload_completed = true;
+        free(restored);
+        ++result;
+    }
+
+    __logf("texture restored(%d / %d) %d bytes", result, texture_retained_num, Texture_getRetainedBytes());
+    return result;
+}
+
+/**
+ * 単色のマスク画像を1枚のテクスチャの各チャンネルへまとめて読み込む。
+ */
+Texture* Texture_loadChannelPack(GLApplication *app, const char* file_names[], const int file_num, const int pixel_format, TextureChannel result[]) {
+    assert(pixel_format == TEXTURE_RAW_RGBA8 || pixel_format == TEXTURE_COMPRESS_ETC1);
+    assert(file_num > 0 && file_num <= (pixel_format == TEXTURE_COMPRESS_ETC1 ? 3 : TEXTURE_CHANNEL_PACK_MAX));
+
+    const RawPixelImage *masks[TEXTURE_CHANNEL_PACK_MAX] = { NULL };
+    RawPixelImage *packed = NULL;
+    Texture *texture = NULL;
+
+    int i = 0;
+    for (i = 0; i < file_num; ++i) {
+        masks[i] = RawPixelImage_load(app, file_names[i], TEXTURE_RAW_RGBA8);
+        if (!masks[i]) {
+            __logf("texture load fail...(%s)", file_names[i]);
+            goto cleanup;
+        }
+    }
+
+    packed = RawPixelImage_packChannels(masks, file_num);
+    if (!packed) {
+        goto cleanup;
+    }
+
+    if (pixel_format == TEXTURE_COMPRESS_ETC1) {
+        // ETC1ブロックへ圧縮し、PKM画像と同じ経路で転送する
+        PkmImage pkm = { 0 };
+        pkm.width = pkm.origin_width = (packed->width + 3) & ~0x3;
+        pkm.height = pkm.origin_height = (packed->height + 3) & ~0x3;
+        pkm.image_bytes = (pkm.width / 4) * (pkm.height / 4) * 8;
+        pkm.image = malloc(pkm.image_bytes);
+
+        Etc1_encodeImage(packed->pixel_data, packed->format, packed->width, packed->height, false, pkm.image);
+        texture = PkmImage_createTexture(app, &pkm, TEXTURE_COMPRESS_ETC1);
+        free(pkm.image);
     } else {
-        return RawPixelImage_loadTexture(app, file_name, pixel_fotmat);
+        texture = RawPixelImage_createTexture(app, packed);
     }
+
+    if (texture) {
+        for (i = 0; i < file_num; ++i) {
+            result[i].texture = texture;
+            result[i].channel = TEXTURE_CHANNEL_R + i;
+        }
+    }
+
+    cleanup: {
+        for (i = 0; i < file_num; ++i) {
+            RawPixelImage_free(app, (RawPixelImage*) masks[i]);
+        }
+        RawPixelImage_free(app, packed);
+    }
+    return texture;
+}
+
+/**
+ * チャンネルを取り出すためのセレクタを取得する。
+ */
+void TextureChannel_getSelector(const TextureChannel *channel, GLfloat result[4]) {
+    assert(channel->channel >= TEXTURE_CHANNEL_R && channel->channel <= TEXTURE_CHANNEL_A);
+
+    result[0] = result[1] = result[2] = result[3] = 0.0f;
+    result[channel->channel] = 1.0f;
 }
 
 /**
@@ -64,10 +591,50 @@ bool Texture_isPowerOfTwo(Texture *texture) {
     return Texture_checkPowerOfTwo(texture->width) && Texture_checkPowerOfTwo(texture->height);
 }
 
+/**
+ * mipmapを生成し、推定サイズを更新する。
+ */
+void Texture_generateMipmap(Texture *texture) {
+    assert(texture);
+
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    assert(glGetError() == GL_NO_ERROR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    {
+        // 各レベルのピクセル数の合計から、level 0に対する比率で推定する
+        const int64_t level0_pixels = (int64_t) texture->width * (int64_t) texture->height;
+        int64_t pixels = 0;
+        int width = texture->width;
+        int height = texture->height;
+        while (true) {
+            pixels += (int64_t) width * (int64_t) height;
+            if (width == 1 && height == 1) {
+                break;
+            }
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+        texture->vram_bytes = (int) ((int64_t) texture->vram_bytes * pixels / level0_pixels);
+    }
+}
+
 /**
  * テクスチャを解放する。
  */
 void Texture_free(Texture *texture) {
+    int i = 0;
+    for (i = 0; i < texture_retained_num; ++i) {
+        if (texture_retained[i].texture == texture) {
+            // 保持していた元ファイルを破棄する
+            free(texture_retained[i].source);
+            texture_retained[i] = texture_retained[texture_retained_num - 1];
+            --texture_retained_num;
+            break;
+        }
+    }
+
     glDeleteTextures(1, &texture->id);
     free((void*) texture);
 }
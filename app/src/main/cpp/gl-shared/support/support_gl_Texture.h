@@ -40,6 +40,37 @@
  */
 #define TEXTURE_RAW_RGB565       3
 
+/**
+ * Texture_detectFileFormat()の戻り値
+ * 判別できないファイル
+ */
+#define TEXTURE_FILE_UNKNOWN      0
+
+/**
+ * ETC1-PKMファイル
+ */
+#define TEXTURE_FILE_PKM          1
+
+/**
+ * Khronos Textureファイル
+ */
+#define TEXTURE_FILE_KTX          2
+
+/**
+ * PVR(v2 legacy / v3)ファイル
+ */
+#define TEXTURE_FILE_PVR          3
+
+/**
+ * PNGファイル
+ */
+#define TEXTURE_FILE_PNG          4
+
+/**
+ * JPEGファイル
+ */
+#define TEXTURE_FILE_JPEG         5
+
 /**
  * 読み込んだ画像のピクセル情報をそのまま保存する構造体
  */
@@ -68,12 +99,79 @@ typedef struct RawPixelImage {
      */
     int format;
 } RawPixelImage;
+/**
+ * ライン単位でデコードしている画像
+ * デコード済みのピクセル全体をメモリに持たずにテクスチャを作成するために利用する。
+ */
+typedef struct RawPixelImageStream {
+    /**
+     * 画像幅
+     */
+    int width;
+
+    /**
+     * 画像高さ
+     */
+    int height;
+
+    /**
+     * 任意のラインから効率よくデコードできる場合true（JPEG）
+     * falseの場合（PNG）は分割数をTEXTURE_STRIP_PNG_MAX_STRIPSに制限する。
+     */
+    bool random_access;
+
+    /**
+     * プラットフォーム固有データを格納する。
+     */
+    void* platform;
+} RawPixelImageStream;
+
+/**
+ * Texture_loadStreaming()でPNG/JPEGを短冊状に分割してアップロードする際の、標準的な作業メモリの上限(byte)
+ * RGBA8888換算でこの値を超える画像は、この値に収まるライン数ずつデコード・転送する。
+ */
+#define TEXTURE_STRIP_UPLOAD_BYTES    (1024 * 1024)
+
+/**
+ * PNGを短冊状に分割する場合の最大分割数
+ * PNGは途中のラインから読み始められず、短冊ごとに先頭からデコードし直すため、
+ * 分割数Nに対して画像全体のおよそN/2回分のデコード時間がかかる。
+ * 分割数をこの値に制限し、作業メモリが増える代わりにデコード時間を抑える。
+ */
+#define TEXTURE_STRIP_PNG_MAX_STRIPS  8
+
 /**
  * 画像を読み込む。
  * 読み込んだ画像はes20_freeImage()で解放する
  */
 extern RawPixelImage* RawPixelImage_load(GLApplication *app, const char* file_name, const int pixel_format);
 
+/**
+ * 読み込み済みのPNG/JPEGファイルをデコードする。
+ * rawの所有権は関数へ移り、成功/失敗に関わらず解放される。
+ */
+extern RawPixelImage* RawPixelImage_loadFromRawData(GLApplication *app, RawData *raw, const int pixel_format);
+
+/**
+ * 読み込み済みのPNG/JPEGファイルをライン単位でデコードできるよう開く。
+ * この時点ではヘッダのみを解析し、ピクセルのデコードは行わない。
+ * rawの所有権は移らないため、呼び出し元で解放する。
+ * 開いた画像はRawPixelImageStream_close()で解放する
+ */
+extern RawPixelImageStream* RawPixelImageStream_open(GLApplication *app, RawData *raw);
+
+/**
+ * 指定ラインをデコードし、RGBA8888のピクセル配列を返す。
+ * 戻り値は次の呼び出しまで有効。
+ * デコードに失敗した場合はNULLを返す。
+ */
+extern const void* RawPixelImageStream_readLines(RawPixelImageStream *stream, const int y, const int lines);
+
+/**
+ * RawPixelImageStream_open()で開いた画像を解放する
+ */
+extern void RawPixelImageStream_close(GLApplication *app, RawPixelImageStream *stream);
+
 /**
  * es20_loadImage()関数から読み込んだ画像を解放する
  */
@@ -89,6 +187,83 @@ extern void RawPixelImage_convertColorRGB(const void *rgb888_pixels, const int p
  */
 extern void RawPixelImage_convertColorRGBA(const void *rgba8888_pixels, const int pixel_format, void *dst_pixels, const int pixel_num);
 
+/**
+ * TEXTURE_RAW_XXXの1ピクセルのバイト数を取得する
+ */
+extern int RawPixelImage_getPixelBytes(const int pixel_format);
+
+/**
+ * TEXTURE_RAW_XXXに対応するGLのフォーマット(GL_RGBA / GL_RGB)を取得する
+ */
+extern GLenum RawPixelImage_getGLFormat(const int pixel_format);
+
+/**
+ * TEXTURE_RAW_XXXに対応するGLのピクセルタイプを取得する
+ */
+extern GLenum RawPixelImage_getGLType(const int pixel_format);
+
+/**
+ * リサンプリングフィルタ：バイリニア
+ */
+#define TEXTURE_RESAMPLE_BILINEAR     0
+
+/**
+ * リサンプリングフィルタ：バイキュービック(Catmull-Rom)
+ */
+#define TEXTURE_RESAMPLE_BICUBIC      1
+
+/**
+ * リサンプリングフィルタ：Lanczos3
+ * 最も高品質だが、処理が重い。
+ */
+#define TEXTURE_RESAMPLE_LANCZOS      2
+
+/**
+ * 画像を指定サイズへリサンプリングし、新たな画像を作成する。
+ * 画像はTEXTURE_RAW_RGBA8かTEXTURE_RAW_RGB8である必要がある。
+ * 縮小時は縮小率に合わせてフィルタを広げるため、エイリアシングが起こりにくい。
+ * メモリを確保できなかった場合はNULLを返す。
+ * 作成した画像はRawPixelImage_free()で解放する
+ */
+extern RawPixelImage* RawPixelImage_resample(const RawPixelImage *image, const int width, const int height, const int filter);
+
+/**
+ * 画像を指定サイズのキャンバスの左上へ配置し、新たな画像を作成する。
+ * はみ出した領域は画像の右端・下端のピクセルで埋める。
+ * 作成した画像はRawPixelImage_free()で解放する
+ */
+extern RawPixelImage* RawPixelImage_pad(const RawPixelImage *image, const int width, const int height);
+
+/**
+ * 1枚のテクスチャへまとめられるマスクの最大数
+ */
+#define TEXTURE_CHANNEL_PACK_MAX      4
+
+/**
+ * マスクを格納したチャンネル
+ */
+#define TEXTURE_CHANNEL_R             0
+#define TEXTURE_CHANNEL_G             1
+#define TEXTURE_CHANNEL_B             2
+#define TEXTURE_CHANNEL_A             3
+
+/**
+ * 単色のマスク画像を最大4枚、RGBA8888画像の各チャンネルへまとめる。
+ * masks[i]はi番目のチャンネル(TEXTURE_CHANNEL_R〜A)へ格納され、使わないチャンネルは0で埋める。
+ * マスクはTEXTURE_RAW_RGBA8かTEXTURE_RAW_RGB8で、全て同じサイズである必要がある。
+ * 各マスクの値はRawPixelImage_getMaskChannel()のチャンネルから取り出し、選んだチャンネルをログへ出力する。
+ * サイズが揃わない場合はNULLを返す。
+ */
+extern RawPixelImage* RawPixelImage_packChannels(const RawPixelImage *masks[], const int mask_num);
+
+/**
+ * マスク画像の値として利用するチャンネルを取得する。
+ * 1pixelでもアルファが0xFFでないRGBA画像はアルファマスクとみなしてTEXTURE_CHANNEL_Aを、
+ * それ以外(完全に不透明なRGBA画像とRGB画像)はグレースケール画像とみなしてTEXTURE_CHANNEL_Rを返す。
+ * 不透明なアルファマスクや、Rと異なる色のグレースケール画像を渡す場合は、事前に値をRへ揃えておく。
+ */
+extern int RawPixelImage_getMaskChannel(const RawPixelImage *mask);
+
 /**
  * テクスチャ用構造体
  */
@@ -107,8 +282,35 @@ typedef struct Texture {
      * GL側のテクスチャID
      */
     GLuint id;
+
+    /**
+     * VRAMへの転送が完了していればtrue
+     * TextureUploaderで転送待ちのテクスチャはfalseとなり、描画に利用してはならない。
+     * ただしTextureUploader_requestProgressive()で読み込んだ場合、転送中も低解像度のプレビューとして描画に利用できる。
+     */
+    bool upload_completed;
+
+    /**
+     * VRAM上の推定サイズ(byte)
+     * フォーマットごとの1pixelのサイズ × 画像サイズ × mipmapの合計となる。
+     */
+    int vram_bytes;
 } Texture;
 
+/**
+ * デコード済みの画像からテクスチャを作成する。
+ */
+extern Texture* RawPixelImage_createTexture(GLApplication *app, RawPixelImage *image);
+
+/**
+ * ライン単位でデコードしながらテクスチャを作成する。
+ * VRAMを確保した後、strip_bytesに収まるライン数ずつglTexSubImage2Dで転送するため、
+ * CPU側の作業メモリは画像サイズに関わらずstrip_bytes程度に抑えられる。
+ * stream->random_accessがfalseの場合、分割数はTEXTURE_STRIP_PNG_MAX_STRIPS以下となる。
+ * 途中のデコードに失敗した場合は作成中のテクスチャを解放し、NULLを返す。
+ */
+extern Texture* RawPixelImage_createTextureWithStream(GLApplication *app, RawPixelImageStream *stream, const int pixel_format, const int strip_bytes);
+
 /**
  * 引数sizeがpotならtrueを返す。
  */
@@ -119,17 +321,172 @@ extern bool Texture_checkPowerOfTwo(const int size);
  */
 extern bool Texture_checkPowerOfTwoWH(const int width, const int height);
 
+/**
+ * size以上で最小の2のn乗を取得する
+ */
+extern int Texture_nextPowerOfTwo(const int size);
+
+/**
+ * NPOT画像をそのまま読み込む
+ */
+#define TEXTURE_NPOT_KEEP     0
+
+/**
+ * NPOT画像を2のn乗のキャンバスの左上へ配置する。
+ * テクスチャのwidth/heightはキャンバスサイズとなるため、ピクセル単位のUV指定はそのまま利用できる。
+ */
+#define TEXTURE_NPOT_PAD      1
+
+/**
+ * NPOT画像を最も近い2のn乗へリサンプリングする。
+ * mipmapとGL_REPEATを利用できるようになる。
+ */
+#define TEXTURE_NPOT_SCALE    2
+
+/**
+ * Texture_loadWithOption()の読込設定
+ */
+typedef struct TextureLoadOption {
+    /**
+     * NPOT画像の扱い
+     * TEXTURE_NPOT_XXX
+     */
+    int npot;
+
+    /**
+     * リサンプリングフィルタ
+     * TEXTURE_RESAMPLE_XXX
+     */
+    int filter;
+
+    /**
+     * 読込時の縮小率(0.0〜1.0)
+     * 低スペック端末向けに、転送前に画像を縮小する。1.0の場合は縮小しない。
+     */
+    float scale;
+
+    /**
+     * 変換済み画像のディスクキャッシュ
+     * NULLの場合はキャッシュを利用しない。
+     */
+    struct TextureCache *cache;
+} TextureLoadOption;
+
+/**
+ * ファイル先頭のマジックナンバーからファイル形式(TEXTURE_FILE_XXX)を判定する。
+ * 読込位置は変更しない。
+ */
+extern int Texture_detectFileFormat(RawData *raw);
+
 /**
  * 画像をテクスチャとして読み込む。
  * 読み込んだ画像はes20_freeTexture()で解放する
+ *
+ * ファイル形式はヘッダから自動判定するため、圧縮テクスチャはpixel_fotmatに関わらず読み込める。
+ * PNG/JPEGの場合はpixel_fotmatのTEXTURE_RAW_XXXへ変換し、圧縮形式が指定されていればTEXTURE_RAW_RGBA8として扱う。
+ * PKMの場合、TEXTURE_COMPRESS_ETC1Aを指定した場合のみETC1Aとして扱う。
  */
 extern Texture* Texture_load(GLApplication *app, const char* file_name, const int pixel_fotmat);
 
+/**
+ * 画像をリサンプリングしてからテクスチャとして読み込む。
+ * optionはPNG/JPEGにのみ適用され、圧縮テクスチャはTexture_load()と同じく読み込まれる。
+ * optionがNULLの場合はTexture_load()と同じ動作となる。
+ */
+extern Texture* Texture_loadWithOption(GLApplication *app, const char* file_name, const int pixel_fotmat, const TextureLoadOption *option);
+
+/**
+ * 大きなPNG/JPEGを短冊状にデコードしながらテクスチャとして読み込む。
+ * RGBA8888換算でstrip_bytesを超える画像は、全ピクセルをデコードせずにstrip_bytesに収まるライン数ずつ転送する。
+ * 通常はstrip_bytesにTEXTURE_STRIP_UPLOAD_BYTESを指定する。
+ * PNGの場合は分割数がTEXTURE_STRIP_PNG_MAX_STRIPSに制限されるため、作業メモリはstrip_bytesを超える場合がある。
+ * それ以外の画像はTexture_load()と同じく読み込まれる。
+ */
+extern Texture* Texture_loadStreaming(GLApplication *app, const char* file_name, const int pixel_fotmat, const int strip_bytes);
+
+/**
+ * 元ファイルを保持しない
+ */
+#define TEXTURE_RETAIN_NONE       0
+
+/**
+ * Texture_load() / Texture_loadWithOption() / Texture_loadStreaming()で読み込んだ元ファイル
+ * (PKM/KTX/PVRの圧縮データ、PNG/JPEGのファイル)をメモリに保持する。
+ * コンテキストを失った場合、assetsを読み直さずにTexture_restoreAll()で復帰できる。
+ *
+ * それ以外で作成したテクスチャ(TextureUploader、TextureAtlas、VirtualTexture、
+ * Texture_loadChannelPack()、各XxxImage_createTexture()等)は保持の対象外となり、
+ * 呼び出し側で作り直す必要がある。
+ */
+#define TEXTURE_RETAIN_SOURCE     1
+
+/**
+ * 以降にTexture_load() / Texture_loadWithOption() / Texture_loadStreaming()で読み込むテクスチャの保持方針を設定する。
+ * TEXTURE_RETAIN_XXX
+ * 初期値はTEXTURE_RETAIN_NONE。
+ */
+extern void Texture_setRetainPolicy(const int policy);
+
+/**
+ * 保持している元ファイルの合計バイト数を取得する。
+ */
+extern int Texture_getRetainedBytes();
+
+/**
+ * EGLコンテキストの再作成後に呼び出し、保持している全てのテクスチャのGLオブジェクトを作り直す。
+ * Textureのポインタはそのままで、idのみが新しいものに差し替わる。
+ * wrap / filterは読込時の初期値に戻るため、必要であれば再設定する。
+ * 復帰時はTextureLoadOption.cacheを利用せず、元ファイルからデコードし直す。
+ * 保持の対象はTEXTURE_RETAIN_SOURCEで読み込んだテクスチャのみであり、それ以外のテクスチャは復帰しない。
+ * 戻り値は復帰できたテクスチャ数。復帰に失敗したテクスチャはファイル名をログへ出力する。
+ */
+extern int Texture_restoreAll(GLApplication *app);
+
+/**
+ * 1枚のテクスチャ内の1チャンネルを参照するハンドル
+ * Texture_loadChannelPack()で作成したテクスチャは、複数のハンドルから共有される。
+ */
+typedef struct TextureChannel {
+    /**
+     * 共有テクスチャ
+     * 解放はTexture_loadChannelPack()の戻り値に対して1度だけ行う。
+     */
+    Texture *texture;
+
+    /**
+     * マスクを格納したチャンネル
+     * TEXTURE_CHANNEL_XXX
+     */
+    int channel;
+} TextureChannel;
+
+/**
+ * 単色のマスク画像を1枚のテクスチャの各チャンネルへまとめて読み込む。
+ * pixel_formatはTEXTURE_RAW_RGBA8(最大4枚)かTEXTURE_COMPRESS_ETC1(最大3枚)を指定する。
+ * ETC1はブロック内でチャンネル間の誤差が影響し合うため、ぼかしたマスクやライトマップ向けとなる。
+ * resultにはfile_num個のハンドルが格納される。
+ * 読み込んだテクスチャはTexture_free()で解放する
+ */
+extern Texture* Texture_loadChannelPack(GLApplication *app, const char* file_names[], const int file_num, const int pixel_format, TextureChannel result[]);
+
+/**
+ * チャンネルを取り出すためのセレクタを取得する。
+ * シェーダーで dot(texture2D(tex, uv), selector) とするとマスク値が得られる。
+ * resultはglUniform4fv()へそのまま渡せる。
+ */
+extern void TextureChannel_getSelector(const TextureChannel *channel, GLfloat result[4]);
+
 /**
  * テクスチャの縦横が2のn乗であればtrueを返す
  */
 extern bool Texture_isPowerOfTwo(Texture *texture);
 
+/**
+ * glGenerateMipmap()でmipmapを生成し、vram_bytesをmipmapを含めたサイズへ更新する。
+ * vram_bytesはlevel 0のみのサイズである必要があるため、mipmapを持たないテクスチャに1度だけ呼び出す。
+ */
+extern void Texture_generateMipmap(Texture *texture);
+
 /**
  * テクスチャを解放する。
  */
@@ -0,0 +1,182 @@
+/*
+ * support_gl_TextureAtlas.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+
+/**
+ * アトラスを作成する。
+ */
+TextureAtlas* TextureAtlas_create(const int page_width, const int page_height, const int pixel_format, const int padding) {
+    assert(page_width > 0 && page_height > 0);
+    assert(padding >= 0);
+
+    TextureAtlas *result = (TextureAtlas*) calloc(1, sizeof(TextureAtlas));
+    result->page_width = page_width;
+    result->page_height = page_height;
+    result->pixel_format = pixel_format;
+    result->padding = padding;
+    return result;
+}
+
+/**
+ * 新たなページを作成する。
+ */
+static TextureAtlasPage* TextureAtlas_addPage(TextureAtlas *atlas) {
+    if (atlas->page_num == atlas->page_capacity) {
+        atlas->page_capacity = atlas->page_capacity ? atlas->page_capacity * 2 : 4;
+        atlas->pages = (TextureAtlasPage*) realloc(atlas->pages, sizeof(TextureAtlasPage) * atlas->page_capacity);
+    }
+
+    TextureAtlasPage *page = atlas->pages + atlas->page_num;
+    ++atlas->page_num;
+
+    TextureAtlasPage_initSkyline(page, atlas->page_width);
+
+    Texture *texture = (Texture*) malloc(sizeof(Texture));
+    {
+        texture->width = atlas->page_width;
+        texture->height = atlas->page_height;
+        texture->upload_completed = true;
+        texture->vram_bytes = atlas->page_width * atlas->page_height * RawPixelImage_getPixelBytes(atlas->pixel_format);
+    }
+
+    {
+        // 領域確保
+        glGenTextures(1, &texture->id);
+        assert(texture->id > 0);
+        assert(glGetError() == GL_NO_ERROR);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+
+    {
+        // ピクセルを転送せずにVRAMだけを確保する
+        const GLenum format = RawPixelImage_getGLFormat(atlas->pixel_format);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, atlas->page_width, atlas->page_height, 0, format, RawPixelImage_getGLType(atlas->pixel_format), NULL);
+        assert(glGetError() == GL_NO_ERROR);
+    }
+
+    {
+        // wrapの初期設定
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        assert(glGetError() == GL_NO_ERROR);
+    }
+
+    {
+        // filterの初期設定
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        assert(glGetError() == GL_NO_ERROR);
+    }
+
+// unbindする
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    page->texture = texture;
+    __logf("atlas page(%d) %d x %d", atlas->page_num - 1, atlas->page_width, atlas->page_height);
+    return page;
+}
+
+/**
+ * 画像をアトラスへ格納する。
+ */
+bool TextureAtlas_insert(TextureAtlas *atlas, const RawPixelImage *image, TextureAtlasRegion *result) {
+    assert(image->format == atlas->pixel_format);
+
+    const int padding = atlas->padding;
+    const int padded_width = image->width + padding * 2;
+    const int padded_height = image->height + padding * 2;
+
+    if (padded_width > atlas->page_width || padded_height > atlas->page_height) {
+        __logf("atlas image too large(%d x %d)", image->width, image->height);
+        return false;
+    }
+
+    // 既存のページから順に空きを探す
+    int page_index = 0;
+    int x = 0;
+    int y = 0;
+    for (page_index = 0; page_index < atlas->page_num; ++page_index) {
+        if (TextureAtlasPage_allocRect(atlas->pages + page_index, atlas->page_width, atlas->page_height, padded_width, padded_height, &x, &y)) {
+            break;
+        }
+    }
+
+    if (page_index == atlas->page_num) {
+        TextureAtlasPage *added = TextureAtlas_addPage(atlas);
+        if (!TextureAtlasPage_allocRect(added, atlas->page_width, atlas->page_height, padded_width, padded_height, &x, &y)) {
+            // 何も格納していないページは残さない
+            Texture_free(added->texture);
+            free(added->skyline);
+            --atlas->page_num;
+            return false;
+        }
+    }
+
+    TextureAtlasPage *page = atlas->pages + page_index;
+
+    {
+        // 画像の端を引き伸ばして余白を埋める
+        const int pixel_bytes = RawPixelImage_getPixelBytes(atlas->pixel_format);
+        const uint8_t *src = (const uint8_t*) image->pixel_data;
+        uint8_t *padded = (uint8_t*) malloc(padded_width * padded_height * pixel_bytes);
+
+        int px = 0;
+        int py = 0;
+        for (py = 0; py < padded_height; ++py) {
+            const int sy = py < padding ? 0 : (py - padding >= image->height ? image->height - 1 : py - padding);
+            for (px = 0; px < padded_width; ++px) {
+                const int sx = px < padding ? 0 : (px - padding >= image->width ? image->width - 1 : px - padding);
+                memcpy(padded + (py * padded_width + px) * pixel_bytes, src + (sy * image->width + sx) * pixel_bytes, pixel_bytes);
+            }
+        }
+
+        GLint unpack_alignment = 4;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        glBindTexture(GL_TEXTURE_2D, page->texture->id);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, padded_width, padded_height, RawPixelImage_getGLFormat(atlas->pixel_format), RawPixelImage_getGLType(atlas->pixel_format), padded);
+        assert(glGetError() == GL_NO_ERROR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+        free(padded);
+    }
+
+    result->texture = page->texture;
+    result->page = page_index;
+    result->x = x + padding;
+    result->y = y + padding;
+    result->width = image->width;
+    result->height = image->height;
+    return true;
+}
+
+/**
+ * 格納した画像を描画するためのUV変換行列を作成する。
+ */
+mat4 TextureAtlasRegion_createUvMatrix(const TextureAtlasRegion *region) {
+    return Sprite_createUvMatrix(region->texture->width, region->texture->height, region->x, region->y, region->width, region->height);
+}
+
+/**
+ * アトラスと全ページのテクスチャを解放する。
+ */
+void TextureAtlas_free(TextureAtlas *atlas) {
+    if (!atlas) {
+        return;
+    }
+
+    int i = 0;
+    for (i = 0; i < atlas->page_num; ++i) {
+        Texture_free(atlas->pages[i].texture);
+        free(atlas->pages[i].skyline);
+    }
+    free(atlas->pages);
+    free(atlas);
+}
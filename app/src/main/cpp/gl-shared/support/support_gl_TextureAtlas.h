@@ -0,0 +1,234 @@
+/*
+ * support_gl_TextureAtlas.h
+ *
+ *  Created on: 2026/10/19
+ */
+
+#ifndef SUPPORT_GL_TEXTUREATLAS_H_
+#define SUPPORT_GL_TEXTUREATLAS_H_
+
+#include    "support.h"
+
+struct Texture;
+struct RawPixelImage;
+
+/**
+ * アトラスへ格納した画像の位置
+ * x, y, width, heightはSprite_createUvMatrix()へそのまま渡せる。
+ */
+typedef struct TextureAtlasRegion {
+    /**
+     * 格納先のテクスチャ
+     */
+    struct Texture *texture;
+
+    /**
+     * 格納先のページ番号
+     * 同じページの画像は1回のバインドでまとめて描画できる。
+     */
+    int page;
+
+    /**
+     * テクスチャ内のX座標
+     */
+    int x;
+
+    /**
+     * テクスチャ内のY座標
+     */
+    int y;
+
+    /**
+     * 画像幅
+     */
+    int width;
+
+    /**
+     * 画像高さ
+     */
+    int height;
+} TextureAtlasRegion;
+
+/**
+ * スカイラインの1区間
+ * 区間[x, x + width)は、y以上が空き領域となる。
+ */
+typedef struct TextureAtlasSkyline {
+    int x;
+    int y;
+    int width;
+} TextureAtlasSkyline;
+
+/**
+ * アトラスの1ページ
+ */
+typedef struct TextureAtlasPage {
+    /**
+     * ページのテクスチャ
+     */
+    struct Texture *texture;
+
+    /**
+     * スカイラインの区間数
+     */
+    int skyline_num;
+
+    /**
+     * スカイライン
+     * 最大でページ幅と同じ数の区間を持つ。
+     */
+    TextureAtlasSkyline *skyline;
+} TextureAtlasPage;
+
+/**
+ * 実行時に小さな画像を共有テクスチャへ詰め込む。
+ *
+ * 画像はスカイライン法(Bottom-Left)で配置し、glTexSubImage2Dで転送する。
+ * 格納先のページが埋まった場合は新たなページを作成する。
+ * 各画像の周囲にはpaddingピクセル分、画像の端のピクセルを引き伸ばして書き込むため、
+ * GL_LINEARでサンプリングしても隣の画像の色が混ざらない。
+ *
+ * ページはレベル0だけを確保する。glGenerateMipmapでmipmapを作成した場合、
+ * レベルLでは余白が1/2^Lに縮み、配置位置も2^Lに揃っていないため、
+ * 隣の画像と混ざらないのは padding >= 2^(L+1) - 1 を満たすレベルLまでとなる。
+ * (padding 2ではレベル0のみ、4ではレベル1、8ではレベル2まで)
+ * OpenGL ES 2.0ではGL_TEXTURE_MAX_LEVELで参照するレベルを制限できないため、それ以上縮小して表示しないこと。
+ */
+typedef struct TextureAtlas {
+    /**
+     * ページの幅
+     */
+    int page_width;
+
+    /**
+     * ページの高さ
+     */
+    int page_height;
+
+    /**
+     * ページのピクセルフォーマット
+     * TEXTURE_RAW_XXX
+     */
+    int pixel_format;
+
+    /**
+     * 画像の周囲に確保するピクセル数
+     */
+    int padding;
+
+    /**
+     * ページ数
+     */
+    int page_num;
+
+    /**
+     * pagesの確保数
+     */
+    int page_capacity;
+
+    /**
+     * ページ
+     */
+    TextureAtlasPage *pages;
+} TextureAtlas;
+
+/**
+ * ページのスカイラインを初期化する。
+ * GLを利用しないため、オフラインツールからも利用できる。
+ */
+extern void TextureAtlasPage_initSkyline(TextureAtlasPage *page, const int page_width);
+
+/**
+ * ページ内でwidth x heightの矩形を置く位置を探し、スカイラインを更新する。
+ * 置けない場合はfalseを返す。
+ * GLを利用しないため、オフラインツールからも利用できる。
+ */
+extern bool TextureAtlasPage_allocRect(TextureAtlasPage *page, const int page_width, const int page_height, const int width, const int height, int *result_x, int *result_y);
+
+/**
+ * アトラスを作成する。
+ * ページはTextureAtlas_insert()で必要になった時点で作成する。
+ * 作成したアトラスはTextureAtlas_free()で解放する
+ */
+extern TextureAtlas* TextureAtlas_create(const int page_width, const int page_height, const int pixel_format, const int padding);
+
+/**
+ * 画像をアトラスへ格納する。
+ * 画像のフォーマットはアトラスのpixel_formatと一致している必要がある。
+ * 格納した位置をresultへ書き込み、ページより大きな画像の場合はfalseを返す。
+ */
+extern bool TextureAtlas_insert(TextureAtlas *atlas, const struct RawPixelImage *image, TextureAtlasRegion *result);
+
+/**
+ * 格納した画像を描画するためのUV変換行列を作成する。
+ */
+extern mat4 TextureAtlasRegion_createUvMatrix(const TextureAtlasRegion *region);
+
+/**
+ * アトラスと全ページのテクスチャを解放する。
+ */
+extern void TextureAtlas_free(TextureAtlas *atlas);
+
+/**
+ * tools/texture_cookerで作成したアトラスの1画像分の情報
+ */
+typedef struct TextureAtlasTableEntry {
+    /**
+     * 画像名（入力ファイル名から拡張子を除いたもの）
+     */
+    char name[64];
+
+    /**
+     * 格納された位置
+     */
+    TextureAtlasRegion region;
+} TextureAtlasTableEntry;
+
+/**
+ * tools/texture_cookerの-aオプションで作成したアトラス
+ *
+ * <name>.atlasには1行に「画像名 ページ番号 x y 幅 高さ」が記述されている。
+ * ページ画像はマニフェストの論理名<name>_<ページ番号>として登録されているため、
+ * TextureManifest_loadTexture()で端末に合ったファイルを読み込む。
+ */
+typedef struct TextureAtlasTable {
+    /**
+     * ページ数
+     */
+    int page_num;
+
+    /**
+     * ページのテクスチャ
+     */
+    struct Texture **pages;
+
+    /**
+     * 画像数
+     */
+    int entry_num;
+
+    /**
+     * 画像ごとの位置
+     */
+    TextureAtlasTableEntry *entries;
+} TextureAtlasTable;
+
+/**
+ * assets配下の<name>.atlasと、マニフェストに登録された全ページのテクスチャを読み込む。
+ * 1ページでも読み込めない場合はNULLを返す。
+ * 読み込んだアトラスはTextureAtlasTable_free()で解放する
+ */
+extern TextureAtlasTable* TextureAtlasTable_load(GLApplication *app, TextureManifest *manifest, const char* name);
+
+/**
+ * 画像名から格納位置を取得する。
+ * 登録されていない場合はNULLを返す。
+ */
+extern const TextureAtlasRegion* TextureAtlasTable_find(const TextureAtlasTable *table, const char* name);
+
+/**
+ * アトラスと全ページのテクスチャを解放する。
+ */
+extern void TextureAtlasTable_free(TextureAtlasTable *table);
+
+#endif /* SUPPORT_GL_TEXTUREATLAS_H_ */
@@ -0,0 +1,124 @@
+/*
+ * support_gl_TextureAtlas_Skyline.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+
+/**
+ * スカイラインを初期化する。
+ */
+void TextureAtlasPage_initSkyline(TextureAtlasPage *page, const int page_width) {
+    // 初期状態は底辺全体が1区間となる
+    page->skyline = (TextureAtlasSkyline*) malloc(sizeof(TextureAtlasSkyline) * (page_width + 1));
+    page->skyline_num = 1;
+    page->skyline[0].x = 0;
+    page->skyline[0].y = 0;
+    page->skyline[0].width = page_width;
+}
+
+/**
+ * スカイラインのindex番目の区間から幅widthの画像を置いた場合のY座標を取得する。
+ * 置けない場合は-1を返す。
+ */
+static int TextureAtlasPage_fitSkyline(const TextureAtlasPage *page, const int page_width, const int page_height, const int index, const int width, const int height) {
+    const TextureAtlasSkyline *skyline = page->skyline;
+    if (skyline[index].x + width > page_width) {
+        return -1;
+    }
+
+    int y = skyline[index].y;
+    int remain = width;
+    int i = index;
+    while (remain > 0) {
+        if (skyline[i].y > y) {
+            y = skyline[i].y;
+        }
+        if (y + height > page_height) {
+            return -1;
+        }
+        remain -= skyline[i].width;
+        ++i;
+    }
+    return y;
+}
+
+/**
+ * スカイラインのindex番目に区間を追加し、隠れた区間を取り除く。
+ */
+static void TextureAtlasPage_addSkyline(TextureAtlasPage *page, const int index, const int x, const int y, const int width) {
+    TextureAtlasSkyline *skyline = page->skyline;
+
+    // 区間を挿入する
+    memmove(skyline + index + 1, skyline + index, sizeof(TextureAtlasSkyline) * (page->skyline_num - index));
+    skyline[index].x = x;
+    skyline[index].y = y;
+    skyline[index].width = width;
+    ++page->skyline_num;
+
+    // 新しい区間に覆われた部分を削る
+    int i = 0;
+    for (i = index + 1; i < page->skyline_num; ++i) {
+        const int prev_right = skyline[i - 1].x + skyline[i - 1].width;
+        if (skyline[i].x >= prev_right) {
+            break;
+        }
+
+        const int shrink = prev_right - skyline[i].x;
+        skyline[i].x += shrink;
+        skyline[i].width -= shrink;
+        if (skyline[i].width > 0) {
+            break;
+        }
+
+        memmove(skyline + i, skyline + i + 1, sizeof(TextureAtlasSkyline) * (page->skyline_num - i - 1));
+        --page->skyline_num;
+        --i;
+    }
+
+    // 同じ高さの区間を結合する
+    for (i = 0; i < page->skyline_num - 1; ++i) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            memmove(skyline + i + 1, skyline + i + 2, sizeof(TextureAtlasSkyline) * (page->skyline_num - i - 2));
+            --page->skyline_num;
+            --i;
+        }
+    }
+}
+
+/**
+ * ページ内で画像を置く位置を探し、スカイラインを更新する。
+ * 置けない場合はfalseを返す。
+ */
+bool TextureAtlasPage_allocRect(TextureAtlasPage *page, const int page_width, const int page_height, const int width, const int height, int *result_x, int *result_y) {
+    int best_index = -1;
+    int best_bottom = 0;
+    int best_width = 0;
+
+    // 下端が最も低くなる位置を選ぶ
+    int i = 0;
+    for (i = 0; i < page->skyline_num; ++i) {
+        const int y = TextureAtlasPage_fitSkyline(page, page_width, page_height, i, width, height);
+        if (y < 0) {
+            continue;
+        }
+
+        const int bottom = y + height;
+        if (best_index < 0 || bottom < best_bottom || (bottom == best_bottom && page->skyline[i].width < best_width)) {
+            best_index = i;
+            best_bottom = bottom;
+            best_width = page->skyline[i].width;
+            (*result_x) = page->skyline[i].x;
+            (*result_y) = y;
+        }
+    }
+
+    if (best_index < 0) {
+        return false;
+    }
+
+    TextureAtlasPage_addSkyline(page, best_index, *result_x, best_bottom, width);
+    return true;
+}
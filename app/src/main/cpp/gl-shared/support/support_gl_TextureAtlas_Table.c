@@ -0,0 +1,117 @@
+/*
+ * support_gl_TextureAtlas_Table.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+
+/**
+ * <name>.atlasと全ページのテクスチャを読み込む。
+ */
+TextureAtlasTable* TextureAtlasTable_load(GLApplication *app, TextureManifest *manifest, const char* name) {
+    char path[128];
+    snprintf(path, sizeof(path), "%s.atlas", name);
+
+    RawData *raw = RawData_loadFile(app, path);
+    if (!raw) {
+        return NULL;
+    }
+
+    // テキストとして扱うため終端文字を付与する
+    const int length = RawData_getLength(raw);
+    char *text = (char*) malloc(length + 1);
+    RawData_readBytes(raw, text, length);
+    text[length] = '\0';
+    RawData_freeFile(app, raw);
+
+    TextureAtlasTable *result = (TextureAtlasTable*) calloc(1, sizeof(TextureAtlasTable));
+    {
+        // 最大エントリ数は行数を超えない
+        int lines = 1;
+        const char *p = text;
+        while (*p) {
+            if (*p == '\n') {
+                ++lines;
+            }
+            ++p;
+        }
+        result->entries = (TextureAtlasTableEntry*) calloc(lines, sizeof(TextureAtlasTableEntry));
+    }
+
+    {
+        char *line = strtok(text, "\r\n");
+        while (line) {
+            TextureAtlasTableEntry *entry = result->entries + result->entry_num;
+            TextureAtlasRegion *region = &entry->region;
+
+            if (line[0] != '#' && sscanf(line, "%63s %d %d %d %d %d", entry->name, &region->page, &region->x, &region->y, &region->width, &region->height) == 6) {
+                if (region->page >= 0 && region->width > 0 && region->height > 0) {
+                    if (region->page >= result->page_num) {
+                        result->page_num = region->page + 1;
+                    }
+                    ++result->entry_num;
+                } else {
+                    __logf("atlas invalid region(%s) in %s", entry->name, path);
+                }
+            }
+            line = strtok(NULL, "\r\n");
+        }
+    }
+    free(text);
+
+    result->pages = (Texture**) calloc(result->page_num > 0 ? result->page_num : 1, sizeof(Texture*));
+    {
+        int i = 0;
+        for (i = 0; i < result->page_num; ++i) {
+            char page_name[128];
+            snprintf(page_name, sizeof(page_name), "%s_%d", name, i);
+            result->pages[i] = TextureManifest_loadTexture(app, manifest, page_name);
+            if (!result->pages[i]) {
+                __logf("atlas page load error(%s)", page_name);
+                TextureAtlasTable_free(result);
+                return NULL;
+            }
+        }
+
+        for (i = 0; i < result->entry_num; ++i) {
+            TextureAtlasRegion *region = &result->entries[i].region;
+            region->texture = result->pages[region->page];
+        }
+    }
+
+    __logf("atlas(%s) pages(%d) images(%d)", name, result->page_num, result->entry_num);
+    return result;
+}
+
+/**
+ * 画像名から格納位置を取得する。
+ */
+const TextureAtlasRegion* TextureAtlasTable_find(const TextureAtlasTable *table, const char* name) {
+    int i = 0;
+    for (i = 0; i < table->entry_num; ++i) {
+        if (strcmp(table->entries[i].name, name) == 0) {
+            return &table->entries[i].region;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * アトラスと全ページのテクスチャを解放する。
+ */
+void TextureAtlasTable_free(TextureAtlasTable *table) {
+    if (!table) {
+        return;
+    }
+
+    int i = 0;
+    for (i = 0; i < table->page_num; ++i) {
+        if (table->pages[i]) {
+            Texture_free(table->pages[i]);
+        }
+    }
+    free(table->pages);
+    free(table->entries);
+    free(table);
+}
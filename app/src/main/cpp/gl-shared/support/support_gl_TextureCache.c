@@ -0,0 +1,300 @@
+/*
+ * support_gl_TextureCache.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    <sys/mman.h>
+#include    <sys/stat.h>
+#include    <sys/time.h>
+#include    <dirent.h>
+#include    <fcntl.h>
+#include    <unistd.h>
+#include    "support.h"
+
+/**
+ * キャッシュファイルのヘッダ
+ */
+typedef struct TextureCacheHeader {
+    char magic[4];
+    int32_t width;
+    int32_t height;
+    int32_t pixel_format;
+    uint64_t key;
+    int32_t pixel_bytes;
+    int32_t reserved;
+} TextureCacheHeader;
+
+/**
+ * キャッシュを作成する。
+ */
+TextureCache* TextureCache_create(const char* directory) {
+    if (!directory) {
+        return NULL;
+    }
+
+    TextureCache *result = (TextureCache*) calloc(1, sizeof(TextureCache));
+    snprintf(result->directory, sizeof(result->directory), "%s", directory);
+    result->max_bytes = TEXTURE_CACHE_DEFAULT_MAX_BYTES;
+    return result;
+}
+
+/**
+ * 64bit値を混ぜ合わせる
+ */
+static uint64_t TextureCache_mix(uint64_t hash, const uint64_t value) {
+    hash ^= value;
+    hash *= 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+/**
+ * 元ファイルの内容と変換設定からキーを作成する。
+ */
+uint64_t TextureCache_createKey(const void *data, const int data_bytes, const int pixel_format, const TextureLoadOption *option) {
+    assert(sizeof(TextureCacheHeader) == TEXTURE_CACHE_HEADER_BYTES);
+
+    const uint8_t *p = (const uint8_t*) data;
+    uint64_t hash = 0xCBF29CE484222325ULL ^ (uint64_t) data_bytes;
+
+    // 8byte単位で混ぜ合わせる
+    int offset = 0;
+    for (offset = 0; offset + 8 <= data_bytes; offset += 8) {
+        uint64_t word = 0;
+        memcpy(&word, p + offset, 8);
+        hash = TextureCache_mix(hash, word);
+    }
+    {
+        // 端数
+        uint64_t word = 0;
+        memcpy(&word, p + offset, data_bytes - offset);
+        hash = TextureCache_mix(hash, word);
+    }
+
+    // 変換設定が異なれば別のキャッシュとする
+    hash = TextureCache_mix(hash, (uint64_t) pixel_format);
+    if (option) {
+        uint32_t scale_bits = 0;
+        memcpy(&scale_bits, &option->scale, sizeof(scale_bits));
+        hash = TextureCache_mix(hash, ((uint64_t) option->npot << 40) | ((uint64_t) option->filter << 32) | scale_bits);
+    }
+    return hash;
+}
+
+/**
+ * キーからキャッシュファイルのパスを作成する。
+ */
+static void TextureCache_getPath(TextureCache *cache, const uint64_t key, char *result, const int result_size) {
+    snprintf(result, result_size, "%s/%08x%08x.txc", cache->directory, (unsigned int) (key >> 32), (unsigned int) key);
+}
+
+/**
+ * ヘッダの内容がファイルと矛盾していないかを検証する。
+ * ピクセル数とフォーマットから求めたサイズがpixel_bytesと一致しない場合、
+ * 画像として参照するとマップした領域外を読むため不正とする。
+ */
+static bool TextureCache_isValidHeader(const TextureCacheHeader *header, const uint64_t key, const int64_t file_bytes) {
+    if (memcmp(header->magic, TEXTURE_CACHE_MAGIC, 4) != 0 || header->key != key) {
+        return false;
+    }
+    if (header->pixel_format < TEXTURE_RAW_RGBA8 || header->pixel_format > TEXTURE_RAW_RGB565) {
+        return false;
+    }
+    if (header->width <= 0 || header->height <= 0 || header->pixel_bytes <= 0) {
+        return false;
+    }
+    if ((int64_t) header->width * header->height * RawPixelImage_getPixelBytes(header->pixel_format) != header->pixel_bytes) {
+        return false;
+    }
+    return (TEXTURE_CACHE_HEADER_BYTES + (int64_t) header->pixel_bytes) == file_bytes;
+}
+
+/**
+ * キャッシュを検索し、見つかった場合はメモリマップして返す。
+ */
+TextureCacheImage* TextureCache_find(TextureCache *cache, const uint64_t key) {
+    char path[320];
+    TextureCache_getPath(cache, key, path, sizeof(path));
+
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        ++cache->miss_count;
+        return NULL;
+    }
+
+    struct stat st;
+    void *mapping = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= TEXTURE_CACHE_HEADER_BYTES) {
+        mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // マップ後はファイルを閉じてもよい
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        ++cache->miss_count;
+        return NULL;
+    }
+
+    const TextureCacheHeader *header = (const TextureCacheHeader*) mapping;
+    if (!TextureCache_isValidHeader(header, key, (int64_t) st.st_size)) {
+        // 壊れたファイルは無視し、次回の保存で上書きする
+        __logf("texture cache broken(%s)", path);
+        munmap(mapping, st.st_size);
+        ++cache->miss_count;
+        return NULL;
+    }
+
+    TextureCacheImage *result = (TextureCacheImage*) malloc(sizeof(TextureCacheImage));
+    result->image = (RawPixelImage*) malloc(sizeof(RawPixelImage));
+    result->image->width = header->width;
+    result->image->height = header->height;
+    result->image->format = header->pixel_format;
+    result->image->pixel_data = ((uint8_t*) mapping) + TEXTURE_CACHE_HEADER_BYTES;
+    result->mapping = mapping;
+    result->mapping_bytes = (int) st.st_size;
+
+    // 最後に利用した時刻として更新し、削除の対象から遠ざける
+    utimes(path, NULL);
+
+    ++cache->hit_count;
+    return result;
+}
+
+/**
+ * 削除候補のキャッシュファイル
+ */
+typedef struct TextureCacheFile {
+    char name[32];
+    time_t modified;
+    int64_t bytes;
+} TextureCacheFile;
+
+/**
+ * 古い順に並べる
+ */
+static int TextureCache_compareFile(const void *a, const void *b) {
+    const time_t ta = ((const TextureCacheFile*) a)->modified;
+    const time_t tb = ((const TextureCacheFile*) b)->modified;
+    return (ta < tb) ? -1 : ((ta > tb) ? 1 : 0);
+}
+
+/**
+ * キャッシュファイルの合計がmax_bytes以下になるまで、古いものから削除する。
+ * マップ中のファイルを削除しても、munmap()までは内容が保持される。
+ */
+static void TextureCache_trim(TextureCache *cache) {
+    DIR *dir = opendir(cache->directory);
+    if (!dir) {
+        return;
+    }
+
+    int file_num = 0;
+    int file_capacity = 16;
+    TextureCacheFile *files = (TextureCacheFile*) malloc(sizeof(TextureCacheFile) * file_capacity);
+    int64_t total_bytes = 0;
+
+    struct dirent *ent = NULL;
+    while ((ent = readdir(dir)) != NULL) {
+        // キャッシュファイル(16桁のキー + ".txc")以外は対象としない
+        const int length = strlen(ent->d_name);
+        if (length != 20 || strcmp(ent->d_name + 16, ".txc") != 0) {
+            continue;
+        }
+
+        char path[320];
+        struct stat st;
+        snprintf(path, sizeof(path), "%s/%s", cache->directory, ent->d_name);
+        if (stat(path, &st) != 0) {
+            continue;
+        }
+
+        if (file_num == file_capacity) {
+            file_capacity *= 2;
+            files = (TextureCacheFile*) realloc(files, sizeof(TextureCacheFile) * file_capacity);
+        }
+        TextureCacheFile *file = files + file_num;
+        strcpy(file->name, ent->d_name);
+        file->modified = st.st_mtime;
+        file->bytes = (int64_t) st.st_size;
+        total_bytes += file->bytes;
+        ++file_num;
+    }
+    closedir(dir);
+
+    if (total_bytes > cache->max_bytes) {
+        qsort(files, file_num, sizeof(TextureCacheFile), TextureCache_compareFile);
+
+        int i = 0;
+        for (i = 0; i < file_num && total_bytes > cache->max_bytes; ++i) {
+            char path[320];
+            snprintf(path, sizeof(path), "%s/%s", cache->directory, files[i].name);
+            if (remove(path) == 0) {
+                total_bytes -= files[i].bytes;
+                __logf("texture cache evict(%s)", files[i].name);
+            }
+        }
+    }
+    free(files);
+}
+
+/**
+ * 変換済みの画像をキャッシュへ保存する。
+ */
+bool TextureCache_store(TextureCache *cache, const uint64_t key, const RawPixelImage *image) {
+    char path[320];
+    char temp_path[330];
+    TextureCache_getPath(cache, key, path, sizeof(path));
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+
+    FILE *fp = fopen(temp_path, "wb");
+    if (!fp) {
+        __logf("texture cache open error(%s)", temp_path);
+        return false;
+    }
+
+    TextureCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TEXTURE_CACHE_MAGIC, 4);
+    header.width = image->width;
+    header.height = image->height;
+    header.pixel_format = image->format;
+    header.key = key;
+    header.pixel_bytes = image->width * image->height * RawPixelImage_getPixelBytes(image->format);
+
+    fwrite(&header, sizeof(header), 1, fp);
+    fwrite(image->pixel_data, 1, header.pixel_bytes, fp);
+
+    const bool written = (ferror(fp) == 0);
+    fclose(fp);
+
+    if (!written || rename(temp_path, path) != 0) {
+        __logf("texture cache write error(%s)", path);
+        remove(temp_path);
+        return false;
+    }
+
+    TextureCache_trim(cache);
+    return true;
+}
+
+/**
+ * メモリマップしたキャッシュ画像を解放する。
+ */
+void TextureCache_release(TextureCacheImage *image) {
+    if (image) {
+        munmap(image->mapping, image->mapping_bytes);
+        free(image->image);
+        free(image);
+    }
+}
+
+/**
+ * キャッシュを解放する。
+ */
+void TextureCache_free(TextureCache *cache) {
+    if (cache) {
+        __logf("texture cache hit(%d) miss(%d)", cache->hit_count, cache->miss_count);
+        free(cache);
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * support_gl_TextureCache.h
+ *
+ *  Created on: 2026/10/19
+ */
+
+#ifndef SUPPORT_GL_TEXTURECACHE_H_
+#define SUPPORT_GL_TEXTURECACHE_H_
+
+#include    "support.h"
+
+struct RawPixelImage;
+struct TextureLoadOption;
+
+/**
+ * キャッシュファイルのマジックナンバー
+ */
+#define TEXTURE_CACHE_MAGIC           "TXC1"
+
+/**
+ * キャッシュファイルのヘッダサイズ(byte)
+ * ピクセルの先頭を8byte境界に揃えるため、ヘッダは8の倍数とする。
+ */
+#define TEXTURE_CACHE_HEADER_BYTES    32
+
+/**
+ * キャッシュディレクトリの既定の上限サイズ(byte)
+ */
+#define TEXTURE_CACHE_DEFAULT_MAX_BYTES    (64 * 1024 * 1024)
+
+/**
+ * デコード・変換済みの画像をディスクへ保存し、次回起動時のデコードを省略する。
+ *
+ * キャッシュは元ファイルの内容と変換設定のハッシュをファイル名とし、
+ * 元画像が変更された場合は別のファイルとして扱われる。
+ * 保存後にディレクトリ内のキャッシュファイルの合計がmax_bytesを超えた場合、
+ * 最後に利用された時刻(mtime)が古いものから削除する。
+ *
+ * キャッシュファイルの構造(数値は全てホストのバイトオーダー)
+ * magic "TXC1"
+ * int32 width / height / pixel_format(TEXTURE_RAW_XXX)
+ * uint64 key
+ * int32 pixel_bytes
+ * int32 reserved
+ * 以降、ヘッダの直後からピクセル配列を格納する。
+ */
+typedef struct TextureCache {
+    /**
+     * キャッシュを保存するディレクトリ
+     */
+    char directory[256];
+
+    /**
+     * キャッシュファイルの合計サイズの上限(byte)
+     * 作成時はTEXTURE_CACHE_DEFAULT_MAX_BYTESが設定される。
+     */
+    int64_t max_bytes;
+
+    /**
+     * キャッシュを利用できた回数
+     */
+    int hit_count;
+
+    /**
+     * キャッシュが存在しなかった回数
+     */
+    int miss_count;
+} TextureCache;
+
+/**
+ * メモリマップしたキャッシュ画像
+ */
+typedef struct TextureCacheImage {
+    /**
+     * 画像
+     * pixel_dataはマップした領域を指すため、RawPixelImage_free()で解放してはならない。
+     */
+    struct RawPixelImage *image;
+
+    /**
+     * マップした領域
+     */
+    void *mapping;
+
+    /**
+     * マップした領域の長さ
+     */
+    int mapping_bytes;
+} TextureCacheImage;
+
+/**
+ * キャッシュを作成する。
+ * directoryにはGLApplication_getCacheDirectory()の戻り値等を指定する。
+ * directoryがNULLの場合はNULLを返す。
+ * 作成したキャッシュはTextureCache_free()で解放する
+ */
+extern TextureCache* TextureCache_create(const char* directory);
+
+/**
+ * 元ファイルの内容と変換設定からキーを作成する。
+ */
+extern uint64_t TextureCache_createKey(const void *data, const int data_bytes, const int pixel_format, const struct TextureLoadOption *option);
+
+/**
+ * キャッシュを検索し、見つかった場合はメモリマップして返す。
+ * 見つからない場合はNULLを返す。
+ * 取得した画像はTextureCache_release()で解放する
+ */
+extern TextureCacheImage* TextureCache_find(TextureCache *cache, const uint64_t key);
+
+/**
+ * 変換済みの画像をキャッシュへ保存する。
+ * 書き込み途中のファイルが読まれないよう、一時ファイルへ書き込んでからリネームする。
+ * 保存後、合計サイズがmax_bytesを超えていれば古いキャッシュを削除する。
+ */
+extern bool TextureCache_store(TextureCache *cache, const uint64_t key, const struct RawPixelImage *image);
+
+/**
+ * メモリマップしたキャッシュ画像を解放する。
+ */
+extern void TextureCache_release(TextureCacheImage *image);
+
+/**
+ * キャッシュを解放する。
+ * キャッシュファイルは削除しない。
+ */
+extern void TextureCache_free(TextureCache *cache);
+
+#endif /* SUPPORT_GL_TEXTURECACHE_H_ */
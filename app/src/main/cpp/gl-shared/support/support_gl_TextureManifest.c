@@ -0,0 +1,269 @@
+/*
+ * support_gl_TextureManifest.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+
+/**
+ * マニフェストに記述できるフォーマット
+ */
+typedef struct TextureManifestFormat {
+    /**
+     * マニフェスト上の表記
+     */
+    const char *token;
+
+    /**
+     * Texture_load()へ渡すフォーマット
+     */
+    int pixel_format;
+
+    /**
+     * 1pixelごとのビット数
+     */
+    int bits_per_pixel;
+
+    /**
+     * サンプリングに必要なExtension
+     * NULLの場合は常に対応している。
+     */
+    const char *extensions[2];
+} TextureManifestFormat;
+
+static const TextureManifestFormat g_manifest_formats[] = {
+//
+        { "pvrtc2", TEXTURE_COMPRESS_PVRTC, 2, { "GL_IMG_texture_compression_pvrtc", NULL } },
+        //
+        { "pvrtc4", TEXTURE_COMPRESS_PVRTC, 4, { "GL_IMG_texture_compression_pvrtc", NULL } },
+        //
+        { "etc1", TEXTURE_COMPRESS_ETC1, 4, { "GL_OES_compressed_ETC1_RGB8_texture", NULL } },
+        //
+        { "etc1a", TEXTURE_COMPRESS_ETC1A, 8, { "GL_OES_compressed_ETC1_RGB8_texture", NULL } },
+        //
+        { "ktx_etc1", TEXTURE_COMPRESS_KTX, 4, { "GL_OES_compressed_ETC1_RGB8_texture", NULL } },
+        //
+        { "ktx_atc", TEXTURE_COMPRESS_KTX, 4, { "GL_AMD_compressed_ATC_texture", "GL_ATI_texture_compression_atitc" } },
+        //
+        { "ktx_atca", TEXTURE_COMPRESS_KTX, 8, { "GL_AMD_compressed_ATC_texture", "GL_ATI_texture_compression_atitc" } },
+        //
+        { "ktx_dxt1", TEXTURE_COMPRESS_KTX, 4, { "GL_EXT_texture_compression_dxt1", "GL_EXT_texture_compression_s3tc" } },
+        //
+        { "ktx_dxt5", TEXTURE_COMPRESS_KTX, 8, { "GL_EXT_texture_compression_s3tc", NULL } },
+        //
+        { "rgb565", TEXTURE_RAW_RGB565, 16, { NULL, NULL } },
+        //
+        { "rgba5551", TEXTURE_RAW_RGBA5551, 16, { NULL, NULL } },
+        //
+        { "rgb8", TEXTURE_RAW_RGB8, 24, { NULL, NULL } },
+        //
+        { "rgba8", TEXTURE_RAW_RGBA8, 32, { NULL, NULL } },
+        // 終端
+        { NULL, 0, 0, { NULL, NULL } } };
+
+/**
+ * フォーマット表記からフォーマット情報を取得する
+ */
+static const TextureManifestFormat* TextureManifest_findFormat(const char *token) {
+    const TextureManifestFormat *format = g_manifest_formats;
+    while (format->token) {
+        if (strcmp(format->token, token) == 0) {
+            return format;
+        }
+        ++format;
+    }
+    return NULL;
+}
+
+/**
+ * マニフェストを読み込む。
+ */
+TextureManifest* TextureManifest_load(GLApplication *app, const char* file_name) {
+    RawData *raw = RawData_loadFile(app, file_name);
+    if (!raw) {
+        return NULL;
+    }
+
+    // テキストとして扱うため終端文字を付与する
+    const int length = RawData_getLength(raw);
+    char *text = (char*) malloc(length + 1);
+    RawData_readBytes(raw, text, length);
+    text[length] = '\0';
+    RawData_freeFile(app, raw);
+
+    // 対応可否はフォーマットごとに一度だけ判定する
+    bool format_supported[sizeof(g_manifest_formats) / sizeof(TextureManifestFormat)] = { false };
+    {
+        int i = 0;
+        for (i = 0; g_manifest_formats[i].token; ++i) {
+            const TextureManifestFormat *format = g_manifest_formats + i;
+            format_supported[i] = (format->extensions[0] == NULL);
+
+            int k = 0;
+            for (k = 0; k < 2; ++k) {
+                if (format->extensions[k] && ES20_hasExtension(format->extensions[k])) {
+                    format_supported[i] = true;
+                }
+            }
+        }
+    }
+
+    TextureManifest *result = (TextureManifest*) calloc(1, sizeof(TextureManifest));
+    {
+        // 最大エントリ数は行数を超えない
+        int lines = 1;
+        const char *p = text;
+        while (*p) {
+            if (*p == '\n') {
+                ++lines;
+            }
+            ++p;
+        }
+        result->entries = (TextureManifestEntry*) calloc(lines, sizeof(TextureManifestEntry));
+    }
+
+    {
+        char *line = strtok(text, "\r\n");
+        while (line) {
+            char name[64] = { 0 };
+            char token[32] = { 0 };
+            char entry_file[128] = { 0 };
+
+            if (line[0] != '#' && sscanf(line, "%63s %31s %127s", name, token, entry_file) == 3) {
+                const TextureManifestFormat *format = TextureManifest_findFormat(token);
+                if (format) {
+                    TextureManifestEntry *entry = result->entries + result->entry_num;
+                    strcpy(entry->name, name);
+                    strcpy(entry->file_name, entry_file);
+                    entry->pixel_format = format->pixel_format;
+                    entry->bits_per_pixel = format->bits_per_pixel;
+                    entry->supported = format_supported[format - g_manifest_formats];
+                    ++result->entry_num;
+                } else {
+                    __logf("manifest unknown format(%s) in %s", token, file_name);
+                }
+            }
+            line = strtok(NULL, "\r\n");
+        }
+    }
+
+    free(text);
+    __logf("manifest(%s) entries(%d)", file_name, result->entry_num);
+    return result;
+}
+
+/**
+ * 論理テクスチャ名から、GPUがサンプリング可能で最もビット数の小さいファイルを選択する。
+ */
+const TextureManifestEntry* TextureManifest_resolve(TextureManifest *manifest, const char* name) {
+    const TextureManifestEntry *result = NULL;
+
+    int i = 0;
+    for (i = 0; i < manifest->entry_num; ++i) {
+        const TextureManifestEntry *entry = manifest->entries + i;
+        if (!entry->supported || strcmp(entry->name, name) != 0) {
+            continue;
+        }
+        // アルファを別領域に持つ形式は、描画側が対応している場合のみ選ぶ
+        if (entry->pixel_format == TEXTURE_COMPRESS_ETC1A && !manifest->split_alpha_enabled) {
+            continue;
+        }
+
+        if (!result || entry->bits_per_pixel < result->bits_per_pixel) {
+            result = entry;
+        }
+    }
+    return result;
+}
+
+/**
+ * 論理テクスチャ名から最適なファイルを選択し、テクスチャとして読み込む。
+ */
+Texture* TextureManifest_loadTexture(GLApplication *app, TextureManifest *manifest, const char* name) {
+    const TextureManifestEntry *entry = TextureManifest_resolve(manifest, name);
+    if (!entry) {
+        __logf("manifest texture not found(%s)", name);
+        return NULL;
+    }
+
+    __logf("manifest texture(%s) -> %s", name, entry->file_name);
+    return Texture_load(app, entry->file_name, entry->pixel_format);
+}
+
+/**
+ * チャンネルパックを読み込む。
+ */
+Texture* TextureManifest_loadChannelPack(GLApplication *app, TextureManifest *manifest, const char* name, const char* mask_names[], const int mask_num, TextureChannel *result) {
+    assert(mask_num > 0 && mask_num <= TEXTURE_CHANNEL_PACK_MAX);
+
+    char path[128];
+    snprintf(path, sizeof(path), "%s.channels", name);
+
+    RawData *raw = RawData_loadFile(app, path);
+    if (!raw) {
+        return NULL;
+    }
+
+    // テキストとして扱うため終端文字を付与する
+    const int length = RawData_getLength(raw);
+    char *text = (char*) malloc(length + 1);
+    RawData_readBytes(raw, text, length);
+    text[length] = '\0';
+    RawData_freeFile(app, raw);
+
+    int found = 0;
+    int i = 0;
+    for (i = 0; i < mask_num; ++i) {
+        result[i].texture = NULL;
+        result[i].channel = -1;
+    }
+
+    {
+        // 1行に「マスク名 チャンネル(r/g/b/a)」が記述されている
+        const char *CHANNEL_NAMES = "rgba";
+        char *line = strtok(text, "\r\n");
+        while (line) {
+            char mask_name[64] = { 0 };
+            char channel[2] = { 0 };
+
+            if (line[0] != '#' && sscanf(line, "%63s %1s", mask_name, channel) == 2 && strchr(CHANNEL_NAMES, channel[0])) {
+                for (i = 0; i < mask_num; ++i) {
+                    if (result[i].channel < 0 && strcmp(mask_names[i], mask_name) == 0) {
+                        result[i].channel = TEXTURE_CHANNEL_R + (int) (strchr(CHANNEL_NAMES, channel[0]) - CHANNEL_NAMES);
+                        ++found;
+                    }
+                }
+            }
+            line = strtok(NULL, "\r\n");
+        }
+    }
+    free(text);
+
+    if (found != mask_num) {
+        for (i = 0; i < mask_num; ++i) {
+            if (result[i].channel < 0) {
+                __logf("channel pack mask not found(%s) in %s", mask_names[i], path);
+            }
+        }
+        return NULL;
+    }
+
+    Texture *texture = TextureManifest_loadTexture(app, manifest, name);
+    if (texture) {
+        for (i = 0; i < mask_num; ++i) {
+            result[i].texture = texture;
+        }
+    }
+    return texture;
+}
+
+/**
+ * マニフェストを解放する
+ */
+void TextureManifest_free(TextureManifest *manifest) {
+    if (manifest) {
+        free(manifest->entries);
+        free(manifest);
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * support_gl_TextureManifest.h
+ *
+ *  Created on: 2026/10/19
+ */
+
+#ifndef SUPPORT_GL_TEXTUREMANIFEST_H_
+#define SUPPORT_GL_TEXTUREMANIFEST_H_
+
+#include    "support.h"
+
+/**
+ * マニフェストに記述された1ファイル分の情報
+ */
+typedef struct TextureManifestEntry {
+    /**
+     * 論理テクスチャ名
+     */
+    char name[64];
+
+    /**
+     * assets配下のファイル名
+     */
+    char file_name[128];
+
+    /**
+     * Texture_load()へ渡すフォーマット
+     */
+    int pixel_format;
+
+    /**
+     * VRAM上の1pixelごとのビット数
+     */
+    int bits_per_pixel;
+
+    /**
+     * 実行中のGPUでサンプリング可能であればtrue
+     */
+    bool supported;
+} TextureManifestEntry;
+
+/**
+ * 論理テクスチャごとに用意されたエンコード済みファイルの一覧
+ *
+ * マニフェストはassets配下のテキストファイルで、1行に「論理名 フォーマット ファイル名」を記述する。
+ * '#'から始まる行はコメントとして扱う。
+ * フォーマットは下記のいずれか。
+ * pvrtc2 / pvrtc4 / etc1 / etc1a / ktx_etc1 / ktx_atc / ktx_atca / ktx_dxt1 / ktx_dxt5 / rgb565 / rgba5551 / rgb8 / rgba8
+ *
+ * 例：
+ * background   pvrtc4  background.pvr
+ * background   etc1    background.pkm
+ * background   rgb565  background.png
+ */
+typedef struct TextureManifest {
+    /**
+     * 登録されているファイル数
+     */
+    int entry_num;
+
+    /**
+     * 登録されているファイル
+     */
+    TextureManifestEntry *entries;
+
+    /**
+     * etc1aのエントリを自動選択の対象とする場合true
+     * ETC1Aは下半分にアルファを格納するため、描画側でSHADER_SOURCE_ETC1A_SAMPLERへ切り替える必要がある。
+     * 初期値はfalseで、etc1aのエントリは選択されない。
+     * trueにした場合、TextureManifest_resolve()の戻り値のpixel_formatで描画方法を切り替える。
+     */
+    bool split_alpha_enabled;
+} TextureManifest;
+
+/**
+ * マニフェストを読み込む。
+ * 各エントリの対応可否はES20_hasExtension()（起動時にキャッシュしたExtension一覧）から判定する。
+ * 読み込んだマニフェストはTextureManifest_free()で解放する
+ */
+extern TextureManifest* TextureManifest_load(GLApplication *app, const char* file_name);
+
+/**
+ * 論理テクスチャ名から、GPUがサンプリング可能で最もビット数の小さいファイルを選択する。
+ * 同じビット数の場合はマニフェストの記述順を優先する。
+ * etc1aのエントリはsplit_alpha_enabledがtrueの場合のみ選択する。
+ * 対応するファイルがなければNULLを返す。
+ */
+extern const TextureManifestEntry* TextureManifest_resolve(TextureManifest *manifest, const char* name);
+
+struct Texture;
+struct TextureChannel;
+
+/**
+ * 論理テクスチャ名から最適なファイルを選択し、テクスチャとして読み込む。
+ * 選択はTextureManifest_resolve()と同じで、split_alpha_enabledがfalseであればetc1aは読み込まれない。
+ * 読み込んだテクスチャはTexture_free()で解放する
+ */
+extern struct Texture* TextureManifest_loadTexture(GLApplication *app, TextureManifest *manifest, const char* name);
+
+/**
+ * tools/texture_cookerの-kオプションで作成したチャンネルパックを読み込む。
+ * テクスチャはマニフェストの論理名nameから、各マスクの格納チャンネルはassets配下の<name>.channelsから取得する。
+ * resultにはmask_names[i]のハンドルがmask_num個格納され、1つでも見つからない場合はNULLを返す。
+ * 読み込んだテクスチャはTexture_free()で解放する
+ */
+extern struct Texture* TextureManifest_loadChannelPack(GLApplication *app, TextureManifest *manifest, const char* name, const char* mask_names[], const int mask_num, struct TextureChannel *result);
+
+/**
+ * マニフェストを解放する
+ */
+extern void TextureManifest_free(TextureManifest *manifest);
+
+#endif /* SUPPORT_GL_TEXTUREMANIFEST_H_ */
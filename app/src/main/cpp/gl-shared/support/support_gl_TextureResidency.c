@@ -0,0 +1,173 @@
+/*
+ * support_gl_TextureResidency.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+
+/**
+ * 管理クラスを作成する。
+ */
+TextureResidency* TextureResidency_create(const int budget_bytes) {
+    assert(budget_bytes > 0);
+
+    TextureResidency *result = (TextureResidency*) calloc(1, sizeof(TextureResidency));
+    result->budget_bytes = budget_bytes;
+    return result;
+}
+
+/**
+ * テクスチャを登録する。
+ */
+ResidentTexture* TextureResidency_register(TextureResidency *residency, const char* file_name, const int pixel_format) {
+    assert(strlen(file_name) < sizeof(((ResidentTexture*) NULL)->file_name));
+
+    if (residency->entry_num == residency->entry_capacity) {
+        residency->entry_capacity = residency->entry_capacity ? residency->entry_capacity * 2 : 16;
+        residency->entries = (ResidentTexture**) realloc(residency->entries, sizeof(ResidentTexture*) * residency->entry_capacity);
+    }
+
+    ResidentTexture *result = (ResidentTexture*) calloc(1, sizeof(ResidentTexture));
+    strcpy(result->file_name, file_name);
+    result->pixel_format = pixel_format;
+    result->last_used_frame = -1;
+
+    residency->entries[residency->entry_num++] = result;
+    return result;
+}
+
+/**
+ * テクスチャをVRAMから解放する。
+ * 登録は解除しない。
+ */
+static void TextureResidency_evict(TextureResidency *residency, ResidentTexture *resident) {
+    if (!resident->texture) {
+        return;
+    }
+
+    residency->resident_bytes -= resident->accounted_bytes;
+    resident->accounted_bytes = 0;
+    Texture_free(resident->texture);
+    resident->texture = NULL;
+}
+
+/**
+ * 読込後に変化した推定サイズを集計へ反映する。
+ */
+static void TextureResidency_syncBytes(TextureResidency *residency) {
+    int i = 0;
+    for (i = 0; i < residency->entry_num; ++i) {
+        ResidentTexture *resident = residency->entries[i];
+        if (resident->texture && resident->texture->vram_bytes != resident->accounted_bytes) {
+            residency->resident_bytes += (resident->texture->vram_bytes - resident->accounted_bytes);
+            resident->accounted_bytes = resident->texture->vram_bytes;
+        }
+    }
+}
+
+/**
+ * 予算に収まるまで、利用されていない期間の長いテクスチャから解放する。
+ */
+static void TextureResidency_evictOverBudget(TextureResidency *residency) {
+    while (residency->resident_bytes > residency->budget_bytes) {
+        ResidentTexture *oldest = NULL;
+
+        int i = 0;
+        for (i = 0; i < residency->entry_num; ++i) {
+            ResidentTexture *resident = residency->entries[i];
+
+            // 現在のフレームで利用したテクスチャは解放しない
+            if (!resident->texture || resident->last_used_frame >= residency->frame) {
+                continue;
+            }
+            if (!oldest || resident->last_used_frame < oldest->last_used_frame) {
+                oldest = resident;
+            }
+        }
+
+        if (!oldest) {
+            // 全て現在のフレームで利用しているため、これ以上は解放できない
+            return;
+        }
+
+        __logf("texture evict(%s) %d bytes", oldest->file_name, oldest->texture->vram_bytes);
+        TextureResidency_evict(residency, oldest);
+    }
+}
+
+/**
+ * テクスチャを利用する。
+ */
+Texture* TextureResidency_use(GLApplication *app, TextureResidency *residency, ResidentTexture *resident) {
+    resident->last_used_frame = residency->frame;
+
+    if (!resident->texture) {
+        // 初回か、VRAMから追い出されていたため読み込み直す
+        resident->texture = Texture_load(app, resident->file_name, resident->pixel_format);
+        if (!resident->texture) {
+            return NULL;
+        }
+
+        resident->accounted_bytes = resident->texture->vram_bytes;
+        residency->resident_bytes += resident->accounted_bytes;
+        TextureResidency_evictOverBudget(residency);
+    }
+
+    return resident->texture;
+}
+
+/**
+ * フレームを進める。
+ */
+void TextureResidency_nextFrame(TextureResidency *residency) {
+    ++residency->frame;
+    TextureResidency_syncBytes(residency);
+    TextureResidency_evictOverBudget(residency);
+}
+
+/**
+ * 予算を変更する。
+ */
+void TextureResidency_setBudget(TextureResidency *residency, const int budget_bytes) {
+    assert(budget_bytes > 0);
+
+    residency->budget_bytes = budget_bytes;
+    TextureResidency_syncBytes(residency);
+    TextureResidency_evictOverBudget(residency);
+}
+
+/**
+ * テクスチャの登録を解除し、読み込み済みであれば解放する。
+ */
+void TextureResidency_unregister(TextureResidency *residency, ResidentTexture *resident) {
+    int i = 0;
+    for (i = 0; i < residency->entry_num; ++i) {
+        if (residency->entries[i] == resident) {
+            TextureResidency_evict(residency, resident);
+            free(resident);
+
+            // 末尾の登録で埋める
+            --residency->entry_num;
+            residency->entries[i] = residency->entries[residency->entry_num];
+            return;
+        }
+    }
+}
+
+/**
+ * 管理クラスと、登録されている全てのテクスチャを解放する。
+ */
+void TextureResidency_free(TextureResidency *residency) {
+    if (!residency) {
+        return;
+    }
+
+    int i = 0;
+    for (i = 0; i < residency->entry_num; ++i) {
+        TextureResidency_evict(residency, residency->entries[i]);
+        free(residency->entries[i]);
+    }
+    free(residency->entries);
+    free(residency);
+}
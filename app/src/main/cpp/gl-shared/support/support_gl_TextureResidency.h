@@ -0,0 +1,130 @@
+/*
+ * support_gl_TextureResidency.h
+ *
+ *  Created on: 2026/10/19
+ */
+
+#ifndef SUPPORT_GL_TEXTURERESIDENCY_H_
+#define SUPPORT_GL_TEXTURERESIDENCY_H_
+
+#include    "support.h"
+
+struct Texture;
+
+/**
+ * TextureResidencyで管理するテクスチャ
+ * VRAMから追い出されている間はtextureがNULLとなる。
+ */
+typedef struct ResidentTexture {
+    /**
+     * 読み込み元のファイル名
+     */
+    char file_name[128];
+
+    /**
+     * Texture_load()へ渡すフォーマット
+     */
+    int pixel_format;
+
+    /**
+     * 読み込み済みのテクスチャ
+     * VRAMから追い出されている場合はNULL
+     */
+    struct Texture *texture;
+
+    /**
+     * 最後に利用したフレーム
+     */
+    int last_used_frame;
+
+    /**
+     * resident_bytesへ計上しているサイズ(byte)
+     * 読込後にTexture_generateMipmap()等でvram_bytesが変わった場合、次のフレームで差分を反映する。
+     */
+    int accounted_bytes;
+} ResidentTexture;
+
+/**
+ * VRAMの予算内にテクスチャを収める。
+ *
+ * 各テクスチャの推定サイズ(Texture.vram_bytes)を集計し、予算を超えた場合は最も長く利用されていないテクスチャから解放する。
+ * 読込後にmipmapを生成する場合はTexture_generateMipmap()を利用し、vram_bytesへmipmapのサイズを含める。
+ * 解放したテクスチャは次にTextureResidency_use()で利用する際にTexture_load()で読み込み直す。
+ * 同じフレームで利用したテクスチャは描画に使われている可能性があるため解放しない。
+ */
+typedef struct TextureResidency {
+    /**
+     * VRAMの予算(byte)
+     */
+    int budget_bytes;
+
+    /**
+     * 読み込み済みテクスチャの推定サイズの合計(byte)
+     */
+    int resident_bytes;
+
+    /**
+     * 現在のフレーム
+     */
+    int frame;
+
+    /**
+     * 登録されているテクスチャ数
+     */
+    int entry_num;
+
+    /**
+     * entriesの確保数
+     */
+    int entry_capacity;
+
+    /**
+     * 登録されているテクスチャ
+     * 戻り値として返したポインタが変わらないよう、個別に確保する。
+     */
+    ResidentTexture **entries;
+} TextureResidency;
+
+/**
+ * 管理クラスを作成する。
+ * 作成した管理クラスはTextureResidency_free()で解放する
+ */
+extern TextureResidency* TextureResidency_create(const int budget_bytes);
+
+/**
+ * テクスチャを登録する。
+ * この時点ではファイルを読み込まず、初めてTextureResidency_use()した時点で読み込む。
+ */
+extern ResidentTexture* TextureResidency_register(TextureResidency *residency, const char* file_name, const int pixel_format);
+
+/**
+ * テクスチャを利用する。
+ * VRAMから追い出されていた場合は読み込み直すため、戻り値は毎フレーム取得し直す必要がある。
+ * 読み込めなかった場合はNULLを返す。
+ */
+extern struct Texture* TextureResidency_use(GLApplication *app, TextureResidency *residency, ResidentTexture *resident);
+
+/**
+ * フレームを進める。
+ * レンダリングループの最後に呼び出し、予算を超えている場合は利用されていないテクスチャを解放する。
+ * 読込後に変化したTexture.vram_bytesもここで集計し直す。
+ */
+extern void TextureResidency_nextFrame(TextureResidency *residency);
+
+/**
+ * 予算を変更する。
+ * 予算を下げた場合、このフレームで利用していないテクスチャから解放する。
+ */
+extern void TextureResidency_setBudget(TextureResidency *residency, const int budget_bytes);
+
+/**
+ * テクスチャの登録を解除し、読み込み済みであれば解放する。
+ */
+extern void TextureResidency_unregister(TextureResidency *residency, ResidentTexture *resident);
+
+/**
+ * 管理クラスと、登録されている全てのテクスチャを解放する。
+ */
+extern void TextureResidency_free(TextureResidency *residency);
+
+#endif /* SUPPORT_GL_TEXTURERESIDENCY_H_ */
@@ -0,0 +1,553 @@
+/*
+ * support_gl_TextureUploader.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+
+/**
+ * mipmap数だけ画像テーブルを確保する
+ */
+static void TextureSource_allocTables(TextureSource *source, const int mipmaps) {
+    source->mipmaps = mipmaps;
+    source->image_length_table = (int*) malloc(sizeof(int) * mipmaps);
+    source->image_table = (void**) malloc(sizeof(void*) * mipmaps);
+}
+
+/**
+ * 非圧縮テクスチャの1pixelごとのバイト数を取得する
+ */
+static int TextureSource_getPixelBytes(const GLenum format, const GLenum type) {
+    switch (type) {
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT_4_4_4_4:
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+            return 2;
+    }
+
+    switch (format) {
+        case GL_RGBA:
+            return 4;
+        case GL_RGB:
+            return 3;
+        case GL_LUMINANCE_ALPHA:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+/**
+ * ファイルを読み込み、転送前のテクスチャを作成する。
+ */
+TextureSource* TextureSource_load(GLApplication *app, const char* file_name, const int pixel_format) {
+    RawData *raw = RawData_loadFile(app, file_name);
+    if (!raw) {
+        return NULL;
+    }
+
+    TextureSource *source = (TextureSource*) calloc(1, sizeof(TextureSource));
+    source->origin_type = Texture_detectFileFormat(raw);
+
+    // 各loadFromRawData()はrawの所有権を持つため、ここでは解放しない
+    switch (source->origin_type) {
+        case TEXTURE_FILE_PKM: {
+            PkmImage *pkm = PkmImage_loadFromRawData(app, raw);
+            if (!pkm) {
+                break;
+            }
+#ifndef GL_OES_compressed_ETC1_RGB8_texture
+            __log("サポート外のテクスチャ形式(GL_OES_compressed_ETC1_RGB8_texture)");
+            PkmImage_free(app, pkm);
+#else
+            source->width = pkm->width;
+            source->height = pixel_format == TEXTURE_COMPRESS_ETC1A ? ETC1A_getPlaneHeight(pkm->height) : pkm->height;
+            source->image_width = pkm->width;
+            source->image_height = pkm->height;
+            source->compressed = true;
+            source->format = GL_ETC1_RGB8_OES;
+            source->wrap = GL_CLAMP_TO_EDGE;
+
+            TextureSource_allocTables(source, 1);
+            source->image_length_table[0] = pkm->image_bytes;
+            source->image_table[0] = pkm->image;
+            source->origin = (void*) pkm;
+#endif
+        }
+            break;
+        case TEXTURE_FILE_KTX: {
+            KtxImage *ktx = KtxImage_loadFromRawData(app, raw);
+            if (!ktx) {
+                break;
+            }
+            source->width = source->image_width = ktx->width;
+            source->height = source->image_height = ktx->height;
+            source->compressed = (ktx->type == 0);
+            source->format = ktx->format;
+            source->type = ktx->type;
+            source->pixel_bytes = TextureSource_getPixelBytes(ktx->format, ktx->type);
+            source->row_alignment = 4;
+            source->wrap = GL_REPEAT;
+
+            TextureSource_allocTables(source, ktx->mipmaps);
+            memcpy(source->image_length_table, ktx->image_length_table, sizeof(int) * ktx->mipmaps);
+            memcpy(source->image_table, ktx->image_table, sizeof(void*) * ktx->mipmaps);
+            source->origin = (void*) ktx;
+        }
+            break;
+        case TEXTURE_FILE_PVR: {
+            PvrtcImage *pvrtc = PvrtcImage_loadFromRawData(app, raw);
+            if (!pvrtc) {
+                break;
+            }
+            source->width = source->image_width = pvrtc->width;
+            source->height = source->image_height = pvrtc->height;
+            source->compressed = true;
+            source->format = pvrtc->format;
+            source->wrap = GL_REPEAT;
+
+            TextureSource_allocTables(source, pvrtc->mipmaps);
+            memcpy(source->image_length_table, pvrtc->image_length_table, sizeof(int) * pvrtc->mipmaps);
+            memcpy(source->image_table, pvrtc->image_table, sizeof(void*) * pvrtc->mipmaps);
+            source->origin = (void*) pvrtc;
+        }
+            break;
+        case TEXTURE_FILE_PNG:
+        case TEXTURE_FILE_JPEG: {
+            // 圧縮形式が指定されていた場合はRGBA8888として読み込む
+            const int raw_format = (pixel_format >= TEXTURE_RAW_RGBA8 && pixel_format <= TEXTURE_RAW_RGB565) ? pixel_format : TEXTURE_RAW_RGBA8;
+            RawPixelImage *image = RawPixelImage_loadFromRawData(app, raw, raw_format);
+            if (!image) {
+                break;
+            }
+            source->width = source->image_width = image->width;
+            source->height = source->image_height = image->height;
+            source->compressed = false;
+            source->format = RawPixelImage_getGLFormat(raw_format);
+            source->type = RawPixelImage_getGLType(raw_format);
+            source->pixel_bytes = RawPixelImage_getPixelBytes(raw_format);
+            source->row_alignment = 1;
+            source->wrap = GL_CLAMP_TO_EDGE;
+
+            TextureSource_allocTables(source, 1);
+            source->image_length_table[0] = image->width * image->height * source->pixel_bytes;
+            source->image_table[0] = image->pixel_data;
+            source->origin = (void*) image;
+        }
+            break;
+        default:
+            __logf("unknown texture file(%s)", file_name);
+            RawData_freeFile(app, raw);
+            break;
+    }
+
+    if (!source->origin) {
+        __logf("texture source load fail...(%s)", file_name);
+        free(source->image_length_table);
+        free(source->image_table);
+        free(source);
+        return NULL;
+    }
+    return source;
+}
+
+/**
+ * 指定したmipmapの幅を取得する
+ */
+int TextureSource_getLevelWidth(TextureSource *source, const int miplevel) {
+    const int result = source->image_width >> miplevel;
+    return result > 0 ? result : 1;
+}
+
+/**
+ * 指定したmipmapの高さを取得する
+ */
+int TextureSource_getLevelHeight(TextureSource *source, const int miplevel) {
+    const int result = source->image_height >> miplevel;
+    return result > 0 ? result : 1;
+}
+
+/**
+ * 転送前のテクスチャを解放する
+ */
+void TextureSource_free(GLApplication *app, TextureSource *source) {
+    if (!source) {
+        return;
+    }
+
+    switch (source->origin_type) {
+        case TEXTURE_FILE_PKM:
+            PkmImage_free(app, (PkmImage*) source->origin);
+            break;
+        case TEXTURE_FILE_KTX:
+            KtxImage_free(app, (KtxImage*) source->origin);
+            break;
+        case TEXTURE_FILE_PVR:
+            PvrtcImage_free(app, (PvrtcImage*) source->origin);
+            break;
+        case TEXTURE_FILE_PNG:
+        case TEXTURE_FILE_JPEG:
+            RawPixelImage_free(app, (RawPixelImage*) source->origin);
+            break;
+    }
+
+    free(source->image_length_table);
+    free(source->image_table);
+    free(source);
+}
+
+/**
+ * 転送スケジューラを作成する。
+ */
+TextureUploader* TextureUploader_create(const int bytes_per_frame) {
+    assert(bytes_per_frame > 0);
+
+    TextureUploader *result = (TextureUploader*) calloc(1, sizeof(TextureUploader));
+    result->bytes_per_frame = bytes_per_frame;
+    return result;
+}
+
+/**
+ * テクスチャに対応するリクエストを取得する
+ */
+static TextureUploadRequest* TextureUploader_findRequest(TextureUploader *uploader, Texture *texture) {
+    int i = 0;
+    for (i = 0; i < uploader->request_num; ++i) {
+        if (uploader->requests[i].texture == texture) {
+            return uploader->requests + i;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * リクエストを取り除く。
+ * 転送順は優先度とserialで決まるため、末尾のリクエストで埋める。
+ */
+static void TextureUploader_removeRequest(GLApplication *app, TextureUploader *uploader, TextureUploadRequest *request) {
+    if (request->upload_id != request->texture->id) {
+        // プログレッシブ転送中の全解像度テクスチャは破棄する
+        glDeleteTextures(1, &request->upload_id);
+    }
+    TextureSource_free(app, request->source);
+
+    --uploader->request_num;
+    (*request) = uploader->requests[uploader->request_num];
+}
+
+/**
+ * テクスチャIDを確保し、初期設定を行う。
+ * mipmapsはこのテクスチャへ転送するmipmap数。
+ */
+static GLuint TextureUploader_genTexture(TextureSource *source, const int mipmaps) {
+    GLuint result = 0;
+
+    {
+        // 領域確保
+        glGenTextures(1, &result);
+        assert(result > 0);
+        assert(glGetError() == GL_NO_ERROR);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, result);
+
+    if (!source->compressed) {
+        // ピクセルを転送せずにVRAMだけを確保する
+        int miplevel = 0;
+        for (miplevel = 0; miplevel < mipmaps; ++miplevel) {
+            glTexImage2D(GL_TEXTURE_2D, miplevel, source->format, TextureSource_getLevelWidth(source, miplevel), TextureSource_getLevelHeight(source, miplevel), 0, source->format, source->type, NULL);
+        }
+        assert(glGetError() == GL_NO_ERROR);
+    }
+
+    {
+        // wrapの初期設定
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, source->wrap);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, source->wrap);
+        assert(glGetError() == GL_NO_ERROR);
+    }
+
+    {
+        // filterの初期設定
+        // mipmapが揃わないテクスチャは不完全となるため、1枚の場合はmipmapを参照させない
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmaps > 1 ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST);
+        assert(glGetError() == GL_NO_ERROR);
+    }
+
+// unbindする
+    glBindTexture(GL_TEXTURE_2D, 0);
+    assert(glGetError() == GL_NO_ERROR);
+
+    return result;
+}
+
+/**
+ * プレビュー用に、合計preview_bytesに収まる小さなmipmapを即座に転送する。
+ * mipmapの途中から転送するため、preview_levelをmiplevel 0として詰める。
+ */
+static void TextureUploader_uploadPreview(TextureSource *source, const GLuint id, const int preview_level) {
+    glBindTexture(GL_TEXTURE_2D, id);
+
+    int miplevel = 0;
+    for (miplevel = preview_level; miplevel < source->mipmaps; ++miplevel) {
+        const int width = TextureSource_getLevelWidth(source, miplevel);
+        const int height = TextureSource_getLevelHeight(source, miplevel);
+        glCompressedTexImage2D(GL_TEXTURE_2D, miplevel - preview_level, source->format, width, height, 0, source->image_length_table[miplevel], source->image_table[miplevel]);
+        assert(glGetError() == GL_NO_ERROR);
+    }
+
+// unbindする
+    glBindTexture(GL_TEXTURE_2D, 0);
+    assert(glGetError() == GL_NO_ERROR);
+}
+
+/**
+ * テクスチャの読込をリクエストする。
+ * preview_bytesが0より大きい場合はプログレッシブに転送する。
+ */
+static Texture* TextureUploader_addRequest(GLApplication *app, TextureUploader *uploader, const char* file_name, const int pixel_format, const int priority, const int preview_bytes) {
+    TextureSource *source = TextureSource_load(app, file_name, pixel_format);
+    if (!source) {
+        return NULL;
+    }
+
+    Texture *texture = (Texture*) malloc(sizeof(Texture));
+
+    {
+        // 元画像から必要情報をコピーする
+        texture->width = source->width;
+        texture->height = source->height;
+        texture->upload_completed = false;
+        texture->vram_bytes = 0;
+
+        int miplevel = 0;
+        for (miplevel = 0; miplevel < source->mipmaps; ++miplevel) {
+            texture->vram_bytes += source->image_length_table[miplevel];
+        }
+    }
+
+    GLuint upload_id = 0;
+    if (preview_bytes > 0 && source->compressed && source->mipmaps > 1) {
+        // 小さいmipmapから順に、preview_bytesに収まるところまでをプレビューにする
+        // 最小のmipmapは必ずプレビューに含める
+        int preview_level = source->mipmaps - 1;
+        int bytes = source->image_length_table[preview_level];
+        while (preview_level > 1 && (bytes + source->image_length_table[preview_level - 1]) <= preview_bytes) {
+            --preview_level;
+            bytes += source->image_length_table[preview_level];
+        }
+
+        texture->id = TextureUploader_genTexture(source, source->mipmaps - preview_level);
+        TextureUploader_uploadPreview(source, texture->id, preview_level);
+        upload_id = TextureUploader_genTexture(source, source->mipmaps);
+    } else {
+        texture->id = TextureUploader_genTexture(source, source->mipmaps);
+        upload_id = texture->id;
+    }
+
+    {
+        // リクエストを登録する
+        if (uploader->request_num == uploader->request_capacity) {
+            uploader->request_capacity = uploader->request_capacity ? uploader->request_capacity * 2 : 8;
+            uploader->requests = (TextureUploadRequest*) realloc(uploader->requests, sizeof(TextureUploadRequest) * uploader->request_capacity);
+        }
+
+        TextureUploadRequest *request = uploader->requests + uploader->request_num;
+        request->texture = texture;
+        request->source = source;
+        request->upload_id = upload_id;
+        request->priority = priority;
+        request->serial = uploader->serial++;
+        request->miplevel = 0;
+        request->line = 0;
+        ++uploader->request_num;
+    }
+
+    return texture;
+}
+
+/**
+ * テクスチャの読込をリクエストする。
+ */
+Texture* TextureUploader_request(GLApplication *app, TextureUploader *uploader, const char* file_name, const int pixel_format, const int priority) {
+    return TextureUploader_addRequest(app, uploader, file_name, pixel_format, priority, 0);
+}
+
+/**
+ * mipmapを持つ圧縮テクスチャをプログレッシブに読み込む。
+ */
+Texture* TextureUploader_requestProgressive(GLApplication *app, TextureUploader *uploader, const char* file_name, const int pixel_format, const int priority, const int preview_bytes) {
+    assert(preview_bytes > 0);
+    return TextureUploader_addRequest(app, uploader, file_name, pixel_format, priority, preview_bytes);
+}
+
+/**
+ * 転送待ちのテクスチャの優先度を変更する。
+ */
+void TextureUploader_setPriority(TextureUploader *uploader, Texture *texture, const int priority) {
+    TextureUploadRequest *request = TextureUploader_findRequest(uploader, texture);
+    if (request) {
+        request->priority = priority;
+    }
+}
+
+/**
+ * 転送待ちのテクスチャをスケジューラから取り除く。
+ */
+void TextureUploader_cancel(GLApplication *app, TextureUploader *uploader, Texture *texture) {
+    TextureUploadRequest *request = TextureUploader_findRequest(uploader, texture);
+    if (request) {
+        TextureUploader_removeRequest(app, uploader, request);
+    }
+}
+
+/**
+ * 次に転送するリクエストを選択する。
+ */
+static TextureUploadRequest* TextureUploader_selectRequest(TextureUploader *uploader) {
+    TextureUploadRequest *result = NULL;
+
+    int i = 0;
+    for (i = 0; i < uploader->request_num; ++i) {
+        TextureUploadRequest *request = uploader->requests + i;
+        if (!result || request->priority > result->priority || (request->priority == result->priority && request->serial < result->serial)) {
+            result = request;
+        }
+    }
+    return result;
+}
+
+/**
+ * 残りバイト数に収まる分だけ転送する。
+ * 戻り値は転送したバイト数。
+ * forceがtrueの場合、残りバイト数を超えても最低1単位は転送する。
+ */
+static int TextureUploader_uploadStep(TextureUploadRequest *request, const int remain_bytes, const bool force) {
+    TextureSource *source = request->source;
+    const int width = TextureSource_getLevelWidth(source, request->miplevel);
+    const int height = TextureSource_getLevelHeight(source, request->miplevel);
+
+    if (source->compressed) {
+        // 圧縮テクスチャは部分転送できないため、mipmap単位で転送する
+        const int bytes = source->image_length_table[request->miplevel];
+        if (bytes > remain_bytes && !force) {
+            return 0;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, request->upload_id);
+        glCompressedTexImage2D(GL_TEXTURE_2D, request->miplevel, source->format, width, height, 0, bytes, source->image_table[request->miplevel]);
+        assert(glGetError() == GL_NO_ERROR);
+
+        ++request->miplevel;
+        return bytes;
+    } else {
+        // 非圧縮テクスチャはライン単位で転送する
+        const int line_bytes = (width * source->pixel_bytes + source->row_alignment - 1) / source->row_alignment * source->row_alignment;
+        int lines = remain_bytes / line_bytes;
+        if (lines < 1) {
+            if (!force) {
+                return 0;
+            }
+            lines = 1;
+        }
+        if (lines > (height - request->line)) {
+            lines = height - request->line;
+        }
+
+        const uint8_t *pixels = ((const uint8_t*) source->image_table[request->miplevel]) + line_bytes * request->line;
+        glBindTexture(GL_TEXTURE_2D, request->upload_id);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, source->row_alignment);
+        glTexSubImage2D(GL_TEXTURE_2D, request->miplevel, 0, request->line, width, lines, source->format, source->type, pixels);
+        assert(glGetError() == GL_NO_ERROR);
+
+        request->line += lines;
+        if (request->line >= height) {
+            ++request->miplevel;
+            request->line = 0;
+        }
+        return line_bytes * lines;
+    }
+}
+
+/**
+ * プレビューへ設定されたwrap / filterを全解像度のテクスチャへ引き継ぐ。
+ * 転送中に呼び出し側が変更した設定を、ID切り替え時に失わないようにする。
+ */
+static void TextureUploader_copyParameters(const GLuint src_id, const GLuint dst_id) {
+    static const GLenum PARAMETERS[] = { GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T, GL_TEXTURE_MAG_FILTER, GL_TEXTURE_MIN_FILTER };
+    GLint values[4] = { 0 };
+    int i = 0;
+
+    glBindTexture(GL_TEXTURE_2D, src_id);
+    for (i = 0; i < 4; ++i) {
+        glGetTexParameteriv(GL_TEXTURE_2D, PARAMETERS[i], values + i);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, dst_id);
+    for (i = 0; i < 4; ++i) {
+        glTexParameteri(GL_TEXTURE_2D, PARAMETERS[i], values[i]);
+    }
+    assert(glGetError() == GL_NO_ERROR);
+}
+
+/**
+ * 1フレーム分の転送を行う。
+ */
+bool TextureUploader_update(GLApplication *app, TextureUploader *uploader) {
+    uploader->uploaded_bytes = 0;
+    if (!uploader->request_num) {
+        return false;
+    }
+
+    // ライン単位の転送時にソースごとの行の境界を設定するため、元の値を保存しておく
+    GLint unpack_alignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+
+    while (uploader->request_num > 0 && uploader->uploaded_bytes < uploader->bytes_per_frame) {
+        TextureUploadRequest *request = TextureUploader_selectRequest(uploader);
+
+        // 優先度の高いものが収まらない場合、低いものを先に転送せず次のフレームへ回す
+        const int bytes = TextureUploader_uploadStep(request, uploader->bytes_per_frame - uploader->uploaded_bytes, uploader->uploaded_bytes == 0);
+        if (!bytes) {
+            break;
+        }
+        uploader->uploaded_bytes += bytes;
+
+        if (request->miplevel >= request->source->mipmaps) {
+            // 全mipmapの転送が完了した
+            if (request->upload_id != request->texture->id) {
+                // プレビューを破棄し、全解像度のテクスチャへ切り替える
+                TextureUploader_copyParameters(request->texture->id, request->upload_id);
+                glDeleteTextures(1, &request->texture->id);
+                request->texture->id = request->upload_id;
+            }
+            request->texture->upload_completed = true;
+            TextureUploader_removeRequest(app, uploader, request);
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+
+// unbindする
+    glBindTexture(GL_TEXTURE_2D, 0);
+    assert(glGetError() == GL_NO_ERROR);
+
+    return uploader->request_num > 0;
+}
+
+/**
+ * スケジューラを解放する。
+ */
+void TextureUploader_free(GLApplication *app, TextureUploader *uploader) {
+    if (!uploader) {
+        return;
+    }
+
+    while (uploader->request_num > 0) {
+        TextureUploader_removeRequest(app, uploader, uploader->requests);
+    }
+    free(uploader->requests);
+    free(uploader);
+}
@@ -0,0 +1,256 @@
+/*
+ * support_gl_TextureUploader.h
+ *
+ *  Created on: 2026/10/19
+ */
+
+#ifndef SUPPORT_GL_TEXTUREUPLOADER_H_
+#define SUPPORT_GL_TEXTUREUPLOADER_H_
+
+#include    "support.h"
+
+struct Texture;
+
+/**
+ * VRAMへ転送する前のテクスチャ
+ * ファイル形式ごとの違いを吸収し、mipmap単位・ライン単位で転送できるようにする。
+ */
+typedef struct TextureSource {
+    /**
+     * テクスチャとして扱う幅
+     */
+    int width;
+
+    /**
+     * テクスチャとして扱う高さ
+     * ETC1Aの場合、アルファ領域を含まない高さが格納される。
+     */
+    int height;
+
+    /**
+     * 転送する画像幅(miplevel 0)
+     */
+    int image_width;
+
+    /**
+     * 転送する画像高さ(miplevel 0)
+     */
+    int image_height;
+
+    /**
+     * 圧縮テクスチャであればtrue
+     */
+    bool compressed;
+
+    /**
+     * 圧縮テクスチャの場合はinternal format
+     * 非圧縮の場合はGL_RGBA / GL_RGB
+     */
+    GLenum format;
+
+    /**
+     * 非圧縮の場合のピクセルタイプ
+     */
+    GLenum type;
+
+    /**
+     * 非圧縮の場合の1pixelごとのバイト数
+     */
+    int pixel_bytes;
+
+    /**
+     * 非圧縮の場合の各ラインの境界(byte)
+     * デコードした画像は1、KTXは4となる
+     */
+    int row_alignment;
+
+    /**
+     * wrapの初期設定
+     */
+    GLint wrap;
+
+    /**
+     * 画像のmipmap数
+     */
+    int mipmaps;
+
+    /**
+     * 画像の長さ
+     * mipmap数だけ格納されている
+     */
+    int* image_length_table;
+
+    /**
+     * 各画像へのポインタ
+     * mipmap数だけ格納されている
+     */
+    void** image_table;
+
+    /**
+     * 読み込み元のファイル形式
+     * TEXTURE_FILE_XXX
+     */
+    int origin_type;
+
+    /**
+     * 読み込み元の画像
+     * image_tableはこの画像のメモリを指す。
+     */
+    void* origin;
+} TextureSource;
+
+/**
+ * ファイルを読み込み、転送前のテクスチャを作成する。
+ * ファイル形式はTexture_load()と同じくファイルの中身から判定する。
+ * 作成したテクスチャはTextureSource_free()で解放する
+ */
+extern TextureSource* TextureSource_load(GLApplication *app, const char* file_name, const int pixel_format);
+
+/**
+ * 指定したmipmapの幅を取得する
+ */
+extern int TextureSource_getLevelWidth(TextureSource *source, const int miplevel);
+
+/**
+ * 指定したmipmapの高さを取得する
+ */
+extern int TextureSource_getLevelHeight(TextureSource *source, const int miplevel);
+
+/**
+ * 転送前のテクスチャを解放する
+ */
+extern void TextureSource_free(GLApplication *app, TextureSource *source);
+
+/**
+ * 転送待ちのテクスチャ
+ */
+typedef struct TextureUploadRequest {
+    /**
+     * 転送先のテクスチャ
+     */
+    struct Texture *texture;
+
+    /**
+     * 転送元
+     */
+    TextureSource *source;
+
+    /**
+     * 転送先のGLテクスチャID
+     * プログレッシブ転送の場合、プレビュー用のtexture->idとは別に確保したIDとなり、
+     * 全mipmapの転送完了時にtexture->idと入れ替える。
+     * 入れ替え時、プレビューに設定されていたwrap / filterを引き継ぐ。
+     */
+    GLuint upload_id;
+
+    /**
+     * 優先度
+     * 値が大きいものから転送する。
+     */
+    int priority;
+
+    /**
+     * リクエスト順
+     * 同じ優先度の場合、先にリクエストされたものから転送する。
+     */
+    int serial;
+
+    /**
+     * 次に転送するmiplevel
+     */
+    int miplevel;
+
+    /**
+     * 非圧縮の場合、次に転送するライン
+     */
+    int line;
+} TextureUploadRequest;
+
+/**
+ * テクスチャの転送を複数フレームへ分散する。
+ *
+ * 1フレームで転送するバイト数をbytes_per_frameまでに抑えるため、
+ * 非圧縮テクスチャはライン単位、圧縮テクスチャはmipmap単位に分割してglTexSubImage2D / glCompressedTexImage2Dを発行する。
+ * 1単位がbytes_per_frameを超える場合、そのフレームで他の転送を行っていなければ単独で転送する。
+ */
+typedef struct TextureUploader {
+    /**
+     * 1フレームで転送するバイト数の上限
+     */
+    int bytes_per_frame;
+
+    /**
+     * 転送待ちの数
+     */
+    int request_num;
+
+    /**
+     * requestsの確保数
+     */
+    int request_capacity;
+
+    /**
+     * 転送待ちのテクスチャ
+     */
+    TextureUploadRequest *requests;
+
+    /**
+     * 次に発行するリクエスト番号
+     */
+    int serial;
+
+    /**
+     * 最後のTextureUploader_update()で転送したバイト数
+     */
+    int uploaded_bytes;
+} TextureUploader;
+
+/**
+ * 転送スケジューラを作成する。
+ * 作成したスケジューラはTextureUploader_free()で解放する
+ */
+extern TextureUploader* TextureUploader_create(const int bytes_per_frame);
+
+/**
+ * テクスチャの読込をリクエストする。
+ * ファイルの読込とテクスチャIDの確保は即座に行い、VRAMへの転送はTextureUploader_update()で行う。
+ * 転送が完了するまで戻り値のupload_completedはfalseとなる。
+ * 読み込めなかった場合はNULLを返す。
+ */
+extern struct Texture* TextureUploader_request(GLApplication *app, TextureUploader *uploader, const char* file_name, const int pixel_format, const int priority);
+
+/**
+ * mipmapを持つ圧縮テクスチャをプログレッシブに読み込む。
+ * 合計preview_bytesに収まる小さなmipmapを即座にプレビューとして転送し、戻り値はすぐに描画へ利用できる。
+ * 全解像度のmipmapはTextureUploader_update()で別のテクスチャIDへ転送し、完了時にtexture->idを入れ替える。
+ * 入れ替え前にプレビューのwrap / filterを全解像度のテクスチャへ複製するため、設定し直す必要はない。
+ * GLES2ではGL_TEXTURE_BASE_LEVELを指定できないため、プレビューは小さなmipmapをmiplevel 0から詰めて転送する。
+ * mipmapを持たない場合はTextureUploader_request()と同じ動作となる。
+ */
+extern struct Texture* TextureUploader_requestProgressive(GLApplication *app, TextureUploader *uploader, const char* file_name, const int pixel_format, const int priority, const int preview_bytes);
+
+/**
+ * 転送待ちのテクスチャの優先度を変更する。
+ */
+extern void TextureUploader_setPriority(TextureUploader *uploader, struct Texture *texture, const int priority);
+
+/**
+ * 転送待ちのテクスチャをスケジューラから取り除く。
+ * 転送完了前のテクスチャをTexture_free()で解放する場合、事前に呼び出す必要がある。
+ */
+extern void TextureUploader_cancel(GLApplication *app, TextureUploader *uploader, struct Texture *texture);
+
+/**
+ * 1フレーム分の転送を行う。
+ * レンダリングループから毎フレーム呼び出す。
+ * 転送待ちが残っていればtrueを返す。
+ */
+extern bool TextureUploader_update(GLApplication *app, TextureUploader *uploader);
+
+/**
+ * スケジューラを解放する。
+ * 転送待ちのテクスチャは転送されないまま残るため、呼び出し元でTexture_free()する。
+ */
+extern void TextureUploader_free(GLApplication *app, TextureUploader *uploader);
+
+#endif /* SUPPORT_GL_TEXTUREUPLOADER_H_ */
@@ -0,0 +1,245 @@
+/*
+ * support_gl_Texture_RawPixelImage_Convert.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+
+/*
+ * RawPixelImageのピクセル変換処理
+ * GLの関数を呼び出さないため、tools/texture_cookerからGLESをリンクせずに利用できる。
+ */
+
+/**
+ * RGB888のポインタをdst_pixelsへピクセル情報をコピーする。
+ */
+void RawPixelImage_convertColorRGB(const void *rgb888_pixels, const int pixel_format, void *dst_pixels, const int pixel_num) {
+    // 残ピクセル数
+    int pixels = pixel_num;
+    unsigned char *src_rgb888 = (unsigned char *) rgb888_pixels;
+
+    switch (pixel_format) {
+        case TEXTURE_RAW_RGB565: {
+            unsigned short *p = (unsigned short*) dst_pixels;
+            while (pixels) {
+
+                const int r = src_rgb888[0] & 0xff;
+                const int g = src_rgb888[1] & 0xff;
+                const int b = src_rgb888[2] & 0xff;
+
+                (*p) = ((r >> 3) << 11) | ((g >> 2) << 5) | ((b >> 3));
+                src_rgb888 += 3;
+                ++p;
+                --pixels;
+            }
+        }
+            break;
+        case TEXTURE_RAW_RGBA5551: {
+            unsigned short *p = (unsigned short*) dst_pixels;
+            while (pixels) {
+
+                const int r = src_rgb888[0] & 0xff;
+                const int g = src_rgb888[1] & 0xff;
+                const int b = src_rgb888[2] & 0xff;
+                const int a = 1;
+                (*p) = ((r >> 3) << 11) | ((g >> 3) << 6) | ((b >> 3) << 1) | a;
+                src_rgb888 += 3;
+                ++p;
+                --pixels;
+            }
+        }
+            break;
+        case TEXTURE_RAW_RGB8: {
+            memcpy(dst_pixels, src_rgb888, pixels * 3);
+        }
+            break;
+        case TEXTURE_RAW_RGBA8: {
+            unsigned char *dst = (unsigned char*) dst_pixels;
+            while (pixels) {
+
+                dst[0] = src_rgb888[0];
+                dst[1] = src_rgb888[1];
+                dst[2] = src_rgb888[2];
+                dst[3] = 0xFF;
+
+                src_rgb888 += 3;
+                dst += 4;
+                --pixels;
+            }
+        }
+            break;
+    }
+}
+/**
+ * RGBA8888のポインタをdst_pixelsへピクセル情報をコピーする。
+ */
+void RawPixelImage_convertColorRGBA(const void *rgba8888_pixels, const int pixel_format, void *dst_pixels, const int pixel_num) {
+    // 残ピクセル数
+    int pixels = pixel_num;
+    unsigned char *src_rgba8888 = (unsigned char *) rgba8888_pixels;
+
+    switch (pixel_format) {
+        case TEXTURE_RAW_RGB565: {
+            unsigned short *p = (unsigned short*) dst_pixels;
+            while (pixels) {
+
+                const int r = src_rgba8888[0] & 0xff;
+                const int g = src_rgba8888[1] & 0xff;
+                const int b = src_rgba8888[2] & 0xff;
+
+                (*p) = ((r >> 3) << 11) | ((g >> 2) << 5) | ((b >> 3));
+                src_rgba8888 += 4;
+                ++p;
+                --pixels;
+            }
+        }
+            break;
+        case TEXTURE_RAW_RGBA5551: {
+            unsigned short *p = (unsigned short*) dst_pixels;
+            while (pixels) {
+
+                const int r = src_rgba8888[0] & 0xff;
+                const int g = src_rgba8888[1] & 0xff;
+                const int b = src_rgba8888[2] & 0xff;
+                const int a = (src_rgba8888[3] & 0xff) > 0 ? 1 : 0;
+                (*p) = ((r >> 3) << 11) | ((g >> 3) << 6) | ((b >> 3) << 1) | a;
+                src_rgba8888 += 4;
+                ++p;
+                --pixels;
+            }
+        }
+            break;
+        case TEXTURE_RAW_RGB8: {
+            unsigned char *dst = (unsigned char*) dst_pixels;
+            while (pixels) {
+
+                dst[0] = src_rgba8888[0];
+                dst[1] = src_rgba8888[1];
+                dst[2] = src_rgba8888[2];
+
+                src_rgba8888 += 4;
+                dst += 3;
+                --pixels;
+            }
+        }
+            break;
+        case TEXTURE_RAW_RGBA8: {
+            memcpy(dst_pixels, src_rgba8888, pixels * 4);
+        }
+            break;
+    }
+}
+
+/**
+ * 1ピクセルのバイト数を取得する
+ */
+int RawPixelImage_getPixelBytes(const int pixel_format) {
+    switch (pixel_format) {
+        case TEXTURE_RAW_RGBA8:
+            return 4;
+        case TEXTURE_RAW_RGB8:
+            return 3;
+        default:
+            return 2;
+    }
+}
+
+/**
+ * TEXTURE_RAW_XXXに対応するGLのフォーマット
+ */
+static const GLenum RAW_FORMAT[] = { GL_RGBA, GL_RGB, GL_RGBA, GL_RGB };
+
+/**
+ * TEXTURE_RAW_XXXに対応するGLのピクセルタイプ
+ */
+static const GLenum RAW_TYPE[] = { GL_UNSIGNED_BYTE, GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT_5_5_5_1, GL_UNSIGNED_SHORT_5_6_5 };
+
+/**
+ * TEXTURE_RAW_XXXに対応するGLのフォーマットを取得する
+ */
+GLenum RawPixelImage_getGLFormat(const int pixel_format) {
+    assert(pixel_format >= TEXTURE_RAW_RGBA8 && pixel_format <= TEXTURE_RAW_RGB565);
+    return RAW_FORMAT[pixel_format];
+}
+
+/**
+ * TEXTURE_RAW_XXXに対応するGLのピクセルタイプを取得する
+ */
+GLenum RawPixelImage_getGLType(const int pixel_format) {
+    assert(pixel_format >= TEXTURE_RAW_RGBA8 && pixel_format <= TEXTURE_RAW_RGB565);
+    return RAW_TYPE[pixel_format];
+}
+
+/**
+ * マスク画像の値として利用するチャンネルを取得する。
+ */
+int RawPixelImage_getMaskChannel(const RawPixelImage *mask) {
+    if (mask->format == TEXTURE_RAW_RGBA8) {
+        const uint8_t *src = (const uint8_t*) mask->pixel_data;
+        const int pixel_num = mask->width * mask->height;
+
+        int p = 0;
+        for (p = 0; p < pixel_num; ++p) {
+            if (src[p * 4 + 3] != 0xFF) {
+                return TEXTURE_CHANNEL_A;
+            }
+        }
+    }
+    return TEXTURE_CHANNEL_R;
+}
+
+/**
+ * 単色のマスク画像をRGBA8888画像の各チャンネルへまとめる。
+ */
+RawPixelImage* RawPixelImage_packChannels(const RawPixelImage *masks[], const int mask_num) {
+    assert(mask_num > 0 && mask_num <= TEXTURE_CHANNEL_PACK_MAX);
+
+    const int width = masks[0]->width;
+    const int height = masks[0]->height;
+    const int pixel_num = width * height;
+
+    int i = 0;
+    for (i = 0; i < mask_num; ++i) {
+        assert(masks[i]->format == TEXTURE_RAW_RGBA8 || masks[i]->format == TEXTURE_RAW_RGB8);
+        if (masks[i]->width != width || masks[i]->height != height) {
+            __logf("channel pack size mismatch(%d x %d / %d x %d)", width, height, masks[i]->width, masks[i]->height);
+            return NULL;
+        }
+    }
+
+    RawPixelImage *result = (RawPixelImage*) malloc(sizeof(RawPixelImage));
+    result->format = TEXTURE_RAW_RGBA8;
+    result->width = width;
+    result->height = height;
+    result->pixel_data = calloc(1, pixel_num * 4);
+
+    for (i = 0; i < mask_num; ++i) {
+        const int pixel_bytes = RawPixelImage_getPixelBytes(masks[i]->format);
+        const uint8_t *src = (const uint8_t*) masks[i]->pixel_data;
+        uint8_t *dst = ((uint8_t*) result->pixel_data) + i;
+
+        const int offset = RawPixelImage_getMaskChannel(masks[i]);
+        __logf("channel pack mask(%d) <- %s", i, offset == TEXTURE_CHANNEL_A ? "alpha" : "red");
+
+        int p = 0;
+        for (p = 0; p < pixel_num; ++p) {
+            dst[p * 4] = src[p * pixel_bytes + offset];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * 画像用に確保したメモリを解放する
+ */
+void RawPixelImage_free(GLApplication *app, RawPixelImage *image) {
+    if (image) {
+        if (image->pixel_data) {
+            free(image->pixel_data);
+            image->pixel_data = NULL;
+        }
+        free(image);
+    }
+}
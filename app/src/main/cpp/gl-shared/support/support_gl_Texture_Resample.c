@@ -0,0 +1,421 @@
+/*
+ * support_gl_Texture_Resample.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    <pthread.h>
+#include    <unistd.h>
+#include    "support.h"
+#include    "support_gl_Vector_Simd.h"
+
+/**
+ * 1スレッドが担当する最小の行数
+ * これより小さい画像はスレッドを起動せずに処理する。
+ */
+#define RESAMPLE_THREAD_MIN_LINES   32
+
+/**
+ * 処理に利用する最大スレッド数
+ */
+#define RESAMPLE_THREAD_MAX         8
+
+/**
+ * 円周率
+ */
+#define RESAMPLE_PI     3.14159265358979f
+
+/**
+ * 1次元のリサンプリングに利用する重みテーブル
+ * 出力1pixelごとに、入力のstart pixelからtaps個の重みを持つ。
+ */
+typedef struct ResampleWeights {
+    /**
+     * 出力pixelごとの参照開始位置
+     */
+    int *starts;
+
+    /**
+     * 出力1pixelが参照する入力pixel数
+     */
+    int taps;
+
+    /**
+     * 重み
+     * 出力pixel数 * taps個格納されている
+     */
+    float *weights;
+} ResampleWeights;
+
+/**
+ * フィルタの半径を取得する
+ */
+static float Resample_getSupport(const int filter) {
+    switch (filter) {
+        case TEXTURE_RESAMPLE_BICUBIC:
+            return 2.0f;
+        case TEXTURE_RESAMPLE_LANCZOS:
+            return 3.0f;
+        default:
+            return 1.0f;
+    }
+}
+
+/**
+ * フィルタの重みを計算する
+ */
+static float Resample_kernel(const int filter, const float x) {
+    const float ax = fabsf(x);
+
+    switch (filter) {
+        case TEXTURE_RESAMPLE_BICUBIC:
+            // Catmull-Rom(a = -0.5)
+            if (ax < 1.0f) {
+                return (1.5f * ax - 2.5f) * ax * ax + 1.0f;
+            } else if (ax < 2.0f) {
+                return ((-0.5f * ax + 2.5f) * ax - 4.0f) * ax + 2.0f;
+            }
+            return 0.0f;
+        case TEXTURE_RESAMPLE_LANCZOS:
+            // Lanczos3
+            if (ax < 1e-5f) {
+                return 1.0f;
+            } else if (ax < 3.0f) {
+                const float px = RESAMPLE_PI * ax;
+                return 3.0f * sinf(px) * sinf(px / 3.0f) / (px * px);
+            }
+            return 0.0f;
+        default:
+            // Bilinear
+            return ax < 1.0f ? 1.0f - ax : 0.0f;
+    }
+}
+
+/**
+ * 重みテーブルを作成する。
+ * 縮小する場合はフィルタを縮小率に合わせて広げ、エイリアシングを抑える。
+ */
+static void ResampleWeights_init(ResampleWeights *result, const int src_size, const int dst_size, const int filter) {
+    const float scale = (float) dst_size / (float) src_size;
+    const float filter_scale = scale < 1.0f ? scale : 1.0f;
+    const float support = Resample_getSupport(filter) / filter_scale;
+
+    result->taps = (int) ceilf(support * 2.0f) + 1;
+    result->starts = (int*) malloc(sizeof(int) * dst_size);
+    result->weights = (float*) malloc(sizeof(float) * dst_size * result->taps);
+
+    int d = 0;
+    for (d = 0; d < dst_size; ++d) {
+        const float center = ((float) d + 0.5f) / scale - 0.5f;
+        const int start = (int) floorf(center - support) + 1;
+        float *weights = result->weights + d * result->taps;
+        float total = 0.0f;
+
+        int i = 0;
+        for (i = 0; i < result->taps; ++i) {
+            weights[i] = Resample_kernel(filter, ((float) (start + i) - center) * filter_scale);
+            total += weights[i];
+        }
+
+        // 合計が1になるよう正規化する
+        if (total != 0.0f) {
+            for (i = 0; i < result->taps; ++i) {
+                weights[i] /= total;
+            }
+        }
+        result->starts[d] = start;
+    }
+}
+
+/**
+ * 重みテーブルを解放する
+ */
+static void ResampleWeights_free(ResampleWeights *weights) {
+    free(weights->starts);
+    free(weights->weights);
+}
+
+/**
+ * 0〜size-1に丸める
+ */
+static int Resample_clampIndex(const int index, const int size) {
+    return index < 0 ? 0 : (index >= size ? size - 1 : index);
+}
+
+/**
+ * リサンプリング中の作業領域
+ * 中間画像は常に4成分(アルファ乗算済み)のfloatで保持し、1pixelを1回のSIMD演算で扱う。
+ */
+typedef struct ResampleContext {
+    const RawPixelImage *image;
+    RawPixelImage *result;
+    int channels;
+    ResampleWeights weights_x;
+    ResampleWeights weights_y;
+
+    /**
+     * 横方向の処理結果
+     * result->width * image->height * 4個格納されている
+     */
+    float *temp;
+} ResampleContext;
+
+/**
+ * スレッドへ渡す処理範囲
+ */
+typedef struct ResampleTask {
+    ResampleContext *context;
+    void (*pass)(ResampleContext *context, const int begin, const int end);
+    int begin;
+    int end;
+} ResampleTask;
+
+/**
+ * 横方向の処理を行う。
+ * 入力のbegin〜end-1行目を変換し、tempへ書き込む。
+ */
+static void Resample_horizontal(ResampleContext *ctx, const int begin, const int end) {
+    const RawPixelImage *image = ctx->image;
+    const int channels = ctx->channels;
+    const bool has_alpha = channels == 4;
+    const int width = ctx->result->width;
+    const ResampleWeights *weights_x = &ctx->weights_x;
+
+    // 1行分をアルファ乗算済みのfloatへ変換しておき、タップごとの変換を省く
+    float *line = (float*) malloc(sizeof(float) * image->width * 4);
+
+    int y = 0;
+    int x = 0;
+    int i = 0;
+    for (y = begin; y < end; ++y) {
+        const uint8_t *src_line = ((const uint8_t*) image->pixel_data) + y * image->width * channels;
+        float *dst_pixel = ctx->temp + y * width * 4;
+
+        for (x = 0; x < image->width; ++x) {
+            const uint8_t *p = src_line + x * channels;
+            const float alpha = has_alpha ? (float) p[3] / 255.0f : 1.0f;
+            float *l = line + x * 4;
+
+            l[0] = (float) p[0] * alpha;
+            l[1] = (float) p[1] * alpha;
+            l[2] = (float) p[2] * alpha;
+            l[3] = has_alpha ? (float) p[3] : 255.0f;
+        }
+
+        for (x = 0; x < width; ++x) {
+            const float *weights = weights_x->weights + x * weights_x->taps;
+            const int start = weights_x->starts[x];
+
+#if defined(VECTOR_SIMD_NEON) || defined(VECTOR_SIMD_SSE)
+            simd4 sum = simd4_set1(0.0f);
+            for (i = 0; i < weights_x->taps; ++i) {
+                sum = simd4_madds(sum, simd4_load(line + Resample_clampIndex(start + i, image->width) * 4), weights[i]);
+            }
+            simd4_store(dst_pixel, sum);
+#else
+            float sum[4] = { 0, 0, 0, 0 };
+            for (i = 0; i < weights_x->taps; ++i) {
+                const float *p = line + Resample_clampIndex(start + i, image->width) * 4;
+                const float w = weights[i];
+
+                sum[0] += w * p[0];
+                sum[1] += w * p[1];
+                sum[2] += w * p[2];
+                sum[3] += w * p[3];
+            }
+            memcpy(dst_pixel, sum, sizeof(sum));
+#endif
+            dst_pixel += 4;
+        }
+    }
+
+    free(line);
+}
+
+/**
+ * 縦方向の処理を行う。
+ * 出力のbegin〜end-1行目を書き込む。
+ */
+static void Resample_vertical(ResampleContext *ctx, const int begin, const int end) {
+    const int channels = ctx->channels;
+    const bool has_alpha = channels == 4;
+    const int width = ctx->result->width;
+    const int src_height = ctx->image->height;
+    const ResampleWeights *weights_y = &ctx->weights_y;
+
+    // 1行分の積算結果
+    // タップごとに入力の1行をまとめて積算し、中間画像を行単位で連続して読む
+    float *sum_line = (float*) malloc(sizeof(float) * width * 4);
+
+    int y = 0;
+    int x = 0;
+    int i = 0;
+    int c = 0;
+    for (y = begin; y < end; ++y) {
+        const float *weights = weights_y->weights + y * weights_y->taps;
+        uint8_t *dst = ((uint8_t*) ctx->result->pixel_data) + y * width * channels;
+
+        memset(sum_line, 0, sizeof(float) * width * 4);
+        for (i = 0; i < weights_y->taps; ++i) {
+            const float *src_line = ctx->temp + Resample_clampIndex(weights_y->starts[y] + i, src_height) * width * 4;
+            const float w = weights[i];
+
+#if defined(VECTOR_SIMD_NEON) || defined(VECTOR_SIMD_SSE)
+            for (x = 0; x < width; ++x) {
+                simd4_store(sum_line + x * 4, simd4_madds(simd4_load(sum_line + x * 4), simd4_load(src_line + x * 4), w));
+            }
+#else
+            for (x = 0; x < width * 4; ++x) {
+                sum_line[x] += w * src_line[x];
+            }
+#endif
+        }
+
+        for (x = 0; x < width; ++x) {
+            const float *sum = sum_line + x * 4;
+
+            // アルファ乗算を戻す
+            const float alpha = has_alpha ? sum[3] / 255.0f : 1.0f;
+            for (c = 0; c < 3; ++c) {
+                const float value = alpha > 0.0f ? sum[c] / alpha : 0.0f;
+                dst[c] = (uint8_t) (value < 0.0f ? 0 : (value > 255.0f ? 255 : (int) (value + 0.5f)));
+            }
+            if (has_alpha) {
+                dst[3] = (uint8_t) (sum[3] < 0.0f ? 0 : (sum[3] > 255.0f ? 255 : (int) (sum[3] + 0.5f)));
+            }
+            dst += channels;
+        }
+    }
+
+    free(sum_line);
+}
+
+/**
+ * スレッドのエントリポイント
+ */
+static void* Resample_worker(void *arg) {
+    ResampleTask *task = (ResampleTask*) arg;
+    task->pass(task->context, task->begin, task->end);
+    return NULL;
+}
+
+/**
+ * 0〜lines-1行目を複数のスレッドへ分割して処理する。
+ * 各スレッドは担当する行にだけ書き込むため、同期は終了待ちだけで良い。
+ */
+static void Resample_parallelLines(ResampleContext *ctx, void (*pass)(ResampleContext*, const int, const int), const int lines) {
+    int thread_num = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (thread_num > RESAMPLE_THREAD_MAX) {
+        thread_num = RESAMPLE_THREAD_MAX;
+    }
+    if (thread_num > lines / RESAMPLE_THREAD_MIN_LINES) {
+        thread_num = lines / RESAMPLE_THREAD_MIN_LINES;
+    }
+
+    if (thread_num <= 1) {
+        pass(ctx, 0, lines);
+        return;
+    }
+
+    ResampleTask tasks[RESAMPLE_THREAD_MAX];
+    pthread_t threads[RESAMPLE_THREAD_MAX];
+    bool started[RESAMPLE_THREAD_MAX] = { false };
+
+    int i = 0;
+    for (i = 0; i < thread_num; ++i) {
+        tasks[i].context = ctx;
+        tasks[i].pass = pass;
+        tasks[i].begin = lines * i / thread_num;
+        tasks[i].end = lines * (i + 1) / thread_num;
+    }
+
+    // 先頭の範囲は呼び出し元のスレッドで処理する
+    for (i = 1; i < thread_num; ++i) {
+        started[i] = (pthread_create(threads + i, NULL, Resample_worker, tasks + i) == 0);
+    }
+    Resample_worker(tasks);
+
+    for (i = 1; i < thread_num; ++i) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            // スレッドを作成できなかった範囲はここで処理する
+            Resample_worker(tasks + i);
+        }
+    }
+}
+
+/**
+ * 画像を指定サイズへリサンプリングする。
+ */
+RawPixelImage* RawPixelImage_resample(const RawPixelImage *image, const int width, const int height, const int filter) {
+    assert(image->format == TEXTURE_RAW_RGBA8 || image->format == TEXTURE_RAW_RGB8);
+    assert(width > 0 && height > 0);
+
+    ResampleContext ctx;
+    ctx.image = image;
+    ctx.channels = image->format == TEXTURE_RAW_RGBA8 ? 4 : 3;
+    ResampleWeights_init(&ctx.weights_x, image->width, width, filter);
+    ResampleWeights_init(&ctx.weights_y, image->height, height, filter);
+
+    RawPixelImage *result = (RawPixelImage*) malloc(sizeof(RawPixelImage));
+    void *pixel_data = malloc(width * height * ctx.channels);
+    ctx.temp = (float*) malloc(sizeof(float) * width * image->height * 4);
+    if (!result || !pixel_data || !ctx.temp) {
+        __logf("resample alloc failed(%d x %d -> %d x %d)", image->width, image->height, width, height);
+        free(result);
+        free(pixel_data);
+        free(ctx.temp);
+        ResampleWeights_free(&ctx.weights_x);
+        ResampleWeights_free(&ctx.weights_y);
+        return NULL;
+    }
+
+    result->format = image->format;
+    result->width = width;
+    result->height = height;
+    result->pixel_data = pixel_data;
+    ctx.result = result;
+
+    // 横方向 -> 縦方向の順に処理する
+    // アルファを持つ場合、透明部分の色が滲まないようアルファ乗算済みの値で補間する
+    Resample_parallelLines(&ctx, Resample_horizontal, image->height);
+    Resample_parallelLines(&ctx, Resample_vertical, height);
+
+    free(ctx.temp);
+    ResampleWeights_free(&ctx.weights_x);
+    ResampleWeights_free(&ctx.weights_y);
+    return result;
+}
+
+/**
+ * 画像を指定サイズのキャンバスの左上へ配置する。
+ */
+RawPixelImage* RawPixelImage_pad(const RawPixelImage *image, const int width, const int height) {
+    assert(width >= image->width && height >= image->height);
+
+    const int pixel_bytes = RawPixelImage_getPixelBytes(image->format);
+    const int src_line_bytes = image->width * pixel_bytes;
+
+    RawPixelImage *result = (RawPixelImage*) malloc(sizeof(RawPixelImage));
+    result->format = image->format;
+    result->width = width;
+    result->height = height;
+    result->pixel_data = malloc(width * height * pixel_bytes);
+
+    uint8_t *dst = (uint8_t*) result->pixel_data;
+    int y = 0;
+    int x = 0;
+    for (y = 0; y < height; ++y) {
+        // はみ出した領域は端のピクセルで埋め、フィルタリング時に余白の色が混ざらないようにする
+        const uint8_t *src_line = ((const uint8_t*) image->pixel_data) + Resample_clampIndex(y, image->height) * src_line_bytes;
+        uint8_t *dst_line = dst + y * width * pixel_bytes;
+
+        memcpy(dst_line, src_line, src_line_bytes);
+        for (x = image->width; x < width; ++x) {
+            memcpy(dst_line + x * pixel_bytes, src_line + src_line_bytes - pixel_bytes, pixel_bytes);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,251 @@
+/*
+ * support_gl_Transform.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+
+/**
+ * 最大capacity個のノードを管理する領域を確保する。
+ * 全ての配列を1度のmallocで確保し、先頭のワールド行列だけ16byte境界へ揃える。
+ */
+TransformStore* TransformStore_create(const int capacity) {
+    assert(capacity > 0);
+
+    const size_t matrix_bytes = sizeof(mat4) * capacity;
+    const size_t float_bytes = sizeof(GLfloat) * capacity;
+    const size_t block_bytes = 15 + matrix_bytes + (float_bytes * 10) + (sizeof(int) * capacity) + (sizeof(uint8_t) * capacity * 2);
+
+    void *block = malloc(block_bytes);
+    if (!block) {
+        __logf("TransformStore_create alloc failed(%d nodes)", capacity);
+        return NULL;
+    }
+
+    TransformStore *result = (TransformStore*) calloc(1, sizeof(TransformStore));
+    if (!result) {
+        __logf("TransformStore_create alloc failed(%d nodes)", capacity);
+        free(block);
+        return NULL;
+    }
+
+    uint8_t *head = (uint8_t*) (((uintptr_t) block + 15) & ~((uintptr_t) 15));
+
+    result->block = block;
+    result->capacity = capacity;
+
+    result->world = (mat4*) head;
+    head += matrix_bytes;
+
+    result->translate_x = (GLfloat*) head;
+    head += float_bytes;
+    result->translate_y = (GLfloat*) head;
+    head += float_bytes;
+    result->translate_z = (GLfloat*) head;
+    head += float_bytes;
+
+    result->rotate_x = (GLfloat*) head;
+    head += float_bytes;
+    result->rotate_y = (GLfloat*) head;
+    head += float_bytes;
+    result->rotate_z = (GLfloat*) head;
+    head += float_bytes;
+    result->rotate_w = (GLfloat*) head;
+    head += float_bytes;
+
+    result->scale_x = (GLfloat*) head;
+    head += float_bytes;
+    result->scale_y = (GLfloat*) head;
+    head += float_bytes;
+    result->scale_z = (GLfloat*) head;
+    head += float_bytes;
+
+    result->parent = (int*) head;
+    head += sizeof(int) * capacity;
+
+    result->dirty = head;
+    head += capacity;
+    result->updated = head;
+
+    return result;
+}
+
+/**
+ * ノードを追加し、インデックスを返す。
+ */
+int TransformStore_add(TransformStore *store, const int parent) {
+    assert(store);
+    assert(parent == TRANSFORM_NONE || (parent >= 0 && parent < store->num));
+
+    if (store->num >= store->capacity) {
+        __logf("TransformStore_add capacity over(%d)", store->capacity);
+        return TRANSFORM_NONE;
+    }
+
+    const int index = store->num++;
+
+    store->parent[index] = parent;
+
+    store->translate_x[index] = 0.0f;
+    store->translate_y[index] = 0.0f;
+    store->translate_z[index] = 0.0f;
+
+    store->rotate_x[index] = 0.0f;
+    store->rotate_y[index] = 0.0f;
+    store->rotate_z[index] = 0.0f;
+    store->rotate_w[index] = 1.0f;
+
+    store->scale_x[index] = 1.0f;
+    store->scale_y[index] = 1.0f;
+    store->scale_z[index] = 1.0f;
+
+    store->dirty[index] = true;
+    store->updated[index] = false;
+    mat4_identity_to(store->world + index);
+
+    return index;
+}
+
+/**
+ * 親ノードを変更する。
+ */
+void TransformStore_setParent(TransformStore *store, const int index, const int parent) {
+    assert(store);
+    assert(index >= 0 && index < store->num);
+    assert(parent == TRANSFORM_NONE || (parent >= 0 && parent < index));
+
+    store->parent[index] = parent;
+    store->dirty[index] = true;
+}
+
+/**
+ * ローカル移動量を設定する
+ */
+void TransformStore_setTranslate(TransformStore *store, const int index, const GLfloat x, const GLfloat y, const GLfloat z) {
+    assert(store);
+    assert(index >= 0 && index < store->num);
+
+    store->translate_x[index] = x;
+    store->translate_y[index] = y;
+    store->translate_z[index] = z;
+    store->dirty[index] = true;
+}
+
+/**
+ * ローカル回転を設定する
+ */
+void TransformStore_setRotate(TransformStore *store, const int index, const quat *rotate) {
+    assert(store);
+    assert(index >= 0 && index < store->num);
+
+    store->rotate_x[index] = rotate->x;
+    store->rotate_y[index] = rotate->y;
+    store->rotate_z[index] = rotate->z;
+    store->rotate_w[index] = rotate->w;
+    store->dirty[index] = true;
+}
+
+/**
+ * ローカル拡縮率を設定する
+ */
+void TransformStore_setScale(TransformStore *store, const int index, const GLfloat x, const GLfloat y, const GLfloat z) {
+    assert(store);
+    assert(index >= 0 && index < store->num);
+
+    store->scale_x[index] = x;
+    store->scale_y[index] = y;
+    store->scale_z[index] = z;
+    store->dirty[index] = true;
+}
+
+/**
+ * ローカル変換行列を計算する
+ * translate <- rotate <- scale順で適用するため、回転行列の各列に拡縮率をかけ、移動量を4列目に置く。
+ */
+static void TransformStore_createLocal(const TransformStore *store, const int index, mat4 *result) {
+    int row = 0;
+    quat rotate;
+    rotate.x = store->rotate_x[index];
+    rotate.y = store->rotate_y[index];
+    rotate.z = store->rotate_z[index];
+    rotate.w = store->rotate_w[index];
+
+    mat4_fromQuat(result, &rotate);
+
+    for (row = 0; row < 3; ++row) {
+        result->m[0][row] *= store->scale_x[index];
+        result->m[1][row] *= store->scale_y[index];
+        result->m[2][row] *= store->scale_z[index];
+    }
+
+    result->m[3][0] = store->translate_x[index];
+    result->m[3][1] = store->translate_y[index];
+    result->m[3][2] = store->translate_z[index];
+}
+
+/**
+ * 変更されたノードとその子孫のワールド行列を再計算する。
+ * 親は必ず子より前にあるため、先頭から順に処理すれば親の再計算結果が子へ伝搬する。
+ */
+int TransformStore_update(TransformStore *store) {
+    int updated_num = 0;
+    int i = 0;
+
+    assert(store);
+
+    for (i = 0; i < store->num; ++i) {
+        const int parent = store->parent[i];
+        const bool updated = store->dirty[i] || (parent != TRANSFORM_NONE && store->updated[parent]);
+
+        store->updated[i] = updated;
+        if (!updated) {
+            continue;
+        }
+
+        store->dirty[i] = false;
+        ++updated_num;
+
+        if (parent == TRANSFORM_NONE) {
+            TransformStore_createLocal(store, i, store->world + i);
+        } else {
+            mat4 local;
+            TransformStore_createLocal(store, i, &local);
+            mat4_multiply_to(store->world + i, store->world + parent, &local);
+        }
+    }
+
+    return updated_num;
+}
+
+/**
+ * ワールド行列を取得する。
+ */
+const mat4* TransformStore_getWorld(const TransformStore *store, const int index) {
+    assert(store);
+    assert(index >= 0 && index < store->num);
+
+    return store->world + index;
+}
+
+/**
+ * 直前のTransformStore_update()でワールド行列が再計算されていればtrueを返す。
+ */
+bool TransformStore_isUpdated(const TransformStore *store, const int index) {
+    assert(store);
+    assert(index >= 0 && index < store->num);
+
+    return store->updated[index];
+}
+
+/**
+ * 管理領域を解放する
+ */
+void TransformStore_free(TransformStore *store) {
+    if (!store) {
+        return;
+    }
+
+    free(store->block);
+    free(store);
+}
@@ -0,0 +1,145 @@
+/*
+ * support_gl_Transform.h
+ *
+ *  Created on: 2026/10/19
+ */
+
+#ifndef SUPPORT_GL_TRANSFORM_H_
+#define SUPPORT_GL_TRANSFORM_H_
+
+#include    "support.h"
+
+/**
+ * 親を持たないノードの親インデックス
+ */
+#define TRANSFORM_NONE      -1
+
+/**
+ * 親子関係を持つ変換（移動・回転・拡縮）をまとめて管理する。
+ *
+ * ローカル変換は成分ごとの配列(SoA)で保持し、ノードは常に親が子より前に並ぶ。
+ * そのため、TransformStore_update()は配列を先頭から1度なめるだけで、
+ * 変更されたノードとその子孫のワールド行列を再計算できる。
+ *
+ * ノードのインデックスは追加順に割り当てられ、削除・並び替えは行わない。
+ */
+typedef struct TransformStore {
+    /**
+     * 確保済みのノード数
+     */
+    int capacity;
+
+    /**
+     * 追加済みのノード数
+     */
+    int num;
+
+    /**
+     * 親ノードのインデックス
+     * 親を持たない場合はTRANSFORM_NONE
+     */
+    int *parent;
+
+    /**
+     * ローカル移動量
+     */
+    GLfloat *translate_x;
+    GLfloat *translate_y;
+    GLfloat *translate_z;
+
+    /**
+     * ローカル回転（クォータニオン）
+     */
+    GLfloat *rotate_x;
+    GLfloat *rotate_y;
+    GLfloat *rotate_z;
+    GLfloat *rotate_w;
+
+    /**
+     * ローカル拡縮率
+     */
+    GLfloat *scale_x;
+    GLfloat *scale_y;
+    GLfloat *scale_z;
+
+    /**
+     * ローカル変換が変更され、次回のupdateで再計算が必要な場合true
+     */
+    uint8_t *dirty;
+
+    /**
+     * 直前のupdateでワールド行列が再計算された場合true
+     */
+    uint8_t *updated;
+
+    /**
+     * ワールド行列
+     * 16byte境界に配置される。
+     */
+    mat4 *world;
+
+    /**
+     * 全配列をまとめて確保した領域
+     */
+    void *block;
+} TransformStore;
+
+/**
+ * 最大capacity個のノードを管理する領域を確保する。
+ * 不要になったらTransformStore_free()で解放する。
+ */
+extern TransformStore* TransformStore_create(const int capacity);
+
+/**
+ * ノードを追加し、インデックスを返す。
+ * parentには追加済みのノードかTRANSFORM_NONEを指定する。
+ * ローカル変換は無変換（移動0、無回転、拡縮1）で初期化される。
+ * 容量が足りない場合はTRANSFORM_NONEを返す。
+ */
+extern int TransformStore_add(TransformStore *store, const int parent);
+
+/**
+ * 親ノードを変更する。
+ * 並び順を保つため、parentはindexより前のノードかTRANSFORM_NONEである必要がある。
+ */
+extern void TransformStore_setParent(TransformStore *store, const int index, const int parent);
+
+/**
+ * ローカル移動量を設定する
+ */
+extern void TransformStore_setTranslate(TransformStore *store, const int index, const GLfloat x, const GLfloat y, const GLfloat z);
+
+/**
+ * ローカル回転を設定する
+ */
+extern void TransformStore_setRotate(TransformStore *store, const int index, const quat *rotate);
+
+/**
+ * ローカル拡縮率を設定する
+ */
+extern void TransformStore_setScale(TransformStore *store, const int index, const GLfloat x, const GLfloat y, const GLfloat z);
+
+/**
+ * 変更されたノードとその子孫のワールド行列を再計算する。
+ * 再計算したノード数を返す。
+ */
+extern int TransformStore_update(TransformStore *store);
+
+/**
+ * ワールド行列を取得する。
+ * TransformStore_update()後の値が格納されている。
+ */
+extern const mat4* TransformStore_getWorld(const TransformStore *store, const int index);
+
+/**
+ * 直前のTransformStore_update()でワールド行列が再計算されていればtrueを返す。
+ * GPUへ行列を再転送するかの判定に利用できる。
+ */
+extern bool TransformStore_isUpdated(const TransformStore *store, const int index);
+
+/**
+ * 管理領域を解放する
+ */
+extern void TransformStore_free(TransformStore *store);
+
+#endif /* SUPPORT_GL_TRANSFORM_H_ */
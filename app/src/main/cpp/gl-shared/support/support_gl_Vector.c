@@ -5,6 +5,8 @@
  */
 
 #include    "support.h"
+#include    "support_gl_Vector_Simd.h"
+
 /**
  * 2次元ベクトルを生成する
  */
@@ -58,125 +60,331 @@ vec3 vec3_cross(const vec3 v0, const vec3 v1) {
 }
 
 /**
- * 単位行列を生成する
+ * 単位行列をresultへ書き込む
  */
-mat4 mat4_identity() {
-    mat4 result;
-
+void mat4_identity_to(mat4 *result) {
     int column = 0;
     int row = 0;
 
     for (column = 0; column < 4; ++column) {
         for (row = 0; row < 4; ++row) {
             if (column == row) {
-                result.m[column][row] = 1.0f;
+                result->m[column][row] = 1.0f;
             } else {
-                result.m[column][row] = 0.0f;
+                result->m[column][row] = 0.0f;
             }
         }
     }
-
-    return result;
 }
 
 /**
- * 行列の転置を行う
+ * 行列mの転置をresultへ書き込む
  */
-mat4 mat4_transpose(const mat4 m) {
+void mat4_transpose_to(mat4 *result, const mat4 *m) {
+#if defined(VECTOR_SIMD_NEON)
+    // 4要素おきに読み込むことで、読み込みと同時に縦横が入れ替わる
+    const float32x4x4_t t = vld4q_f32(&m->m[0][0]);
+    vst1q_f32(result->m[0], t.val[0]);
+    vst1q_f32(result->m[1], t.val[1]);
+    vst1q_f32(result->m[2], t.val[2]);
+    vst1q_f32(result->m[3], t.val[3]);
+#elif defined(VECTOR_SIMD_SSE)
+    __m128 c0 = _mm_loadu_ps(m->m[0]);
+    __m128 c1 = _mm_loadu_ps(m->m[1]);
+    __m128 c2 = _mm_loadu_ps(m->m[2]);
+    __m128 c3 = _mm_loadu_ps(m->m[3]);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_storeu_ps(result->m[0], c0);
+    _mm_storeu_ps(result->m[1], c1);
+    _mm_storeu_ps(result->m[2], c2);
+    _mm_storeu_ps(result->m[3], c3);
+#else
     int i;
     int k;
-    mat4 result;
+    mat4 temp;
 
     for (i = 0; i < 4; ++i) {
         for (k = 0; k < 4; ++k) {
             // 値の縦横を入れ替える
-            result.m[i][k] = m.m[k][i];
+            temp.m[i][k] = m->m[k][i];
         }
     }
 
-    return result;
+    (*result) = temp;
+#endif
 }
 
 /**
- * 移動行列を作成する
+ * 移動行列をresultへ書き込む
  */
-mat4 mat4_translate(const GLfloat x, const GLfloat y, const GLfloat z) {
-    mat4 result = mat4_identity();
-
-    result.m[3][0] = x;
-    result.m[3][1] = y;
-    result.m[3][2] = z;
+void mat4_translate_to(mat4 *result, const GLfloat x, const GLfloat y, const GLfloat z) {
+    mat4_identity_to(result);
 
-    return result;
+    result->m[3][0] = x;
+    result->m[3][1] = y;
+    result->m[3][2] = z;
 }
 
 /**
- * 拡縮行列を作成する
+ * 拡縮行列をresultへ書き込む
  */
-mat4 mat4_scale(const GLfloat x, const GLfloat y, const GLfloat z) {
-    mat4 result = mat4_identity();
+void mat4_scale_to(mat4 *result, const GLfloat x, const GLfloat y, const GLfloat z) {
+    mat4_identity_to(result);
 
-    result.m[0][0] = x;
-    result.m[1][1] = y;
-    result.m[2][2] = z;
-
-    return result;
+    result->m[0][0] = x;
+    result->m[1][1] = y;
+    result->m[2][2] = z;
 }
 
 /**
- * 回転行列を生成する
+ * 回転行列をresultへ書き込む
  */
-mat4 mat4_rotate(const vec3 axis, const GLfloat rotate) {
-    mat4 result;
-
-    const GLfloat x = axis.x;
-    const GLfloat y = axis.y;
-    const GLfloat z = axis.z;
+void mat4_rotate_to(mat4 *result, const vec3 *axis, const GLfloat rotate) {
+    const GLfloat x = axis->x;
+    const GLfloat y = axis->y;
+    const GLfloat z = axis->z;
 
-    const GLfloat c = cos(degree2radian(rotate));
-    const GLfloat s = sin(degree2radian(rotate));
+    GLfloat s;
+    GLfloat c;
+    trig_sincos(rotate, &s, &c);
     {
-        result.m[0][0] = (x * x) * (1.0f - c) + c;
-        result.m[0][1] = (x * y) * (1.0f - c) - z * s;
-        result.m[0][2] = (x * z) * (1.0f - c) + y * s;
-        result.m[0][3] = 0;
+        result->m[0][0] = (x * x) * (1.0f - c) + c;
+        result->m[0][1] = (x * y) * (1.0f - c) - z * s;
+        result->m[0][2] = (x * z) * (1.0f - c) + y * s;
+        result->m[0][3] = 0;
     }
     {
-        result.m[1][0] = (y * x) * (1.0f - c) + z * s;
-        result.m[1][1] = (y * y) * (1.0f - c) + c;
-        result.m[1][2] = (y * z) * (1.0f - c) - x * s;
-        result.m[1][3] = 0;
+        result->m[1][0] = (y * x) * (1.0f - c) + z * s;
+        result->m[1][1] = (y * y) * (1.0f - c) + c;
+        result->m[1][2] = (y * z) * (1.0f - c) - x * s;
+        result->m[1][3] = 0;
     }
     {
-        result.m[2][0] = (z * x) * (1.0f - c) - y * s;
-        result.m[2][1] = (z * y) * (1.0f - c) + x * s;
-        result.m[2][2] = (z * z) * (1.0f - c) + c;
-        result.m[2][3] = 0;
+        result->m[2][0] = (z * x) * (1.0f - c) - y * s;
+        result->m[2][1] = (z * y) * (1.0f - c) + x * s;
+        result->m[2][2] = (z * z) * (1.0f - c) + c;
+        result->m[2][3] = 0;
     }
     {
-        result.m[3][0] = 0;
-        result.m[3][1] = 0;
-        result.m[3][2] = 0;
-        result.m[3][3] = 1;
+        result->m[3][0] = 0;
+        result->m[3][1] = 0;
+        result->m[3][2] = 0;
+        result->m[3][3] = 1;
     }
+}
 
-    return result;
+/**
+ * 正射影行列をresultへ書き込む。
+ */
+void mat4_ortho_to(mat4 *result, const GLfloat left, const GLfloat right, const GLfloat bottom, const GLfloat top, const GLfloat near, const GLfloat far) {
+    mat4_identity_to(result);
+
+    result->m[0][0] = 2.0f / (right - left);
+    result->m[1][1] = 2.0f / (top - bottom);
+    result->m[2][2] = -2.0f / (far - near);
+    result->m[3][0] = -(right + left) / (right - left);
+    result->m[3][1] = -(top + bottom) / (top - bottom);
+    result->m[3][2] = -(far + near) / (far - near);
 }
 
 /**
- * 行列A×行列Bを行う。
+ * 透視射影行列をresultへ書き込む。
+ */
+void mat4_perspective_to(mat4 *result, const GLfloat fovy, const GLfloat aspect, const GLfloat near, const GLfloat far) {
+    const GLfloat f = (GLfloat) (1.0 / tan(degree2radian(fovy) * 0.5));
+
+    mat4_identity_to(result);
+
+    result->m[0][0] = f / aspect;
+    result->m[1][1] = f;
+    result->m[2][2] = (far + near) / (near - far);
+    result->m[2][3] = -1.0f;
+    result->m[3][2] = (2.0f * far * near) / (near - far);
+    result->m[3][3] = 0.0f;
+}
+
+/**
+ * eyeからtargetを向くビュー行列をresultへ書き込む。
+ */
+void mat4_lookAt_to(mat4 *result, const vec3 *eye, const vec3 *target, const vec3 *up) {
+    // 視線方向・右方向・上方向の正規直交基底を作る
+    const vec3 f = vec3_normalize(vec3_create(target->x - eye->x, target->y - eye->y, target->z - eye->z));
+    const vec3 s = vec3_normalize(vec3_cross(f, *up));
+    const vec3 u = vec3_cross(s, f);
+
+    result->m[0][0] = s.x;
+    result->m[1][0] = s.y;
+    result->m[2][0] = s.z;
+    result->m[3][0] = -vec3_dot(s, *eye);
+
+    result->m[0][1] = u.x;
+    result->m[1][1] = u.y;
+    result->m[2][1] = u.z;
+    result->m[3][1] = -vec3_dot(u, *eye);
+
+    result->m[0][2] = -f.x;
+    result->m[1][2] = -f.y;
+    result->m[2][2] = -f.z;
+    result->m[3][2] = vec3_dot(f, *eye);
+
+    result->m[0][3] = 0.0f;
+    result->m[1][3] = 0.0f;
+    result->m[2][3] = 0.0f;
+    result->m[3][3] = 1.0f;
+}
+
+/**
+ * 行列A×行列Bをresultへ書き込む。
  * 頂点に対し、行列B→行列Aの順番で適用することになる。
+ *
+ * 結果の列iは「Aの各列をBの列iの要素で重み付けした和」になるため、
+ * Aの4列をレジスタに保持し、Bの要素をブロードキャストして積和する。
+ * Aは全て読み込んでから、Bの列iは結果の列iを書き込む前に読み込むため、resultがa/bと重なっていても正しく計算できる。
  */
-mat4 mat4_multiply(const mat4 a, const mat4 b) {
-    mat4 result;
+void mat4_multiply_to(mat4 *result, const mat4 *a, const mat4 *b) {
+#if defined(VECTOR_SIMD_NEON)
+    const float32x4_t a0 = vld1q_f32(a->m[0]);
+    const float32x4_t a1 = vld1q_f32(a->m[1]);
+    const float32x4_t a2 = vld1q_f32(a->m[2]);
+    const float32x4_t a3 = vld1q_f32(a->m[3]);
+
+    int i = 0;
+    for (i = 0; i < 4; ++i) {
+        const float32x4_t bi = vld1q_f32(b->m[i]);
+        float32x4_t r = vmulq_lane_f32(a0, vget_low_f32(bi), 0);
+        r = vmlaq_lane_f32(r, a1, vget_low_f32(bi), 1);
+        r = vmlaq_lane_f32(r, a2, vget_high_f32(bi), 0);
+        r = vmlaq_lane_f32(r, a3, vget_high_f32(bi), 1);
+        vst1q_f32(result->m[i], r);
+    }
+#elif defined(VECTOR_SIMD_SSE)
+    const __m128 a0 = _mm_loadu_ps(a->m[0]);
+    const __m128 a1 = _mm_loadu_ps(a->m[1]);
+    const __m128 a2 = _mm_loadu_ps(a->m[2]);
+    const __m128 a3 = _mm_loadu_ps(a->m[3]);
+
+    int i = 0;
+    for (i = 0; i < 4; ++i) {
+        const __m128 bi = _mm_loadu_ps(b->m[i]);
+        __m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(bi, bi, _MM_SHUFFLE(0, 0, 0, 0)));
+        r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_shuffle_ps(bi, bi, _MM_SHUFFLE(1, 1, 1, 1))));
+        r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_shuffle_ps(bi, bi, _MM_SHUFFLE(2, 2, 2, 2))));
+        r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_shuffle_ps(bi, bi, _MM_SHUFFLE(3, 3, 3, 3))));
+        _mm_storeu_ps(result->m[i], r);
+    }
+#else
+    mat4 temp;
 
     int i = 0;
     for (i = 0; i < 4; ++i) {
-        result.m[i][0] = a.m[0][0] * b.m[i][0] + a.m[1][0] * b.m[i][1] + a.m[2][0] * b.m[i][2] + a.m[3][0] * b.m[i][3];
-        result.m[i][1] = a.m[0][1] * b.m[i][0] + a.m[1][1] * b.m[i][1] + a.m[2][1] * b.m[i][2] + a.m[3][1] * b.m[i][3];
-        result.m[i][2] = a.m[0][2] * b.m[i][0] + a.m[1][2] * b.m[i][1] + a.m[2][2] * b.m[i][2] + a.m[3][2] * b.m[i][3];
-        result.m[i][3] = a.m[0][3] * b.m[i][0] + a.m[1][3] * b.m[i][1] + a.m[2][3] * b.m[i][2] + a.m[3][3] * b.m[i][3];
+        temp.m[i][0] = a->m[0][0] * b->m[i][0] + a->m[1][0] * b->m[i][1] + a->m[2][0] * b->m[i][2] + a->m[3][0] * b->m[i][3];
+        temp.m[i][1] = a->m[0][1] * b->m[i][0] + a->m[1][1] * b->m[i][1] + a->m[2][1] * b->m[i][2] + a->m[3][1] * b->m[i][3];
+        temp.m[i][2] = a->m[0][2] * b->m[i][0] + a->m[1][2] * b->m[i][1] + a->m[2][2] * b->m[i][2] + a->m[3][2] * b->m[i][3];
+        temp.m[i][3] = a->m[0][3] * b->m[i][0] + a->m[1][3] * b->m[i][1] + a->m[2][3] * b->m[i][2] + a->m[3][3] * b->m[i][3];
     }
 
+    (*result) = temp;
+#endif
+}
+
+/**
+ * 単位行列を生成する
+ */
+mat4 mat4_identity() {
+    mat4 result;
+    mat4_identity_to(&result);
+    return result;
+}
+
+/**
+ * 行列の転置を行う
+ */
+mat4 mat4_transpose(const mat4 m) {
+    mat4 result;
+    mat4_transpose_to(&result, &m);
+    return result;
+}
+
+/**
+ * 移動行列を作成する
+ */
+mat4 mat4_translate(const GLfloat x, const GLfloat y, const GLfloat z) {
+    mat4 result;
+    mat4_translate_to(&result, x, y, z);
+    return result;
+}
+
+/**
+ * 拡縮行列を作成する
+ */
+mat4 mat4_scale(const GLfloat x, const GLfloat y, const GLfloat z) {
+    mat4 result;
+    mat4_scale_to(&result, x, y, z);
+    return result;
+}
+
+/**
+ * 回転行列を生成する
+ */
+mat4 mat4_rotate(const vec3 axis, const GLfloat rotate) {
+    mat4 result;
+    mat4_rotate_to(&result, &axis, rotate);
     return result;
 }
+
+/**
+ * 行列A×行列Bを行う。
+ * 頂点に対し、行列B→行列Aの順番で適用することになる。
+ */
+mat4 mat4_multiply(const mat4 a, const mat4 b) {
+    mat4 result;
+    mat4_multiply_to(&result, &a, &b);
+    return result;
+}
+
+/**
+ * 単位行列をresultへ書き込む
+ */
+void mat2x3_identity_to(mat2x3 *result) {
+    result->m[0][0] = 1.0f;
+    result->m[0][1] = 0.0f;
+    result->m[1][0] = 0.0f;
+    result->m[1][1] = 1.0f;
+    result->m[2][0] = 0.0f;
+    result->m[2][1] = 0.0f;
+}
+
+/**
+ * アフィン行列A×アフィン行列Bをresultへ書き込む。
+ * 3行目が(0, 0, 1)で固定されているため、2x2の積と移動量の変換だけで計算できる。
+ */
+void mat2x3_multiply_to(mat2x3 *result, const mat2x3 *a, const mat2x3 *b) {
+    const GLfloat a00 = a->m[0][0], a01 = a->m[0][1];
+    const GLfloat a10 = a->m[1][0], a11 = a->m[1][1];
+    const GLfloat a20 = a->m[2][0], a21 = a->m[2][1];
+
+    const GLfloat b00 = b->m[0][0], b01 = b->m[0][1];
+    const GLfloat b10 = b->m[1][0], b11 = b->m[1][1];
+    const GLfloat b20 = b->m[2][0], b21 = b->m[2][1];
+
+    result->m[0][0] = a00 * b00 + a10 * b01;
+    result->m[0][1] = a01 * b00 + a11 * b01;
+    result->m[1][0] = a00 * b10 + a10 * b11;
+    result->m[1][1] = a01 * b10 + a11 * b11;
+    result->m[2][0] = a00 * b20 + a10 * b21 + a20;
+    result->m[2][1] = a01 * b20 + a11 * b21 + a21;
+}
+
+/**
+ * アフィン行列をmat4へ展開する。
+ */
+void mat4_fromMat2x3(mat4 *result, const mat2x3 *affine) {
+    mat4_identity_to(result);
+
+    result->m[0][0] = affine->m[0][0];
+    result->m[0][1] = affine->m[0][1];
+    result->m[1][0] = affine->m[1][0];
+    result->m[1][1] = affine->m[1][1];
+    result->m[3][0] = affine->m[2][0];
+    result->m[3][1] = affine->m[2][1];
+}
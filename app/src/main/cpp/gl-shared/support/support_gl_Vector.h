@@ -12,6 +12,24 @@
  */
 #define degree2radian(degree) ((degree * M_PI) / 180.0)
 
+/**
+ * trig_sincos()をlibm(double)で計算する
+ */
+#define TRIG_PRECISION_LIBM     0
+
+/**
+ * trig_sincos()を多項式近似(float)で計算する
+ */
+#define TRIG_PRECISION_FAST     1
+
+/**
+ * trig_sincos()の既定の精度
+ * ビルド時に-DTRIG_PRECISION_DEFAULT=1を指定すると、起動直後から近似計算を利用する。
+ */
+#ifndef TRIG_PRECISION_DEFAULT
+#define TRIG_PRECISION_DEFAULT  TRIG_PRECISION_LIBM
+#endif
+
 /**
  * 2次元ベクトルを保持する構造体
  */
@@ -72,13 +90,87 @@ typedef struct vec4 {
     GLfloat w;
 } vec4;
 
+/**
+ * SIMD命令で扱いやすいよう、16byte境界にアライメントする
+ */
+#if defined(__GNUC__)
+#define VECTOR_ALIGN16 __attribute__((aligned(16)))
+#else
+#define VECTOR_ALIGN16
+#endif
+
+/**
+ * SoA(Structure of Arrays)形式の頂点配列を指す構造体
+ * 各成分はnum要素の配列で、x/yは必須となる。
+ * 入力側のz/wがNULLの場合はz=0、w=1として扱い、出力側のz/wがNULLの場合は書き込まない。
+ */
+typedef struct vec_soa {
+    /**
+     * X値の配列
+     */
+    GLfloat *x;
+
+    /**
+     * Y値の配列
+     */
+    GLfloat *y;
+
+    /**
+     * Z値の配列
+     */
+    GLfloat *z;
+
+    /**
+     * W値の配列
+     */
+    GLfloat *w;
+} vec_soa;
+
+/**
+ * 回転を表すクォータニオン
+ * (x, y, z)が虚部、wが実部となる。
+ */
+typedef struct VECTOR_ALIGN16 quat {
+    /**
+     * X値
+     */
+    GLfloat x;
+
+    /**
+     * Y値
+     */
+    GLfloat y;
+
+    /**
+     * Z値
+     */
+    GLfloat z;
+
+    /**
+     * W値
+     */
+    GLfloat w;
+} quat;
+
 /**
  * 行列を保持する構造体
+ * m[列][行]のColumn-Major形式で格納する。
+ * スタック・静的領域では16byte境界に配置される。
+ * malloc()した領域は16byte境界が保証されないため、SIMD実装はアライメントを要求しない命令で読み書きする。
  */
-typedef struct mat4 {
+typedef struct VECTOR_ALIGN16 mat4 {
     GLfloat m[4][4];
 } mat4;
 
+/**
+ * 2次元のアフィン変換行列を保持する構造体
+ * m[列][行]のColumn-Major形式で、m[2]に移動量を格納する。
+ * mat4のうち、X/Yの回転拡縮と移動だけを持つ行列と同じ意味になる。
+ */
+typedef struct mat2x3 {
+    GLfloat m[3][2];
+} mat2x3;
+
 /**
  * 2次元ベクトルを生成する
  */
@@ -144,4 +236,217 @@ extern mat4 mat4_rotate(const vec3 axis, const GLfloat rotate);
  */
 extern mat4 mat4_multiply(const mat4 a, const mat4 b);
 
+/**
+ * 単位行列をresultへ書き込む
+ */
+extern void mat4_identity_to(mat4 *result);
+
+/**
+ * 行列mの転置をresultへ書き込む
+ * resultとmは同じ行列を指してもよい。
+ */
+extern void mat4_transpose_to(mat4 *result, const mat4 *m);
+
+/**
+ * 移動行列をresultへ書き込む
+ */
+extern void mat4_translate_to(mat4 *result, const GLfloat x, const GLfloat y, const GLfloat z);
+
+/**
+ * 拡縮行列をresultへ書き込む
+ */
+extern void mat4_scale_to(mat4 *result, const GLfloat x, const GLfloat y, const GLfloat z);
+
+/**
+ * 回転行列をresultへ書き込む
+ */
+extern void mat4_rotate_to(mat4 *result, const vec3 *axis, const GLfloat rotate);
+
+/**
+ * 正射影行列をresultへ書き込む。
+ * 視錐台の左右・下上・手前奥を指定し、glOrthoと同じ行列を生成する。
+ */
+extern void mat4_ortho_to(mat4 *result, const GLfloat left, const GLfloat right, const GLfloat bottom, const GLfloat top, const GLfloat near, const GLfloat far);
+
+/**
+ * 透視射影行列をresultへ書き込む。
+ * fovyは垂直方向の画角(360度系)で、gluPerspectiveと同じ行列を生成する。
+ */
+extern void mat4_perspective_to(mat4 *result, const GLfloat fovy, const GLfloat aspect, const GLfloat near, const GLfloat far);
+
+/**
+ * eyeからtargetを向くビュー行列をresultへ書き込む。
+ * gluLookAtと同じ行列を生成する。
+ */
+extern void mat4_lookAt_to(mat4 *result, const vec3 *eye, const vec3 *target, const vec3 *up);
+
+/**
+ * 行列A×行列Bをresultへ書き込む。
+ * NEON/SSEが利用できる場合はSIMD命令で計算する。
+ * resultはa、bのどちらと同じ行列を指してもよい。
+ */
+extern void mat4_multiply_to(mat4 *result, const mat4 *a, const mat4 *b);
+
+/**
+ * vec2配列の各要素を(x, y, 0, 1)として行列で変換し、dstへx/yを書き込む。
+ *
+ * 以下のバッチ変換関数は共通して次の性質を持つ。
+ * ・srcとdstは同じ配列を指してもよい（その場で変換される）。
+ * ・内部状態を持たないため、配列を範囲ごとに分割すれば複数スレッドから同時に呼び出せる。
+ * ・射影後のwによる除算は行わない。
+ */
+extern void mat4_transformVec2Array(const mat4 *m, const vec2 *src, vec2 *dst, const int num);
+
+/**
+ * vec3配列の各要素を(x, y, z, 1)として行列で変換し、dstへx/y/zを書き込む。
+ */
+extern void mat4_transformVec3Array(const mat4 *m, const vec3 *src, vec3 *dst, const int num);
+
+/**
+ * vec4配列の各要素を行列で変換する。
+ */
+extern void mat4_transformVec4Array(const mat4 *m, const vec4 *src, vec4 *dst, const int num);
+
+/**
+ * vec2配列のi番目の要素をmatrices[matrix_indices[i]]で変換する。
+ * 同じインデックスが連続する場合、行列の読み込みは1度だけ行われる。
+ */
+extern void mat4_transformVec2ArrayIndexed(const mat4 *matrices, const int *matrix_indices, const vec2 *src, vec2 *dst, const int num);
+
+/**
+ * vec3配列のi番目の要素をmatrices[matrix_indices[i]]で変換する。
+ */
+extern void mat4_transformVec3ArrayIndexed(const mat4 *matrices, const int *matrix_indices, const vec3 *src, vec3 *dst, const int num);
+
+/**
+ * vec4配列のi番目の要素をmatrices[matrix_indices[i]]で変換する。
+ */
+extern void mat4_transformVec4ArrayIndexed(const mat4 *matrices, const int *matrix_indices, const vec4 *src, vec4 *dst, const int num);
+
+/**
+ * SoA形式の頂点配列を行列で変換する。
+ * 4要素ずつSIMD命令で計算するため、AoS形式より高速に変換できる。
+ */
+extern void mat4_transformSoA(const mat4 *m, const vec_soa *src, const vec_soa *dst, const int num);
+
+/**
+ * SoA形式の頂点配列のi番目の要素をmatrices[matrix_indices[i]]で変換する。
+ * 同じインデックスが連続する区間ごとにまとめて計算する。
+ */
+extern void mat4_transformSoAIndexed(const mat4 *matrices, const int *matrix_indices, const vec_soa *src, const vec_soa *dst, const int num);
+
+/**
+ * 単位行列をresultへ書き込む
+ */
+extern void mat2x3_identity_to(mat2x3 *result);
+
+/**
+ * アフィン行列A×アフィン行列Bをresultへ書き込む。
+ * mat4_multiply_to()と同じく、頂点に対しB→Aの順番で適用することになる。
+ * resultはa、bのどちらと同じ行列を指してもよい。
+ */
+extern void mat2x3_multiply_to(mat2x3 *result, const mat2x3 *a, const mat2x3 *b);
+
+/**
+ * アフィン行列をmat4へ展開する。
+ * Z軸は変換されず(m[2][2] == 1)、W軸は1のまま維持される。
+ */
+extern void mat4_fromMat2x3(mat4 *result, const mat2x3 *affine);
+
+/**
+ * 単位クォータニオン（無回転）をresultへ書き込む
+ */
+extern void quat_identity_to(quat *result);
+
+/**
+ * 正規化済みの回転軸と回転角(360度系)からクォータニオンを生成する。
+ * mat4_fromQuat()で展開した行列はmat4_rotate()と同じ回転になる。
+ */
+extern void quat_fromAxisAngle(quat *result, const vec3 *axis, const GLfloat rotate);
+
+/**
+ * クォータニオンA×クォータニオンBをresultへ書き込む。
+ * 行列と同じく、B→Aの順番で回転を適用することになる。
+ * 毎フレームの回転量を事前に生成しておき、乗算で積み上げれば三角関数を呼ばずに回転を更新できる。
+ * resultはa、bのどちらと同じクォータニオンを指してもよい。
+ */
+extern void quat_multiply_to(quat *result, const quat *a, const quat *b);
+
+/**
+ * クォータニオンの内積を計算する
+ */
+extern GLfloat quat_dot(const quat *a, const quat *b);
+
+/**
+ * 正規化したクォータニオンをresultへ書き込む。
+ * 乗算を積み重ねると誤差で長さが1からずれるため、定期的に正規化する。
+ */
+extern void quat_normalize_to(quat *result, const quat *q);
+
+/**
+ * a→bをtで線形補間し、正規化してresultへ書き込む。
+ * 三角関数を使わないため、キーフレーム間の補間を毎フレーム安価に行える。
+ */
+extern void quat_nlerp_to(quat *result, const quat *a, const quat *b, const GLfloat t);
+
+/**
+ * a→bをtで球面線形補間してresultへ書き込む。
+ * 角速度が一定になるが、acos/sinを利用する。角度が十分小さい場合はnlerpで代用する。
+ */
+extern void quat_slerp_to(quat *result, const quat *a, const quat *b, const GLfloat t);
+
+/**
+ * 正規化済みのクォータニオンから回転行列を生成する
+ */
+extern void mat4_fromQuat(mat4 *result, const quat *q);
+
+/**
+ * 移動 <- 任意軸回転 <- 拡縮の順で適用する行列を生成する。
+ * mat4_multiply(mat4_multiply(translate, rotate), scale)と同じ行列を、0になる項を省いて計算する。
+ * C++からはsupport_gl_Vector_Trs.hppの式テンプレートを直接利用できる。
+ */
+extern void mat4_createTRS(mat4 *result, const vec3 *translate, const vec3 *axis, const GLfloat rotate, const vec3 *scale);
+
+/**
+ * 移動 <- Z軸回転 <- 拡縮の順で適用する行列を生成する。
+ * 2Dの描画で利用する形で、mat4_createTRS()よりさらに少ない計算で済む。
+ */
+extern void mat4_createTRSZ(mat4 *result, const GLfloat translate_x, const GLfloat translate_y, const GLfloat translate_z, const GLfloat rotate, const GLfloat scale_x, const GLfloat scale_y, const GLfloat scale_z);
+
+/**
+ * 拡縮 <- Z軸回転 <- 移動の順で適用する行列を生成する。
+ */
+extern void mat4_createSRTZ(mat4 *result, const GLfloat scale_x, const GLfloat scale_y, const GLfloat scale_z, const GLfloat rotate, const GLfloat translate_x, const GLfloat translate_y, const GLfloat translate_z);
+
+/**
+ * trig_sincos()の精度を設定する。
+ * TRIG_PRECISION_LIBMかTRIG_PRECISION_FASTを指定する。
+ */
+extern void trig_setPrecision(const int precision);
+
+/**
+ * trig_sincos()の精度を取得する
+ */
+extern int trig_getPrecision();
+
+/**
+ * 角度(360度系)のsin/cosを同時に計算する。
+ * trig_setPrecision()で指定した精度で計算され、mat4_rotate()等の回転行列の生成に利用される。
+ */
+extern void trig_sincos(const GLfloat degree, GLfloat *sin_result, GLfloat *cos_result);
+
+/**
+ * 角度(360度系)のsin/cosを多項式近似で同時に計算する。
+ * 90度単位で[-45, 45]度へ縮小してからミニマックス多項式で近似する。
+ * 最大誤差は±3600度の範囲で1e-7未満（libmのdouble計算との差）となる。
+ * 角度が大きくなるほど縮小時の誤差が増えるため、回転角は適度に丸めて保持すること。
+ */
+extern void trig_sincosFast(const GLfloat degree, GLfloat *sin_result, GLfloat *cos_result);
+
+/**
+ * 配列の各角度(360度系)のsin/cosを多項式近似でまとめて計算する。
+ * NEON/SSE2が利用できる場合は4要素ずつ計算し、結果はtrig_sincosFast()と同じ精度になる。
+ */
+extern void trig_sincosFastArray(const GLfloat *degrees, GLfloat *sin_result, GLfloat *cos_result, const int num);
+
 #endif /* SUPPORT_GL_MATRIX_H_ */
@@ -0,0 +1,254 @@
+/*
+ * support_gl_Vector_Batch.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+#include    "support_gl_Vector_Simd.h"
+
+/**
+ * AoS配列を変換する。
+ * componentsは2(vec2)/3(vec3)/4(vec4)のいずれかで、不足する成分はz=0、w=1として扱う。
+ * matrix_indicesがNULLの場合、全要素をmatrices[0]で変換する。
+ */
+static void mat4_transformAoS(const mat4 *matrices, const int *matrix_indices, const GLfloat *src, GLfloat *dst, const int components, const int num) {
+    const mat4 *m = NULL;
+    int current = -1;
+    int i = 0;
+#if defined(VECTOR_SIMD_NEON) || defined(VECTOR_SIMD_SSE)
+    simd4 c0, c1, c2, c3;
+#endif
+
+    assert(matrices);
+    assert(components >= 2 && components <= 4);
+
+    if (num <= 0) {
+        return;
+    }
+
+    // 先頭要素の行列を読み込んでおき、ループ内では切り替わった時だけ読み直す
+    current = matrix_indices ? matrix_indices[0] : 0;
+    m = matrices + current;
+#if defined(VECTOR_SIMD_NEON) || defined(VECTOR_SIMD_SSE)
+    c0 = simd4_load(m->m[0]);
+    c1 = simd4_load(m->m[1]);
+    c2 = simd4_load(m->m[2]);
+    c3 = simd4_load(m->m[3]);
+#endif
+
+    for (i = 0; i < num; ++i) {
+        const int index = matrix_indices ? matrix_indices[i] : 0;
+        const GLfloat *v = src + (i * components);
+        GLfloat *r = dst + (i * components);
+
+        const GLfloat x = v[0];
+        const GLfloat y = v[1];
+        const GLfloat z = components > 2 ? v[2] : 0.0f;
+        const GLfloat w = components > 3 ? v[3] : 1.0f;
+
+        // 行列が切り替わった時だけ列を読み直す
+        if (index != current) {
+            current = index;
+            m = matrices + index;
+#if defined(VECTOR_SIMD_NEON) || defined(VECTOR_SIMD_SSE)
+            c0 = simd4_load(m->m[0]);
+            c1 = simd4_load(m->m[1]);
+            c2 = simd4_load(m->m[2]);
+            c3 = simd4_load(m->m[3]);
+#endif
+        }
+
+#if defined(VECTOR_SIMD_NEON) || defined(VECTOR_SIMD_SSE)
+        {
+            simd4 t = simd4_muls(c0, x);
+            t = simd4_madds(t, c1, y);
+            t = simd4_madds(t, c2, z);
+            t = simd4_madds(t, c3, w);
+
+            if (components == 4) {
+                simd4_store(r, t);
+            } else {
+                GLfloat temp[4];
+                simd4_store(temp, t);
+                r[0] = temp[0];
+                r[1] = temp[1];
+                if (components == 3) {
+                    r[2] = temp[2];
+                }
+            }
+        }
+#else
+        r[0] = m->m[0][0] * x + m->m[1][0] * y + m->m[2][0] * z + m->m[3][0] * w;
+        r[1] = m->m[0][1] * x + m->m[1][1] * y + m->m[2][1] * z + m->m[3][1] * w;
+        if (components > 2) {
+            r[2] = m->m[0][2] * x + m->m[1][2] * y + m->m[2][2] * z + m->m[3][2] * w;
+        }
+        if (components > 3) {
+            r[3] = m->m[0][3] * x + m->m[1][3] * y + m->m[2][3] * z + m->m[3][3] * w;
+        }
+#endif
+    }
+}
+
+/**
+ * SoA配列の1要素を変換する
+ */
+static void mat4_transformSoAElement(const mat4 *m, const vec_soa *src, const vec_soa *dst, const int i) {
+    const GLfloat x = src->x[i];
+    const GLfloat y = src->y[i];
+    const GLfloat z = src->z ? src->z[i] : 0.0f;
+    const GLfloat w = src->w ? src->w[i] : 1.0f;
+
+    // 全成分を読み込んでから書き込むため、src == dstでも問題ない
+    const GLfloat rx = m->m[0][0] * x + m->m[1][0] * y + m->m[2][0] * z + m->m[3][0] * w;
+    const GLfloat ry = m->m[0][1] * x + m->m[1][1] * y + m->m[2][1] * z + m->m[3][1] * w;
+    const GLfloat rz = m->m[0][2] * x + m->m[1][2] * y + m->m[2][2] * z + m->m[3][2] * w;
+    const GLfloat rw = m->m[0][3] * x + m->m[1][3] * y + m->m[2][3] * z + m->m[3][3] * w;
+
+    dst->x[i] = rx;
+    dst->y[i] = ry;
+    if (dst->z) {
+        dst->z[i] = rz;
+    }
+    if (dst->w) {
+        dst->w[i] = rw;
+    }
+}
+
+/**
+ * SoA配列の[begin, end)を同じ行列で変換する。
+ * 4要素ずつ各成分をSIMDレジスタに並べ、行列の要素をブロードキャストして計算する。
+ */
+static void mat4_transformSoARange(const mat4 *m, const vec_soa *src, const vec_soa *dst, int begin, const int end) {
+#if defined(VECTOR_SIMD_NEON) || defined(VECTOR_SIMD_SSE)
+    const simd4 zero = simd4_set1(0.0f);
+    const simd4 one = simd4_set1(1.0f);
+
+    for (; (begin + 4) <= end; begin += 4) {
+        const simd4 x = simd4_load(src->x + begin);
+        const simd4 y = simd4_load(src->y + begin);
+        const simd4 z = src->z ? simd4_load(src->z + begin) : zero;
+        const simd4 w = src->w ? simd4_load(src->w + begin) : one;
+
+        simd4 rx = simd4_muls(x, m->m[0][0]);
+        simd4 ry = simd4_muls(x, m->m[0][1]);
+        rx = simd4_madds(rx, y, m->m[1][0]);
+        ry = simd4_madds(ry, y, m->m[1][1]);
+        rx = simd4_madds(rx, z, m->m[2][0]);
+        ry = simd4_madds(ry, z, m->m[2][1]);
+        rx = simd4_madds(rx, w, m->m[3][0]);
+        ry = simd4_madds(ry, w, m->m[3][1]);
+
+        if (dst->z) {
+            simd4 rz = simd4_muls(x, m->m[0][2]);
+            rz = simd4_madds(rz, y, m->m[1][2]);
+            rz = simd4_madds(rz, z, m->m[2][2]);
+            rz = simd4_madds(rz, w, m->m[3][2]);
+            simd4_store(dst->z + begin, rz);
+        }
+        if (dst->w) {
+            simd4 rw = simd4_muls(x, m->m[0][3]);
+            rw = simd4_madds(rw, y, m->m[1][3]);
+            rw = simd4_madds(rw, z, m->m[2][3]);
+            rw = simd4_madds(rw, w, m->m[3][3]);
+            simd4_store(dst->w + begin, rw);
+        }
+        simd4_store(dst->x + begin, rx);
+        simd4_store(dst->y + begin, ry);
+    }
+#endif
+
+    // 端数を処理する
+    for (; begin < end; ++begin) {
+        mat4_transformSoAElement(m, src, dst, begin);
+    }
+}
+
+/**
+ * SoA配列を変換する。
+ * 同じ行列インデックスが連続する区間ごとにまとめて計算する。
+ */
+static void mat4_transformSoAImpl(const mat4 *matrices, const int *matrix_indices, const vec_soa *src, const vec_soa *dst, const int num) {
+    int begin = 0;
+
+    assert(matrices);
+    assert(src && src->x && src->y);
+    assert(dst && dst->x && dst->y);
+
+    if (!matrix_indices) {
+        mat4_transformSoARange(matrices, src, dst, 0, num);
+        return;
+    }
+
+    while (begin < num) {
+        const int index = matrix_indices[begin];
+        int end = begin + 1;
+        while (end < num && matrix_indices[end] == index) {
+            ++end;
+        }
+
+        mat4_transformSoARange(matrices + index, src, dst, begin, end);
+        begin = end;
+    }
+}
+
+/**
+ * vec2配列を行列で変換する
+ */
+void mat4_transformVec2Array(const mat4 *m, const vec2 *src, vec2 *dst, const int num) {
+    mat4_transformAoS(m, NULL, (const GLfloat*) src, (GLfloat*) dst, 2, num);
+}
+
+/**
+ * vec3配列を行列で変換する
+ */
+void mat4_transformVec3Array(const mat4 *m, const vec3 *src, vec3 *dst, const int num) {
+    mat4_transformAoS(m, NULL, (const GLfloat*) src, (GLfloat*) dst, 3, num);
+}
+
+/**
+ * vec4配列を行列で変換する
+ */
+void mat4_transformVec4Array(const mat4 *m, const vec4 *src, vec4 *dst, const int num) {
+    mat4_transformAoS(m, NULL, (const GLfloat*) src, (GLfloat*) dst, 4, num);
+}
+
+/**
+ * vec2配列を要素ごとに指定した行列で変換する
+ */
+void mat4_transformVec2ArrayIndexed(const mat4 *matrices, const int *matrix_indices, const vec2 *src, vec2 *dst, const int num) {
+    assert(matrix_indices);
+    mat4_transformAoS(matrices, matrix_indices, (const GLfloat*) src, (GLfloat*) dst, 2, num);
+}
+
+/**
+ * vec3配列を要素ごとに指定した行列で変換する
+ */
+void mat4_transformVec3ArrayIndexed(const mat4 *matrices, const int *matrix_indices, const vec3 *src, vec3 *dst, const int num) {
+    assert(matrix_indices);
+    mat4_transformAoS(matrices, matrix_indices, (const GLfloat*) src, (GLfloat*) dst, 3, num);
+}
+
+/**
+ * vec4配列を要素ごとに指定した行列で変換する
+ */
+void mat4_transformVec4ArrayIndexed(const mat4 *matrices, const int *matrix_indices, const vec4 *src, vec4 *dst, const int num) {
+    assert(matrix_indices);
+    mat4_transformAoS(matrices, matrix_indices, (const GLfloat*) src, (GLfloat*) dst, 4, num);
+}
+
+/**
+ * SoA形式の頂点配列を行列で変換する
+ */
+void mat4_transformSoA(const mat4 *m, const vec_soa *src, const vec_soa *dst, const int num) {
+    mat4_transformSoAImpl(m, NULL, src, dst, num);
+}
+
+/**
+ * SoA形式の頂点配列を要素ごとに指定した行列で変換する
+ */
+void mat4_transformSoAIndexed(const mat4 *matrices, const int *matrix_indices, const vec_soa *src, const vec_soa *dst, const int num) {
+    assert(matrix_indices);
+    mat4_transformSoAImpl(matrices, matrix_indices, src, dst, num);
+}
@@ -0,0 +1,205 @@
+/*
+ * support_gl_Vector_Quat.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+#include    "support_gl_Vector_Simd.h"
+
+/**
+ * この値よりも2つのクォータニオンが近い場合、slerpの代わりにnlerpで補間する
+ */
+#define QUAT_SLERP_THRESHOLD    0.9995f
+
+/**
+ * 単位クォータニオンをresultへ書き込む
+ */
+void quat_identity_to(quat *result) {
+    result->x = 0.0f;
+    result->y = 0.0f;
+    result->z = 0.0f;
+    result->w = 1.0f;
+}
+
+/**
+ * 回転軸と回転角からクォータニオンを生成する
+ * mat4_rotate()と同じ回転方向になるよう、角度の符号を反転して半角を求める。
+ */
+void quat_fromAxisAngle(quat *result, const vec3 *axis, const GLfloat rotate) {
+    GLfloat s;
+    GLfloat c;
+    trig_sincos(-rotate * 0.5f, &s, &c);
+
+    result->x = axis->x * s;
+    result->y = axis->y * s;
+    result->z = axis->z * s;
+    result->w = c;
+}
+
+/**
+ * クォータニオンA×クォータニオンBをresultへ書き込む
+ *
+ * (x, y, z, w)の並びに対し、
+ * aw * ( bx,  by,  bz,  bw)
+ * ax * ( bw, -bz,  by, -bx)
+ * ay * ( bz,  bw, -bx, -by)
+ * az * (-by,  bx,  bw, -bz)
+ * の和として計算する。
+ */
+void quat_multiply_to(quat *result, const quat *a, const quat *b) {
+#if defined(VECTOR_SIMD_NEON)
+    static const float sign_x[4] = { 1.0f, -1.0f, 1.0f, -1.0f };
+    static const float sign_y[4] = { 1.0f, 1.0f, -1.0f, -1.0f };
+    static const float sign_z[4] = { -1.0f, 1.0f, 1.0f, -1.0f };
+
+    const float32x4_t vb = vld1q_f32(&b->x);
+    // (bz, bw, bx, by)
+    const float32x4_t b_zwxy = vcombine_f32(vget_high_f32(vb), vget_low_f32(vb));
+    // (bw, bz, by, bx)
+    const float32x4_t b_wzyx = vrev64q_f32(b_zwxy);
+    // (by, bx, bw, bz)
+    const float32x4_t b_yxwz = vrev64q_f32(vb);
+
+    float32x4_t r = vmulq_n_f32(vb, a->w);
+    r = vmlaq_n_f32(r, vmulq_f32(b_wzyx, vld1q_f32(sign_x)), a->x);
+    r = vmlaq_n_f32(r, vmulq_f32(b_zwxy, vld1q_f32(sign_y)), a->y);
+    r = vmlaq_n_f32(r, vmulq_f32(b_yxwz, vld1q_f32(sign_z)), a->z);
+    vst1q_f32(&result->x, r);
+#elif defined(VECTOR_SIMD_SSE)
+    const __m128 vb = _mm_loadu_ps(&b->x);
+    const __m128 b_wzyx = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(0, 1, 2, 3));
+    const __m128 b_zwxy = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(1, 0, 3, 2));
+    const __m128 b_yxwz = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 3, 0, 1));
+
+    __m128 r = _mm_mul_ps(vb, _mm_set1_ps(a->w));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(b_wzyx, _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f)), _mm_set1_ps(a->x)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(b_zwxy, _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f)), _mm_set1_ps(a->y)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(b_yxwz, _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f)), _mm_set1_ps(a->z)));
+    _mm_storeu_ps(&result->x, r);
+#else
+    const GLfloat ax = a->x, ay = a->y, az = a->z, aw = a->w;
+    const GLfloat bx = b->x, by = b->y, bz = b->z, bw = b->w;
+
+    result->x = aw * bx + ax * bw + ay * bz - az * by;
+    result->y = aw * by - ax * bz + ay * bw + az * bx;
+    result->z = aw * bz + ax * by - ay * bx + az * bw;
+    result->w = aw * bw - ax * bx - ay * by - az * bz;
+#endif
+}
+
+/**
+ * クォータニオンの内積を計算する
+ */
+GLfloat quat_dot(const quat *a, const quat *b) {
+    return (a->x * b->x) + (a->y * b->y) + (a->z * b->z) + (a->w * b->w);
+}
+
+/**
+ * 正規化したクォータニオンをresultへ書き込む
+ */
+void quat_normalize_to(quat *result, const quat *q) {
+    const GLfloat len = sqrtf(quat_dot(q, q));
+    const GLfloat inv = len > 0.0f ? 1.0f / len : 0.0f;
+
+    result->x = q->x * inv;
+    result->y = q->y * inv;
+    result->z = q->z * inv;
+    result->w = q->w * inv;
+}
+
+/**
+ * a * wa + b * wbを計算する
+ */
+static void quat_blend(quat *result, const quat *a, const GLfloat wa, const quat *b, const GLfloat wb) {
+#if defined(VECTOR_SIMD_NEON)
+    float32x4_t r = vmulq_n_f32(vld1q_f32(&a->x), wa);
+    r = vmlaq_n_f32(r, vld1q_f32(&b->x), wb);
+    vst1q_f32(&result->x, r);
+#elif defined(VECTOR_SIMD_SSE)
+    const __m128 r = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&a->x), _mm_set1_ps(wa)), _mm_mul_ps(_mm_loadu_ps(&b->x), _mm_set1_ps(wb)));
+    _mm_storeu_ps(&result->x, r);
+#else
+    result->x = a->x * wa + b->x * wb;
+    result->y = a->y * wa + b->y * wb;
+    result->z = a->z * wa + b->z * wb;
+    result->w = a->w * wa + b->w * wb;
+#endif
+}
+
+/**
+ * クォータニオンを線形補間し、正規化してresultへ書き込む
+ */
+void quat_nlerp_to(quat *result, const quat *a, const quat *b, const GLfloat t) {
+    // 逆向きのクォータニオンは同じ回転を表すため、近い方の経路を選ぶ
+    const GLfloat wb = quat_dot(a, b) < 0.0f ? -t : t;
+
+    quat_blend(result, a, 1.0f - t, b, wb);
+    quat_normalize_to(result, result);
+}
+
+/**
+ * クォータニオンを球面線形補間してresultへ書き込む
+ */
+void quat_slerp_to(quat *result, const quat *a, const quat *b, const GLfloat t) {
+    GLfloat dot = quat_dot(a, b);
+    GLfloat sign = 1.0f;
+
+    if (dot < 0.0f) {
+        dot = -dot;
+        sign = -1.0f;
+    }
+
+    // 角度が十分に小さい場合、sinθによる除算が不安定になるためnlerpで代用する
+    if (dot > QUAT_SLERP_THRESHOLD) {
+        quat_nlerp_to(result, a, b, t);
+        return;
+    }
+
+    {
+        const GLfloat theta = acosf(dot);
+        const GLfloat inv_sin = 1.0f / sinf(theta);
+        const GLfloat wa = sinf((1.0f - t) * theta) * inv_sin;
+        const GLfloat wb = sinf(t * theta) * inv_sin * sign;
+
+        quat_blend(result, a, wa, b, wb);
+    }
+}
+
+/**
+ * 正規化済みのクォータニオンから回転行列を生成する
+ */
+void mat4_fromQuat(mat4 *result, const quat *q) {
+    const GLfloat x2 = q->x + q->x;
+    const GLfloat y2 = q->y + q->y;
+    const GLfloat z2 = q->z + q->z;
+
+    const GLfloat xx = q->x * x2, yy = q->y * y2, zz = q->z * z2;
+    const GLfloat xy = q->x * y2, xz = q->x * z2, yz = q->y * z2;
+    const GLfloat wx = q->w * x2, wy = q->w * y2, wz = q->w * z2;
+
+    {
+        result->m[0][0] = 1.0f - (yy + zz);
+        result->m[0][1] = xy + wz;
+        result->m[0][2] = xz - wy;
+        result->m[0][3] = 0;
+    }
+    {
+        result->m[1][0] = xy - wz;
+        result->m[1][1] = 1.0f - (xx + zz);
+        result->m[1][2] = yz + wx;
+        result->m[1][3] = 0;
+    }
+    {
+        result->m[2][0] = xz + wy;
+        result->m[2][1] = yz - wx;
+        result->m[2][2] = 1.0f - (xx + yy);
+        result->m[2][3] = 0;
+    }
+    {
+        result->m[3][0] = 0;
+        result->m[3][1] = 0;
+        result->m[3][2] = 0;
+        result->m[3][3] = 1;
+    }
+}
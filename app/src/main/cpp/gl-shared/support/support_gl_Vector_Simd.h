@@ -0,0 +1,51 @@
+/*
+ * support_gl_Vector_Simd.h
+ *
+ *  Created on: 2026/10/19
+ */
+
+#ifndef SUPPORT_GL_VECTOR_SIMD_H_
+#define SUPPORT_GL_VECTOR_SIMD_H_
+
+/**
+ * SIMD命令を利用する実装ファイル向けの内部ヘッダ
+ * support.hからは読み込まず、必要な.cファイルのみが読み込む。
+ *
+ * VECTOR_SIMD_NEON : ARM NEONを利用できる
+ * VECTOR_SIMD_SSE  : x86 SSEを利用できる
+ * VECTOR_SIMD_SSE2 : x86 SSE2(整数演算)を利用できる
+ * いずれも定義されない場合、呼び出し側はスカラー実装を利用する。
+ */
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include    <arm_neon.h>
+#define VECTOR_SIMD_NEON
+#elif defined(__SSE__)
+#include    <xmmintrin.h>
+#define VECTOR_SIMD_SSE
+#if defined(__SSE2__)
+#include    <emmintrin.h>
+#define VECTOR_SIMD_SSE2
+#endif
+#endif
+
+/**
+ * float 4要素のレジスタと基本演算
+ * simd4_muls / simd4_madds はベクトルの全要素にスカラーを掛ける。
+ */
+#if defined(VECTOR_SIMD_NEON)
+typedef float32x4_t simd4;
+#define simd4_load(ptr)                     vld1q_f32(ptr)
+#define simd4_store(ptr, v)                 vst1q_f32(ptr, v)
+#define simd4_set1(s)                       vdupq_n_f32(s)
+#define simd4_muls(v, s)                    vmulq_n_f32(v, s)
+#define simd4_madds(acc, v, s)              vmlaq_n_f32(acc, v, s)
+#elif defined(VECTOR_SIMD_SSE)
+typedef __m128 simd4;
+#define simd4_load(ptr)                     _mm_loadu_ps(ptr)
+#define simd4_store(ptr, v)                 _mm_storeu_ps(ptr, v)
+#define simd4_set1(s)                       _mm_set1_ps(s)
+#define simd4_muls(v, s)                    _mm_mul_ps(v, _mm_set1_ps(s))
+#define simd4_madds(acc, v, s)              _mm_add_ps(acc, _mm_mul_ps(v, _mm_set1_ps(s)))
+#endif
+
+#endif /* SUPPORT_GL_VECTOR_SIMD_H_ */
@@ -0,0 +1,200 @@
+/*
+ * support_gl_Vector_Trig.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+#include    "support_gl_Vector_Simd.h"
+
+/**
+ * 90度を1象限として扱う
+ */
+#define TRIG_QUADRANT_DEGREE    90.0f
+
+/**
+ * 象限内の角度(度)をラジアンへ変換する係数
+ */
+#define TRIG_DEGREE_TO_RADIAN   0.017453292519943295f
+
+/**
+ * [-π/4, π/4]でのsinの近似係数（ミニマックス近似）
+ */
+#define TRIG_SIN_C3             -1.6666654611e-1f
+#define TRIG_SIN_C5             8.3321608736e-3f
+#define TRIG_SIN_C7             -1.9515295891e-4f
+
+/**
+ * [-π/4, π/4]でのcosの近似係数（ミニマックス近似）
+ */
+#define TRIG_COS_C4             4.166664568298827e-2f
+#define TRIG_COS_C6             -1.388731625493765e-3f
+#define TRIG_COS_C8             2.443315711809948e-5f
+
+/**
+ * trig_sincos()が利用する精度
+ */
+static int trig_precision = TRIG_PRECISION_DEFAULT;
+
+/**
+ * trig_sincos()の精度を設定する
+ */
+void trig_setPrecision(const int precision) {
+    assert(precision == TRIG_PRECISION_LIBM || precision == TRIG_PRECISION_FAST);
+    trig_precision = precision;
+}
+
+/**
+ * trig_sincos()の精度を取得する
+ */
+int trig_getPrecision() {
+    return trig_precision;
+}
+
+/**
+ * 最も近い象限の番号を求める
+ */
+static int trig_quadrant(const GLfloat degree) {
+    const GLfloat q = degree * (1.0f / TRIG_QUADRANT_DEGREE);
+    return (int) (q >= 0.0f ? q + 0.5f : q - 0.5f);
+}
+
+/**
+ * 多項式近似でsin/cosを同時に計算する
+ */
+void trig_sincosFast(const GLfloat degree, GLfloat *sin_result, GLfloat *cos_result) {
+    // 象限を求め、[-45, 45]度の範囲へ縮小する
+    const int quadrant = trig_quadrant(degree);
+    const GLfloat x = (degree - (GLfloat) quadrant * TRIG_QUADRANT_DEGREE) * TRIG_DEGREE_TO_RADIAN;
+    const GLfloat z = x * x;
+
+    const GLfloat s = ((TRIG_SIN_C7 * z + TRIG_SIN_C5) * z + TRIG_SIN_C3) * z * x + x;
+    const GLfloat c = ((TRIG_COS_C8 * z + TRIG_COS_C6) * z + TRIG_COS_C4) * z * z - 0.5f * z + 1.0f;
+
+    // 象限に合わせてsin/cosを入れ替え、符号を決める
+    switch (quadrant & 3) {
+        case 0:
+            (*sin_result) = s;
+            (*cos_result) = c;
+            break;
+        case 1:
+            (*sin_result) = c;
+            (*cos_result) = -s;
+            break;
+        case 2:
+            (*sin_result) = -s;
+            (*cos_result) = -c;
+            break;
+        default:
+            (*sin_result) = -c;
+            (*cos_result) = s;
+            break;
+    }
+}
+
+/**
+ * 多項式近似で配列のsin/cosをまとめて計算する。
+ * 4要素ずつSIMD命令で計算する。
+ */
+void trig_sincosFastArray(const GLfloat *degrees, GLfloat *sin_result, GLfloat *cos_result, const int num) {
+    int i = 0;
+
+#if defined(VECTOR_SIMD_NEON)
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const uint32x4_t sign_mask = vdupq_n_u32(0x80000000);
+    const int32x4_t one = vdupq_n_s32(1);
+    const int32x4_t two = vdupq_n_s32(2);
+
+    for (; (i + 4) <= num; i += 4) {
+        const float32x4_t degree = vld1q_f32(degrees + i);
+
+        // 象限を四捨五入で求める（0.5へ角度の符号を付けてから切り捨てる）
+        const float32x4_t q = vmulq_n_f32(degree, 1.0f / TRIG_QUADRANT_DEGREE);
+        const float32x4_t rounding = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(half), vandq_u32(vreinterpretq_u32_f32(q), sign_mask)));
+        const int32x4_t quadrant = vcvtq_s32_f32(vaddq_f32(q, rounding));
+
+        const float32x4_t x = vmulq_n_f32(vmlsq_n_f32(degree, vcvtq_f32_s32(quadrant), TRIG_QUADRANT_DEGREE), TRIG_DEGREE_TO_RADIAN);
+        const float32x4_t z = vmulq_f32(x, x);
+
+        float32x4_t s = vmlaq_n_f32(vdupq_n_f32(TRIG_SIN_C5), z, TRIG_SIN_C7);
+        s = vmlaq_f32(vdupq_n_f32(TRIG_SIN_C3), s, z);
+        s = vmlaq_f32(x, vmulq_f32(s, z), x);
+
+        float32x4_t c = vmlaq_n_f32(vdupq_n_f32(TRIG_COS_C6), z, TRIG_COS_C8);
+        c = vmlaq_f32(vdupq_n_f32(TRIG_COS_C4), c, z);
+        c = vmulq_f32(vmulq_f32(c, z), z);
+        c = vaddq_f32(vmlsq_f32(c, half, z), vdupq_n_f32(1.0f));
+
+        {
+            // 奇数象限はsin/cosを入れ替える
+            const uint32x4_t swap = vtstq_s32(quadrant, one);
+            // sinは象限2,3、cosは象限1,2で符号が反転する
+            const uint32x4_t sin_sign = vandq_u32(vtstq_s32(quadrant, two), sign_mask);
+            const uint32x4_t cos_sign = vandq_u32(vtstq_s32(vaddq_s32(quadrant, one), two), sign_mask);
+
+            const float32x4_t rs = vbslq_f32(swap, c, s);
+            const float32x4_t rc = vbslq_f32(swap, s, c);
+
+            vst1q_f32(sin_result + i, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(rs), sin_sign)));
+            vst1q_f32(cos_result + i, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(rc), cos_sign)));
+        }
+    }
+#elif defined(VECTOR_SIMD_SSE2)
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i two = _mm_set1_epi32(2);
+
+    for (; (i + 4) <= num; i += 4) {
+        const __m128 degree = _mm_loadu_ps(degrees + i);
+
+        // 象限を四捨五入で求める（0.5へ角度の符号を付けてから切り捨てる）
+        const __m128 q = _mm_mul_ps(degree, _mm_set1_ps(1.0f / TRIG_QUADRANT_DEGREE));
+        const __m128 rounding = _mm_or_ps(half, _mm_and_ps(q, sign_mask));
+        const __m128i quadrant = _mm_cvttps_epi32(_mm_add_ps(q, rounding));
+
+        const __m128 x = _mm_mul_ps(_mm_sub_ps(degree, _mm_mul_ps(_mm_cvtepi32_ps(quadrant), _mm_set1_ps(TRIG_QUADRANT_DEGREE))), _mm_set1_ps(TRIG_DEGREE_TO_RADIAN));
+        const __m128 z = _mm_mul_ps(x, x);
+
+        __m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(TRIG_SIN_C7), z), _mm_set1_ps(TRIG_SIN_C5));
+        s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(TRIG_SIN_C3));
+        s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), x), x);
+
+        __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(TRIG_COS_C8), z), _mm_set1_ps(TRIG_COS_C6));
+        c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(TRIG_COS_C4));
+        c = _mm_mul_ps(_mm_mul_ps(c, z), z);
+        c = _mm_add_ps(_mm_sub_ps(c, _mm_mul_ps(half, z)), _mm_set1_ps(1.0f));
+
+        {
+            // 奇数象限はsin/cosを入れ替える
+            const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+            // sinは象限2,3、cosは象限1,2で符号が反転する
+            const __m128 sin_sign = _mm_and_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, two), two)), sign_mask);
+            const __m128 cos_sign = _mm_and_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), two)), sign_mask);
+
+            const __m128 rs = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+            const __m128 rc = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+
+            _mm_storeu_ps(sin_result + i, _mm_xor_ps(rs, sin_sign));
+            _mm_storeu_ps(cos_result + i, _mm_xor_ps(rc, cos_sign));
+        }
+    }
+#endif
+
+    // 端数を処理する
+    for (; i < num; ++i) {
+        trig_sincosFast(degrees[i], sin_result + i, cos_result + i);
+    }
+}
+
+/**
+ * trig_setPrecision()で指定した精度でsin/cosを計算する
+ */
+void trig_sincos(const GLfloat degree, GLfloat *sin_result, GLfloat *cos_result) {
+    if (trig_precision == TRIG_PRECISION_FAST) {
+        trig_sincosFast(degree, sin_result, cos_result);
+    } else {
+        (*sin_result) = sin(degree2radian(degree));
+        (*cos_result) = cos(degree2radian(degree));
+    }
+}
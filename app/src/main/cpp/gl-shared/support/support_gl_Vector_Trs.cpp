@@ -0,0 +1,28 @@
+/*
+ * support_gl_Vector_Trs.cpp
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support_gl_Vector_Trs.hpp"
+
+/**
+ * 移動 <- 任意軸回転 <- 拡縮の順で適用する行列を生成する
+ */
+void mat4_createTRS(mat4 *result, const vec3 *translate, const vec3 *axis, const GLfloat rotate, const vec3 *scale) {
+    trs::store(result, trs::Translate(translate->x, translate->y, translate->z) * trs::Rotate(*axis, rotate) * trs::Scale(scale->x, scale->y, scale->z));
+}
+
+/**
+ * 移動 <- Z軸回転 <- 拡縮の順で適用する行列を生成する
+ */
+void mat4_createTRSZ(mat4 *result, const GLfloat translate_x, const GLfloat translate_y, const GLfloat translate_z, const GLfloat rotate, const GLfloat scale_x, const GLfloat scale_y, const GLfloat scale_z) {
+    trs::store(result, trs::Translate(translate_x, translate_y, translate_z) * trs::RotateZ(rotate) * trs::Scale(scale_x, scale_y, scale_z));
+}
+
+/**
+ * 拡縮 <- Z軸回転 <- 移動の順で適用する行列を生成する
+ */
+void mat4_createSRTZ(mat4 *result, const GLfloat scale_x, const GLfloat scale_y, const GLfloat scale_z, const GLfloat rotate, const GLfloat translate_x, const GLfloat translate_y, const GLfloat translate_z) {
+    trs::store(result, trs::Scale(scale_x, scale_y, scale_z) * trs::RotateZ(rotate) * trs::Translate(translate_x, translate_y, translate_z));
+}
@@ -0,0 +1,302 @@
+/*
+ * support_gl_Vector_Trs.hpp
+ *
+ *  Created on: 2026/10/19
+ */
+
+#ifndef SUPPORT_GL_VECTOR_TRS_HPP_
+#define SUPPORT_GL_VECTOR_TRS_HPP_
+
+extern "C" {
+#include    "support.h"
+}
+
+#include    <type_traits>
+
+/**
+ * 移動・回転・拡縮行列の合成をコンパイル時に展開する。
+ *
+ * 各行列型は要素ごとに「常に0」「常に1」「任意の値」のどれであるかを型として持つ。
+ * 乗算は式テンプレートとして保持され、store()で評価した時点で
+ * 0になる項を除いた積和だけが生成される。
+ *
+ * 例: trs::store(&matrix, trs::Translate(x, y, 0) * trs::RotateZ(rotate) * trs::Scale(sx, sy, 1));
+ *
+ * C言語からはmat4_createTRS()等のラッパー関数を利用する。
+ */
+namespace trs {
+
+/**
+ * 行列要素の種類
+ */
+enum ElementKind {
+    /**
+     * 常に0
+     */
+    ELEMENT_ZERO = 0,
+
+    /**
+     * 常に1
+     */
+    ELEMENT_ONE = 1,
+
+    /**
+     * 実行時に決まる値
+     */
+    ELEMENT_ANY = 2,
+};
+
+/**
+ * 行列式の基底型
+ * 派生型は以下を持つ。
+ *
+ * static constexpr int kind(int column, int row);
+ * template<int C, int R> GLfloat at() const;
+ */
+struct Expression {
+};
+
+/**
+ * 行列A×行列Bを表す式
+ */
+template<class A, class B>
+struct Multiply: public Expression {
+    const A a;
+    const B b;
+
+    Multiply(const A &a, const B &b) :
+            a(a), b(b) {
+    }
+
+    /**
+     * a[k][row] * b[column][k]の項の種類
+     */
+    static constexpr int termKind(int column, int row, int k) {
+        return (A::kind(k, row) == ELEMENT_ZERO || B::kind(column, k) == ELEMENT_ZERO) ? ELEMENT_ZERO : ((A::kind(k, row) == ELEMENT_ONE && B::kind(column, k) == ELEMENT_ONE) ? ELEMENT_ONE : ELEMENT_ANY);
+    }
+
+    /**
+     * k番目以降で0にならない項の数
+     */
+    static constexpr int countNonZero(int column, int row, int k) {
+        return k == 4 ? 0 : ((termKind(column, row, k) != ELEMENT_ZERO ? 1 : 0) + countNonZero(column, row, k + 1));
+    }
+
+    /**
+     * k番目以降で1になる項の数
+     */
+    static constexpr int countOne(int column, int row, int k) {
+        return k == 4 ? 0 : ((termKind(column, row, k) == ELEMENT_ONE ? 1 : 0) + countOne(column, row, k + 1));
+    }
+
+    static constexpr int kind(int column, int row) {
+        return countNonZero(column, row, 0) == 0 ? ELEMENT_ZERO : ((countNonZero(column, row, 0) == 1 && countOne(column, row, 0) == 1) ? ELEMENT_ONE : ELEMENT_ANY);
+    }
+
+    template<int C, int R>
+    GLfloat at() const {
+        return select<C, R>(std::integral_constant<int, kind(C, R)>());
+    }
+
+private:
+    template<int C, int R>
+    GLfloat select(std::integral_constant<int, ELEMENT_ZERO>) const {
+        return 0.0f;
+    }
+
+    template<int C, int R>
+    GLfloat select(std::integral_constant<int, ELEMENT_ONE>) const {
+        return 1.0f;
+    }
+
+    template<int C, int R>
+    GLfloat select(std::integral_constant<int, ELEMENT_ANY>) const {
+        return term<C, R, 0>() + term<C, R, 1>() + term<C, R, 2>() + term<C, R, 3>();
+    }
+
+    template<int C, int R, int K>
+    GLfloat term() const {
+        return term<C, R, K>(std::integral_constant<bool, termKind(C, R, K) != ELEMENT_ZERO>());
+    }
+
+    /**
+     * 0になる項は計算しない
+     * -0.0fは加算しても値を変えないため、コンパイラが項ごと取り除く。
+     */
+    template<int C, int R, int K>
+    GLfloat term(std::false_type) const {
+        return -0.0f;
+    }
+
+    template<int C, int R, int K>
+    GLfloat term(std::true_type) const {
+        return a.template at<K, R>() * b.template at<C, K>();
+    }
+};
+
+/**
+ * 行列式同士の乗算を式テンプレートとして生成する
+ */
+template<class A, class B>
+inline typename std::enable_if<std::is_base_of<Expression, A>::value && std::is_base_of<Expression, B>::value, Multiply<A, B> >::type operator*(const A &a, const B &b) {
+    return Multiply<A, B>(a, b);
+}
+
+/**
+ * 移動行列
+ */
+struct Translate: public Expression {
+    GLfloat x;
+    GLfloat y;
+    GLfloat z;
+
+    Translate(const GLfloat x, const GLfloat y, const GLfloat z) :
+            x(x), y(y), z(z) {
+    }
+
+    static constexpr int kind(int column, int row) {
+        return column == row ? ELEMENT_ONE : ((column == 3 && row < 3) ? ELEMENT_ANY : ELEMENT_ZERO);
+    }
+
+    template<int C, int R>
+    GLfloat at() const {
+        return C == R ? 1.0f : (C != 3 ? 0.0f : (R == 0 ? x : (R == 1 ? y : z)));
+    }
+};
+
+/**
+ * 拡縮行列
+ */
+struct Scale: public Expression {
+    GLfloat x;
+    GLfloat y;
+    GLfloat z;
+
+    Scale(const GLfloat x, const GLfloat y, const GLfloat z) :
+            x(x), y(y), z(z) {
+    }
+
+    static constexpr int kind(int column, int row) {
+        return column != row ? ELEMENT_ZERO : (column == 3 ? ELEMENT_ONE : ELEMENT_ANY);
+    }
+
+    template<int C, int R>
+    GLfloat at() const {
+        return C != R ? 0.0f : (C == 0 ? x : (C == 1 ? y : (C == 2 ? z : 1.0f)));
+    }
+};
+
+/**
+ * 座標軸周りの回転行列
+ * Axisは回転しない軸(0=X, 1=Y, 2=Z)で、mat4_rotate()と同じ回転方向になる。
+ */
+template<int Axis>
+struct RotateAxis: public Expression {
+    GLfloat c;
+    GLfloat s;
+
+    /**
+     * 回転角(360度系)を指定する
+     */
+    explicit RotateAxis(const GLfloat rotate) {
+        trig_sincos(rotate, &s, &c);
+    }
+
+    static constexpr bool isPlane(int index) {
+        return index != Axis && index != 3;
+    }
+
+    static constexpr int kind(int column, int row) {
+        return (isPlane(column) && isPlane(row)) ? ELEMENT_ANY : (column == row ? ELEMENT_ONE : ELEMENT_ZERO);
+    }
+
+    /**
+     * 回転面を構成する2軸のうち、先の軸をu、後の軸をvとすると
+     * m[u][u] = c, m[u][v] = -s, m[v][u] = s, m[v][v] = c
+     * となる（Y軸回転のみ、軸の並びがZ→Xとなるため符号が逆転する）。
+     */
+    template<int C, int R>
+    GLfloat at() const {
+        return !(isPlane(C) && isPlane(R)) ? (C == R ? 1.0f : 0.0f) : (C == R ? c : (((C < R) != (Axis == 1)) ? -s : s));
+    }
+};
+
+typedef RotateAxis<0> RotateX;
+typedef RotateAxis<1> RotateY;
+typedef RotateAxis<2> RotateZ;
+
+/**
+ * 任意軸周りの回転行列
+ */
+struct Rotate: public Expression {
+    mat4 m;
+
+    /**
+     * 正規化済みの回転軸と回転角(360度系)を指定する
+     */
+    Rotate(const vec3 &axis, const GLfloat rotate) {
+        mat4_rotate_to(&m, &axis, rotate);
+    }
+
+    static constexpr int kind(int column, int row) {
+        return (column < 3 && row < 3) ? ELEMENT_ANY : (column == row ? ELEMENT_ONE : ELEMENT_ZERO);
+    }
+
+    template<int C, int R>
+    GLfloat at() const {
+        return m.m[C][R];
+    }
+};
+
+/**
+ * 構造が不明な一般の行列
+ */
+struct Matrix: public Expression {
+    const mat4 &m;
+
+    explicit Matrix(const mat4 &m) :
+            m(m) {
+    }
+
+    static constexpr int kind(int, int) {
+        return ELEMENT_ANY;
+    }
+
+    template<int C, int R>
+    GLfloat at() const {
+        return m.m[C][R];
+    }
+};
+
+/**
+ * 16要素を順に書き込む
+ */
+template<int I>
+struct Store {
+    template<class E>
+    static void apply(mat4 *result, const E &e) {
+        result->m[I / 4][I % 4] = e.template at<I / 4, I % 4>();
+        Store<I + 1>::apply(result, e);
+    }
+};
+
+template<>
+struct Store<16> {
+    template<class E>
+    static void apply(mat4 *, const E &) {
+    }
+};
+
+/**
+ * 行列式を評価してresultへ書き込む。
+ * resultが式の中のMatrixと同じ行列を指してはならない。
+ */
+template<class E>
+inline void store(mat4 *result, const E &e) {
+    static_assert(std::is_base_of<Expression, E>::value, "trs::store() requires a matrix expression");
+    Store<0>::apply(result, e);
+}
+
+}
+
+#endif /* SUPPORT_GL_VECTOR_TRS_HPP_ */
@@ -0,0 +1,417 @@
+/*
+ * support_gl_VirtualTexture.c
+ *
+ *  Created on: 2026/10/19
+ */
+
+#include    "support.h"
+
+/**
+ * Little Endianで32bit整数を読み込む
+ */
+static int32_t VirtualTexture_readLE32(const uint8_t *p) {
+    return (int32_t) ((uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24));
+}
+
+/**
+ * Little Endianで64bit整数を読み込む
+ */
+static int64_t VirtualTexture_readLE64(const uint8_t *p) {
+    return (int64_t) ((uint64_t) (uint32_t) VirtualTexture_readLE32(p) | ((uint64_t) (uint32_t) VirtualTexture_readLE32(p + 4) << 32));
+}
+
+/**
+ * タイルの外周を含めた一辺のピクセル数
+ */
+static int VirtualTexture_getTileStride(VirtualTexture *vtex) {
+    return vtex->tile_size + vtex->border * 2;
+}
+
+/**
+ * 最後のレベルのページであればtrue
+ * 代用タイルとして常に物理テクスチャに置いておく。
+ */
+static bool VirtualTexture_isPinnedPage(VirtualTexture *vtex, const int page) {
+    return page >= vtex->level_page_offset[vtex->levels - 1];
+}
+
+/**
+ * 空きスロットを取得する。
+ * 空きがない場合、現在のフレームで利用していないページのうち最も長く利用されていないものを追い出す。
+ */
+static int VirtualTexture_allocSlot(VirtualTexture *vtex) {
+    int result = VIRTUAL_TEXTURE_PAGE_NONE;
+    int oldest_frame = vtex->frame;
+
+    int slot = 0;
+    for (slot = 0; slot < vtex->slot_num; ++slot) {
+        const int page = vtex->slot_page[slot];
+        if (page == VIRTUAL_TEXTURE_PAGE_NONE) {
+            return slot;
+        }
+
+        if (!VirtualTexture_isPinnedPage(vtex, page) && vtex->page_last_used[page] < oldest_frame) {
+            oldest_frame = vtex->page_last_used[page];
+            result = slot;
+        }
+    }
+
+    if (result != VIRTUAL_TEXTURE_PAGE_NONE) {
+        // 追い出したページをページテーブルから外す
+        vtex->page_table[vtex->slot_page[result]] = VIRTUAL_TEXTURE_PAGE_NONE;
+        vtex->slot_page[result] = VIRTUAL_TEXTURE_PAGE_NONE;
+    }
+    return result;
+}
+
+/**
+ * タイルをファイルから読み込み、物理テクスチャのスロットへ転送する。
+ * 読み込めなかった場合はfalseを返し、スロットは空きのままとなる。
+ */
+static bool VirtualTexture_uploadTile(VirtualTexture *vtex, const int page, const int slot) {
+    const int stride = VirtualTexture_getTileStride(vtex);
+    const int tile_bytes = stride * stride * RawPixelImage_getPixelBytes(vtex->pixel_format);
+
+    if (!RawFile_read(vtex->file, vtex->page_offsets[page], vtex->tile_pixels, tile_bytes)) {
+        __logf("virtual texture tile read error(page %d)", page);
+        return false;
+    }
+
+    glTexSubImage2D(GL_TEXTURE_2D, 0, (slot % vtex->slots_x) * stride, (slot / vtex->slots_x) * stride, stride, stride, RawPixelImage_getGLFormat(vtex->pixel_format), RawPixelImage_getGLType(vtex->pixel_format), vtex->tile_pixels);
+    assert(glGetError() == GL_NO_ERROR);
+
+    vtex->page_table[page] = slot;
+    vtex->slot_page[slot] = page;
+    return true;
+}
+
+/**
+ * タイルパックを開く。
+ */
+VirtualTexture* VirtualTexture_load(GLApplication *app, const char* file_name, const int atlas_size) {
+    RawFile *file = RawFile_open(app, file_name);
+    if (!file) {
+        return NULL;
+    }
+
+    uint8_t header[VIRTUAL_TEXTURE_HEADER_BYTES];
+    if (!RawFile_read(file, 0, header, VIRTUAL_TEXTURE_HEADER_BYTES) || memcmp(header, VIRTUAL_TEXTURE_MAGIC, 4) != 0) {
+        __logf("virtual texture magic error(%s)", file_name);
+        RawFile_close(app, file);
+        return NULL;
+    }
+
+    VirtualTexture *vtex = (VirtualTexture*) calloc(1, sizeof(VirtualTexture));
+    vtex->file = file;
+    vtex->width = VirtualTexture_readLE32(header + 4);
+    vtex->height = VirtualTexture_readLE32(header + 8);
+    vtex->tile_size = VirtualTexture_readLE32(header + 12);
+    vtex->border = VirtualTexture_readLE32(header + 16);
+    vtex->pixel_format = VirtualTexture_readLE32(header + 20);
+    vtex->levels = VirtualTexture_readLE32(header + 24);
+    vtex->uploads_per_frame = 4;
+
+    if (vtex->width <= 0 || vtex->height <= 0 || vtex->tile_size <= 0 || vtex->border < 0 || vtex->levels <= 0 || vtex->levels > 31 || ((int64_t) vtex->tile_size + (int64_t) vtex->border * 2) > VIRTUAL_TEXTURE_TILE_STRIDE_MAX || vtex->pixel_format < TEXTURE_RAW_RGBA8 || vtex->pixel_format > TEXTURE_RAW_RGB565) {
+        __logf("virtual texture header error(%s)", file_name);
+        VirtualTexture_free(app, vtex);
+        return NULL;
+    }
+
+    {
+        // レベルごとのタイル数を計算する
+        vtex->level_tiles_x = (int*) malloc(sizeof(int) * vtex->levels);
+        vtex->level_tiles_y = (int*) malloc(sizeof(int) * vtex->levels);
+        vtex->level_page_offset = (int*) malloc(sizeof(int) * vtex->levels);
+
+        int64_t page_num = 0;
+        int level = 0;
+        for (level = 0; level < vtex->levels; ++level) {
+            const int level_width = (vtex->width >> level) > 0 ? (vtex->width >> level) : 1;
+            const int level_height = (vtex->height >> level) > 0 ? (vtex->height >> level) : 1;
+
+            vtex->level_tiles_x[level] = (int) (((int64_t) level_width + vtex->tile_size - 1) / vtex->tile_size);
+            vtex->level_tiles_y[level] = (int) (((int64_t) level_height + vtex->tile_size - 1) / vtex->tile_size);
+            vtex->level_page_offset[level] = (int) (page_num < VIRTUAL_TEXTURE_PAGE_MAX ? page_num : VIRTUAL_TEXTURE_PAGE_MAX);
+            page_num += (int64_t) vtex->level_tiles_x[level] * vtex->level_tiles_y[level];
+        }
+
+        // 最後のレベルは1タイルに収まり、かつ1x1より小さいレベルを含んではならない
+        const int coarsest = vtex->levels - 1;
+        const bool coarsest_fits = vtex->level_tiles_x[coarsest] == 1 && vtex->level_tiles_y[coarsest] == 1;
+        const bool redundant = coarsest > 0 && (vtex->width >> (coarsest - 1)) <= 1 && (vtex->height >> (coarsest - 1)) <= 1;
+        if (!coarsest_fits || redundant || page_num > VIRTUAL_TEXTURE_PAGE_MAX) {
+            __logf("virtual texture level error(%s) size(%d x %d) tile(%d) levels(%d)", file_name, vtex->width, vtex->height, vtex->tile_size, vtex->levels);
+            VirtualTexture_free(app, vtex);
+            return NULL;
+        }
+        vtex->page_num = (int) page_num;
+    }
+
+    const int stride = VirtualTexture_getTileStride(vtex);
+    {
+        // オフセット表を読み込み、全タイルがファイル内に収まっていることを確認する
+        const int64_t tile_bytes = (int64_t) stride * stride * RawPixelImage_getPixelBytes(vtex->pixel_format);
+        const int table_bytes = sizeof(int64_t) * (vtex->page_num + 1);
+        uint8_t *table = (uint8_t*) malloc(table_bytes);
+        vtex->page_offsets = (int64_t*) malloc(table_bytes);
+
+        bool valid = RawFile_read(file, VIRTUAL_TEXTURE_HEADER_BYTES, table, table_bytes);
+        int i = 0;
+        for (i = 0; valid && i <= vtex->page_num; ++i) {
+            vtex->page_offsets[i] = VirtualTexture_readLE64(table + sizeof(int64_t) * i);
+        }
+        for (i = 0; valid && i < vtex->page_num; ++i) {
+            if (vtex->page_offsets[i] < (VIRTUAL_TEXTURE_HEADER_BYTES + table_bytes) || (vtex->page_offsets[i + 1] - vtex->page_offsets[i]) != tile_bytes || vtex->page_offsets[i + 1] > file->length) {
+                valid = false;
+            }
+        }
+        free(table);
+
+        if (!valid) {
+            __logf("virtual texture offset table error(%s)", file_name);
+            VirtualTexture_free(app, vtex);
+            return NULL;
+        }
+
+        vtex->tile_pixels = malloc(tile_bytes);
+    }
+
+    {
+        // 物理テクスチャのスロットを決める
+        GLint max_texture_size = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+        const int size = atlas_size < max_texture_size ? atlas_size : max_texture_size;
+
+        vtex->slots_x = size / stride;
+        vtex->slot_num = vtex->slots_x * (size / stride);
+
+        const int pinned_pages = vtex->page_num - vtex->level_page_offset[vtex->levels - 1];
+        if (vtex->slot_num <= pinned_pages) {
+            __logf("virtual texture atlas too small(%s) slots(%d) pinned(%d)", file_name, vtex->slot_num, pinned_pages);
+            VirtualTexture_free(app, vtex);
+            return NULL;
+        }
+
+        Texture *atlas = (Texture*) malloc(sizeof(Texture));
+        atlas->width = size;
+        atlas->height = size;
+        atlas->upload_completed = true;
+        atlas->vram_bytes = size * size * RawPixelImage_getPixelBytes(vtex->pixel_format);
+
+        glGenTextures(1, &atlas->id);
+        assert(atlas->id > 0);
+        glBindTexture(GL_TEXTURE_2D, atlas->id);
+
+        // ピクセルを転送せずにVRAMだけを確保する
+        glTexImage2D(GL_TEXTURE_2D, 0, RawPixelImage_getGLFormat(vtex->pixel_format), size, size, 0, RawPixelImage_getGLFormat(vtex->pixel_format), RawPixelImage_getGLType(vtex->pixel_format), NULL);
+
+        // タイルの外周はフィルタリング時の継ぎ目を防ぐためにある
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        assert(glGetError() == GL_NO_ERROR);
+
+        vtex->atlas = atlas;
+    }
+
+    {
+        // テーブルを初期化する
+        vtex->page_table = (int*) malloc(sizeof(int) * vtex->page_num);
+        vtex->page_last_used = (int*) malloc(sizeof(int) * vtex->page_num);
+        vtex->slot_page = (int*) malloc(sizeof(int) * vtex->slot_num);
+
+        int i = 0;
+        for (i = 0; i < vtex->page_num; ++i) {
+            vtex->page_table[i] = VIRTUAL_TEXTURE_PAGE_NONE;
+            vtex->page_last_used[i] = -1;
+        }
+        for (i = 0; i < vtex->slot_num; ++i) {
+            vtex->slot_page[i] = VIRTUAL_TEXTURE_PAGE_NONE;
+        }
+    }
+
+    {
+        // 最後のレベルは代用タイルとして先に転送する
+        GLint unpack_alignment = 4;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        bool pinned = true;
+        int page = 0;
+        for (page = vtex->level_page_offset[vtex->levels - 1]; page < vtex->page_num && pinned; ++page) {
+            pinned = VirtualTexture_uploadTile(vtex, page, VirtualTexture_allocSlot(vtex));
+        }
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+
+        if (!pinned) {
+            glBindTexture(GL_TEXTURE_2D, 0);
+            VirtualTexture_free(app, vtex);
+            return NULL;
+        }
+    }
+
+// unbindする
+    glBindTexture(GL_TEXTURE_2D, 0);
+    assert(glGetError() == GL_NO_ERROR);
+
+    __logf("virtual texture(%s) size(%d x %d) levels(%d) pages(%d) slots(%d)", file_name, vtex->width, vtex->height, vtex->levels, vtex->page_num, vtex->slot_num);
+    return vtex;
+}
+
+/**
+ * 1画面pixelあたりの画像pixel数から、表示に利用するレベルを選択する。
+ */
+int VirtualTexture_selectLevel(VirtualTexture *vtex, const float texels_per_pixel) {
+    int level = 0;
+    while (level < (vtex->levels - 1) && (float) ((int64_t) 2 << level) <= texels_per_pixel) {
+        ++level;
+    }
+    return level;
+}
+
+/**
+ * レベル0の画像上の範囲を、指定レベルのタイル範囲へ変換する。
+ * 範囲外の場合はfalseを返す。
+ */
+static bool VirtualTexture_getTileRange(VirtualTexture *vtex, const int level, const int x, const int y, const int width, const int height, int range[4]) {
+    // レベル数が多い場合にintを超えないよう、64bitで計算する
+    const int64_t span = (int64_t) vtex->tile_size << level;
+
+    range[0] = x > 0 ? (int) (x / span) : 0;
+    range[1] = y > 0 ? (int) (y / span) : 0;
+    range[2] = (int) (((int64_t) x + width - 1) / span);
+    range[3] = (int) (((int64_t) y + height - 1) / span);
+
+    if (range[2] >= vtex->level_tiles_x[level]) {
+        range[2] = vtex->level_tiles_x[level] - 1;
+    }
+    if (range[3] >= vtex->level_tiles_y[level]) {
+        range[3] = vtex->level_tiles_y[level] - 1;
+    }
+
+    return ((int64_t) x + width) > 0 && ((int64_t) y + height) > 0 && range[0] <= range[2] && range[1] <= range[3];
+}
+
+/**
+ * 表示中の領域に必要なタイルを物理テクスチャへ転送する。
+ */
+void VirtualTexture_update(VirtualTexture *vtex, const int x, const int y, const int width, const int height, const int level) {
+    ++vtex->frame;
+
+    const int start_level = level < vtex->levels ? level : vtex->levels - 1;
+    int range[4];
+    int l = 0;
+    int tx = 0;
+    int ty = 0;
+
+    // 必要なタイルと、代用に利用する上位レベルのタイルを利用中にする
+    for (l = start_level; l < vtex->levels; ++l) {
+        if (!VirtualTexture_getTileRange(vtex, l, x, y, width, height, range)) {
+            continue;
+        }
+        for (ty = range[1]; ty <= range[3]; ++ty) {
+            for (tx = range[0]; tx <= range[2]; ++tx) {
+                vtex->page_last_used[vtex->level_page_offset[l] + ty * vtex->level_tiles_x[l] + tx] = vtex->frame;
+            }
+        }
+    }
+
+    GLint unpack_alignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, vtex->atlas->id);
+
+    // 低解像度から順に転送し、早く画面全体を埋める
+    int uploads = 0;
+    for (l = vtex->levels - 1; l >= start_level && uploads < vtex->uploads_per_frame; --l) {
+        if (!VirtualTexture_getTileRange(vtex, l, x, y, width, height, range)) {
+            continue;
+        }
+        for (ty = range[1]; ty <= range[3] && uploads < vtex->uploads_per_frame; ++ty) {
+            for (tx = range[0]; tx <= range[2] && uploads < vtex->uploads_per_frame; ++tx) {
+                const int page = vtex->level_page_offset[l] + ty * vtex->level_tiles_x[l] + tx;
+                if (vtex->page_table[page] != VIRTUAL_TEXTURE_PAGE_NONE) {
+                    continue;
+                }
+
+                const int slot = VirtualTexture_allocSlot(vtex);
+                if (slot == VIRTUAL_TEXTURE_PAGE_NONE) {
+                    // 全スロットが利用中のため、これ以上は転送できない
+                    uploads = vtex->uploads_per_frame;
+                    break;
+                }
+                // 読み込めなかったタイルは上位レベルで代用したままにする
+                VirtualTexture_uploadTile(vtex, page, slot);
+                ++uploads;
+            }
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+
+// unbindする
+    glBindTexture(GL_TEXTURE_2D, 0);
+    assert(glGetError() == GL_NO_ERROR);
+}
+
+/**
+ * タイルを描画するための物理テクスチャ上のUV座標を取得する。
+ */
+int VirtualTexture_lookup(VirtualTexture *vtex, const int level, const int tile_x, const int tile_y, float uv[4]) {
+    const int stride = VirtualTexture_getTileStride(vtex);
+
+    int l = 0;
+    for (l = level; l < vtex->levels; ++l) {
+        const int shift = l - level;
+        const int parent_x = tile_x >> shift;
+        const int parent_y = tile_y >> shift;
+        if (parent_x < 0 || parent_y < 0 || parent_x >= vtex->level_tiles_x[l] || parent_y >= vtex->level_tiles_y[l]) {
+            continue;
+        }
+
+        const int slot = vtex->page_table[vtex->level_page_offset[l] + parent_y * vtex->level_tiles_x[l] + parent_x];
+        if (slot == VIRTUAL_TEXTURE_PAGE_NONE) {
+            continue;
+        }
+
+        // 上位レベルのタイルの場合、該当する範囲だけを切り出す
+        const float sub_size = (float) vtex->tile_size / (float) (1 << shift);
+        const float left = (float) ((slot % vtex->slots_x) * stride + vtex->border) + sub_size * (float) (tile_x - (parent_x << shift));
+        const float top = (float) ((slot / vtex->slots_x) * stride + vtex->border) + sub_size * (float) (tile_y - (parent_y << shift));
+
+        uv[0] = left / (float) vtex->atlas->width;
+        uv[1] = top / (float) vtex->atlas->height;
+        uv[2] = (left + sub_size) / (float) vtex->atlas->width;
+        uv[3] = (top + sub_size) / (float) vtex->atlas->height;
+        return l;
+    }
+
+    uv[0] = uv[1] = uv[2] = uv[3] = 0;
+    return VIRTUAL_TEXTURE_PAGE_NONE;
+}
+
+/**
+ * テクスチャを解放する
+ */
+void VirtualTexture_free(GLApplication *app, VirtualTexture *vtex) {
+    if (!vtex) {
+        return;
+    }
+
+    if (vtex->atlas) {
+        Texture_free(vtex->atlas);
+    }
+    RawFile_close(app, vtex->file);
+
+    free(vtex->level_tiles_x);
+    free(vtex->level_tiles_y);
+    free(vtex->level_page_offset);
+    free(vtex->page_table);
+    free(vtex->page_last_used);
+    free(vtex->slot_page);
+    free(vtex->page_offsets);
+    free(vtex->tile_pixels);
+    free(vtex);
+}
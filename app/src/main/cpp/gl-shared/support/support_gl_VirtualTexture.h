@@ -0,0 +1,206 @@
+/*
+ * support_gl_VirtualTexture.h
+ *
+ *  Created on: 2026/10/19
+ */
+
+#ifndef SUPPORT_GL_VIRTUALTEXTURE_H_
+#define SUPPORT_GL_VIRTUALTEXTURE_H_
+
+#include    "support.h"
+
+struct Texture;
+
+/**
+ * タイルパックのマジックナンバー
+ */
+#define VIRTUAL_TEXTURE_MAGIC     "VTX2"
+
+/**
+ * タイルパックのヘッダサイズ(byte)
+ */
+#define VIRTUAL_TEXTURE_HEADER_BYTES  28
+
+/**
+ * 物理テクスチャ上で見つからなかった場合の値
+ */
+#define VIRTUAL_TEXTURE_PAGE_NONE     -1
+
+/**
+ * 1タイルの一辺(tile_size + border * 2)の上限
+ */
+#define VIRTUAL_TEXTURE_TILE_STRIDE_MAX   4096
+
+/**
+ * 全レベルの合計タイル数の上限
+ */
+#define VIRTUAL_TEXTURE_PAGE_MAX      (1 << 24)
+
+/**
+ * GL_MAX_TEXTURE_SIZEを超える画像をタイル単位で表示する。
+ *
+ * 画像は事前に固定サイズのタイルへ分割したタイルパックとして用意する。
+ * タイルパックはtools/texture_cookerの-vオプションで作成できる。
+ * ファイル全体はメモリに読み込まず、ヘッダとタイルのオフセット表だけを保持し、タイルは転送時にファイルから読み込む。
+ * 表示中の領域に必要なタイルだけを物理テクスチャ(タイルのキャッシュ)へ転送し、
+ * どのタイルが物理テクスチャのどこにあるかをCPU側のページテーブルで管理する。
+ * 未転送のタイルは、転送済みの上位レベル（低解像度）のタイルで代用する。
+ *
+ * タイルパックの構造(数値は全てLittle Endian)
+ * magic "VTX2"
+ * width / height : レベル0の画像サイズ(int32)
+ * tile_size : 1タイルの有効ピクセル数(int32)
+ * border : タイル外周に付加した隣接ピクセルの幅（フィルタリング時の継ぎ目防止）(int32)
+ * pixel_format : TEXTURE_RAW_XXX(int32)
+ * levels : レベル数。最後のレベルは1タイルに収まり、それより前のレベルは1x1より大きい必要がある(int32)
+ * offsets : 各タイルのファイル先頭からの位置(int64)をページ番号順に並べ、末尾にファイル終端の位置を加えた表
+ * 以降、各タイルのピクセルを格納する。ページ番号はレベル0から順に、各レベルのタイルを左上から行優先で数える。
+ * 1タイルは(tile_size + border * 2)^2ピクセルで、画像外の領域は端のピクセルで埋める。
+ */
+typedef struct VirtualTexture {
+    /**
+     * タイルパック
+     */
+    RawFile *file;
+
+    /**
+     * ページごとのファイル内の位置
+     * 要素数はpage_num + 1
+     */
+    int64_t *page_offsets;
+
+    /**
+     * 1タイル分の読込バッファ
+     */
+    void *tile_pixels;
+
+    /**
+     * レベル0の画像幅
+     */
+    int width;
+
+    /**
+     * レベル0の画像高さ
+     */
+    int height;
+
+    /**
+     * 1タイルの有効ピクセル数
+     */
+    int tile_size;
+
+    /**
+     * タイル外周の幅
+     */
+    int border;
+
+    /**
+     * タイルのピクセルフォーマット
+     * TEXTURE_RAW_XXX
+     */
+    int pixel_format;
+
+    /**
+     * レベル数
+     */
+    int levels;
+
+    /**
+     * 各レベルの横方向のタイル数
+     */
+    int *level_tiles_x;
+
+    /**
+     * 各レベルの縦方向のタイル数
+     */
+    int *level_tiles_y;
+
+    /**
+     * 各レベルの先頭タイルのページ番号
+     */
+    int *level_page_offset;
+
+    /**
+     * 全レベルのタイル数
+     */
+    int page_num;
+
+    /**
+     * ページテーブル
+     * ページ番号ごとに、格納されている物理テクスチャのスロット番号を持つ。
+     * 転送されていない場合はVIRTUAL_TEXTURE_PAGE_NONE
+     */
+    int *page_table;
+
+    /**
+     * ページごとの最後に利用したフレーム
+     */
+    int *page_last_used;
+
+    /**
+     * 物理テクスチャ
+     */
+    struct Texture *atlas;
+
+    /**
+     * 物理テクスチャの横方向のスロット数
+     */
+    int slots_x;
+
+    /**
+     * 物理テクスチャのスロット数
+     */
+    int slot_num;
+
+    /**
+     * スロットごとに格納しているページ番号
+     * 空きスロットはVIRTUAL_TEXTURE_PAGE_NONE
+     */
+    int *slot_page;
+
+    /**
+     * 1フレームで転送するタイル数の上限
+     */
+    int uploads_per_frame;
+
+    /**
+     * 現在のフレーム
+     */
+    int frame;
+} VirtualTexture;
+
+/**
+ * タイルパックを開く。
+ * file_nameはRawFile_open()と同じく、assets配下のファイルか'/'から始まる絶対パスを指定する。
+ * atlas_sizeは物理テクスチャの一辺のピクセル数で、GL_MAX_TEXTURE_SIZEを上限とする。
+ * 最後のレベルのタイルは常に物理テクスチャへ転送され、代用タイルとして利用される。
+ * 読み込んだテクスチャはVirtualTexture_free()で解放する
+ */
+extern VirtualTexture* VirtualTexture_load(GLApplication *app, const char* file_name, const int atlas_size);
+
+/**
+ * 1画面pixelあたりの画像pixel数から、表示に利用するレベルを選択する。
+ */
+extern int VirtualTexture_selectLevel(VirtualTexture *vtex, const float texels_per_pixel);
+
+/**
+ * 表示中の領域に必要なタイルを物理テクスチャへ転送する。
+ * x, y, width, heightはレベル0の画像上のピクセル座標で指定する。
+ * 毎フレーム描画前に呼び出し、転送はuploads_per_frame個までに制限される。
+ */
+extern void VirtualTexture_update(VirtualTexture *vtex, const int x, const int y, const int width, const int height, const int level);
+
+/**
+ * タイルを描画するための物理テクスチャ上のUV座標を取得する。
+ * 対象のタイルが転送されていない場合、転送済みの上位レベルのタイルから該当する範囲を返す。
+ * uvには{left, top, right, bottom}が格納され、戻り値は実際に利用したレベルとなる。
+ * タイルの範囲はレベル0の画像上で (tile_x, tile_y) * tile_size * 2^level から tile_size * 2^level pixelとなる。
+ */
+extern int VirtualTexture_lookup(VirtualTexture *vtex, const int level, const int tile_x, const int tile_y, float uv[4]);
+
+/**
+ * テクスチャを解放する
+ */
+extern void VirtualTexture_free(GLApplication *app, VirtualTexture *vtex);
+
+#endif /* SUPPORT_GL_VIRTUALTEXTURE_H_ */
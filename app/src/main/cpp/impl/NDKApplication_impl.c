@@ -80,6 +80,7 @@ JNIEXPORT void JNICALL Java_com_eaglesakura_gles20_app_ndk_NDKApplication_initia
             NDKPlatform *platform = (NDKPlatform*) malloc(sizeof(NDKPlatform));
             platform->jGLApplication = (*env)->NewGlobalRef(env, _this);
             platform->jPlatform = (*env)->NewGlobalRef(env, (*env)->GetObjectField(env, _this, field_platform));
+            platform->cache_directory[0] = '\0';
             app->platform = (void*) platform;
         }
 
@@ -101,6 +102,9 @@ JNIEXPORT void JNICALL Java_com_eaglesakura_gles20_app_ndk_NDKApplication_initia
     // 構造体を保存する
     (*env)->SetIntField(env, _this, field_GLApplication_ptr, (jint) app);
 
+    // Extension一覧は起動時に1度だけ読み込む
+    ES20_loadExtensions();
+
     // サンプル関数に処理を行わせる
     (*app->initialize)(app);
 }
@@ -166,6 +170,54 @@ JNIEXPORT void JNICALL Java_com_eaglesakura_gles20_app_ndk_NDKApplication_destro
     free(app);
 }
 
+/**
+ * アプリ専用のキャッシュディレクトリのパスを取得する。
+ */
+const char* GLApplication_getCacheDirectory(GLApplication *app) {
+    NDKPlatform *platform = (NDKPlatform*) app->platform;
+    if (platform->cache_directory[0]) {
+        return platform->cache_directory;
+    }
+
+    JNIEnv *env = ndk_current_JNIEnv();
+
+    // platform.context.getCacheDir().getAbsolutePath()
+    jclass class_platform = (*env)->GetObjectClass(env, platform->jPlatform);
+    jfieldID field_context = ndk_loadClassField(env, class_platform, "Landroid/content/Context;", "context");
+    jobject jContext = (*env)->GetObjectField(env, platform->jPlatform, field_context);
+    (*env)->DeleteLocalRef(env, class_platform);
+
+    if (!jContext) {
+        return NULL;
+    }
+
+    jclass class_context = (*env)->GetObjectClass(env, jContext);
+    jmethodID method_getCacheDir = ndk_loadMethod(env, class_context, "getCacheDir", "()Ljava/io/File;", false);
+    jobject jFile = (*env)->CallObjectMethod(env, jContext, method_getCacheDir);
+    (*env)->DeleteLocalRef(env, class_context);
+    (*env)->DeleteLocalRef(env, jContext);
+
+    if (!jFile) {
+        return NULL;
+    }
+
+    jclass class_file = (*env)->GetObjectClass(env, jFile);
+    jmethodID method_getAbsolutePath = ndk_loadMethod(env, class_file, "getAbsolutePath", "()Ljava/lang/String;", false);
+    jstring jPath = (jstring) (*env)->CallObjectMethod(env, jFile, method_getAbsolutePath);
+    (*env)->DeleteLocalRef(env, class_file);
+    (*env)->DeleteLocalRef(env, jFile);
+
+    {
+        // C文字列へコピーする
+        const char *path = (*env)->GetStringUTFChars(env, jPath, NULL);
+        snprintf(platform->cache_directory, sizeof(platform->cache_directory), "%s", path);
+        (*env)->ReleaseStringUTFChars(env, jPath, path);
+        (*env)->DeleteLocalRef(env, jPath);
+    }
+
+    return platform->cache_directory;
+}
+
 /**
  * ダイアログを出して実行を停止する
  */
@@ -4,6 +4,10 @@
  *  Created on: 2013/04/08
  */
 #include <jni.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <android/asset_manager.h>
+#include <android/asset_manager_jni.h>
 #include "../gl-shared/support/support_RawData.h"
 #include "../gl-shared/support/support.h"
 #include "../support_ndk.h"
@@ -80,3 +84,153 @@ RawData* RawData_loadFile(GLApplication *app, const char* file_name) {
     return result;
 }
 
+
+/**
+ * 範囲読込するファイルのプラットフォーム固有データ
+ * assetsの場合はasset、ファイルシステムの場合はfdが有効となる。
+ */
+typedef struct RawFile_Android {
+    AAsset *asset;
+
+    int fd;
+} RawFile_Android;
+
+/**
+ * SDK側のAssetManager(グローバル参照)
+ * AAssetManagerはこの参照が有効な間だけ利用できる。
+ */
+static jobject g_asset_manager = NULL;
+
+/**
+ * platform.context.getAssets()からAAssetManagerを取得する
+ */
+static AAssetManager* RawFile_getAssetManager(GLApplication *app) {
+    JNIEnv *env = ndk_current_JNIEnv();
+
+    if (!g_asset_manager) {
+        NDKPlatform *platform = (NDKPlatform*) app->platform;
+
+        jclass class_platform = (*env)->GetObjectClass(env, platform->jPlatform);
+        jfieldID field_context = ndk_loadClassField(env, class_platform, "Landroid/content/Context;", "context");
+        jobject jContext = (*env)->GetObjectField(env, platform->jPlatform, field_context);
+        (*env)->DeleteLocalRef(env, class_platform);
+
+        if (!jContext) {
+            return NULL;
+        }
+
+        jclass class_context = (*env)->GetObjectClass(env, jContext);
+        jmethodID method_getAssets = ndk_loadMethod(env, class_context, "getAssets", "()Landroid/content/res/AssetManager;", false);
+        jobject jAssetManager = (*env)->CallObjectMethod(env, jContext, method_getAssets);
+        (*env)->DeleteLocalRef(env, class_context);
+        (*env)->DeleteLocalRef(env, jContext);
+
+        if (!jAssetManager) {
+            return NULL;
+        }
+
+        g_asset_manager = (*env)->NewGlobalRef(env, jAssetManager);
+        (*env)->DeleteLocalRef(env, jAssetManager);
+    }
+
+    return AAssetManager_fromJava(env, g_asset_manager);
+}
+
+/**
+ * ファイルを範囲読込用に開く。
+ */
+RawFile* RawFile_open(GLApplication *app, const char* file_name) {
+    RawFile_Android *platform = (RawFile_Android*) malloc(sizeof(RawFile_Android));
+    platform->asset = NULL;
+    platform->fd = -1;
+
+    int64_t length = 0;
+    if (file_name[0] == '/') {
+        // ファイルシステム上のファイル
+        platform->fd = open(file_name, O_RDONLY);
+        if (platform->fd >= 0) {
+            length = lseek64(platform->fd, 0, SEEK_END);
+        }
+    } else {
+        AAssetManager *manager = RawFile_getAssetManager(app);
+        if (manager) {
+            platform->asset = AAssetManager_open(manager, file_name, AASSET_MODE_RANDOM);
+        }
+        if (platform->asset) {
+            length = AAsset_getLength(platform->asset);
+        }
+    }
+
+    if (!platform->asset && platform->fd < 0) {
+        __logf("file open error(%s)", file_name);
+        free(platform);
+        return NULL;
+    }
+
+    RawFile *result = (RawFile*) malloc(sizeof(RawFile));
+    result->length = length;
+    result->platform = (void*) platform;
+    return result;
+}
+
+/**
+ * offsetの位置からbytesを読み込む。
+ */
+bool RawFile_read(RawFile *file, const int64_t offset, void *result, const int bytes) {
+    RawFile_Android *platform = (RawFile_Android*) file->platform;
+
+    if (offset < 0 || (offset + bytes) > file->length) {
+        return false;
+    }
+
+    uint8_t *dst = (uint8_t*) result;
+    int remain = bytes;
+
+    if (platform->asset) {
+        // APKの制約上、assetsは32bitのオフセットで扱える
+        if (AAsset_seek(platform->asset, (off_t) offset, SEEK_SET) < 0) {
+            return false;
+        }
+        while (remain > 0) {
+            const int n = AAsset_read(platform->asset, dst, remain);
+            if (n <= 0) {
+                return false;
+            }
+            dst += n;
+            remain -= n;
+        }
+    } else {
+        if (lseek64(platform->fd, offset, SEEK_SET) < 0) {
+            return false;
+        }
+        while (remain > 0) {
+            const int n = read(platform->fd, dst, remain);
+            if (n <= 0) {
+                return false;
+            }
+            dst += n;
+            remain -= n;
+        }
+    }
+    return true;
+}
+
+/**
+ * RawFile_open()で開いたファイルを閉じる
+ */
+void RawFile_close(GLApplication *app, RawFile *file) {
+    if (!file) {
+        return;
+    }
+
+    RawFile_Android *platform = (RawFile_Android*) file->platform;
+    if (platform->asset) {
+        AAsset_close(platform->asset);
+    }
+    if (platform->fd >= 0) {
+        close(platform->fd);
+    }
+
+    free(platform);
+    free(file);
+}
@@ -13,18 +13,47 @@ static jclass RawPixelImage_class = NULL;
 
 static jmethodID method_loadImage = NULL;
 
+static jmethodID method_decodeImage = NULL;
+
+static jmethodID method_openImage = NULL;
+
+static jmethodID method_decodeLines = NULL;
+
+static jmethodID method_close = NULL;
+
+static jfieldID field_width = NULL;
+
+static jfieldID field_height = NULL;
+
+static jfieldID field_pixel_data = NULL;
+
 /**
- * 画像を読み込む。
- * 読み込んだ画像はes20_freeImage()で解放する
+ * Java側のクラス情報を読み込む
  */
-RawPixelImage* RawPixelImage_load(GLApplication *app, const char* file_name, const int pixel_format) {
-    JNIEnv *env = ndk_current_JNIEnv();
-
+static void RawPixelImage_loadClass(JNIEnv *env) {
     if (!RawPixelImage_class) {
         RawPixelImage_class = ndk_loadClass(env, RawPixelImage_CLASS_SIGNATURE, true);
         method_loadImage = ndk_loadMethod(env, RawPixelImage_class, "loadImage", "(L"GLApplication_CLASS_SIGNATURE";Ljava/lang/String;I)L"RawPixelImage_CLASS_SIGNATURE";", true);
+        method_decodeImage = ndk_loadMethod(env, RawPixelImage_class, "decodeImage", "(Ljava/nio/ByteBuffer;I)L"RawPixelImage_CLASS_SIGNATURE";", true);
+        method_openImage = ndk_loadMethod(env, RawPixelImage_class, "openImage", "(Ljava/nio/ByteBuffer;)L"RawPixelImage_CLASS_SIGNATURE";", true);
+        method_decodeLines = ndk_loadMethod(env, RawPixelImage_class, "decodeLines", "(II)Ljava/nio/ByteBuffer;", false);
+        method_close = ndk_loadMethod(env, RawPixelImage_class, "close", "()V", false);
+
+        field_width = ndk_loadIntField(env, RawPixelImage_class, "width");
+        field_height = ndk_loadIntField(env, RawPixelImage_class, "height");
+        field_pixel_data = ndk_loadBufferField(env, RawPixelImage_class, "pixel_data");
+
+        assert(field_width != NULL);
+        assert(field_height != NULL);
+        assert(field_pixel_data != NULL);
     }
+}
 
+/**
+ * SDK側でデコードした画像をNDK側の構造体へ変換する。
+ * jRawImageの参照は削除される。
+ */
+static RawPixelImage* RawPixelImage_createFromSDK(JNIEnv *env, jobject jRawImage, const int pixel_format) {
     int pixelsize = 0;
 
     /**
@@ -45,36 +74,6 @@ RawPixelImage* RawPixelImage_load(GLApplication *app, const char* file_name, con
 
     assert(pixelsize > 0);
 
-    NDKPlatform *platform = (NDKPlatform*) app->platform;
-
-    jstring jFileName = (*env)->NewStringUTF(env, file_name);
-
-    jobject jRawImage = (*env)->CallStaticObjectMethod(env, RawPixelImage_class, method_loadImage, platform->jGLApplication, jFileName, pixel_format);
-
-// 読み込み失敗した
-    if (!jRawImage) {
-        __logf("image(%s) load fail...", file_name);
-        return NULL;
-    }
-
-    static jfieldID field_width = NULL;
-    static jfieldID field_height = NULL;
-    static jfieldID field_pixel_data = NULL;
-
-    if (!field_pixel_data) {
-        jclass clazz = (*env)->GetObjectClass(env, jRawImage);
-        field_width = ndk_loadIntField(env, clazz, "width");
-        field_height = ndk_loadIntField(env, clazz, "height");
-        field_pixel_data = ndk_loadBufferField(env, clazz, "pixel_data");
-
-        assert(field_width != NULL);
-        assert(field_height != NULL);
-        assert(field_pixel_data != NULL);
-
-        // 参照削除
-        (*env)->DeleteLocalRef(env, clazz);
-    }
-
 // 返却用をalloc
     RawPixelImage *image = (RawPixelImage*) malloc(sizeof(RawPixelImage));
 
@@ -102,7 +101,152 @@ RawPixelImage* RawPixelImage_load(GLApplication *app, const char* file_name, con
     }
 
 // 参照削除
-    (*env)->DeleteLocalRef(env, jFileName);
     (*env)->DeleteLocalRef(env, jRawImage);
     return image;
 }
+
+/**
+ * 画像を読み込む。
+ * 読み込んだ画像はes20_freeImage()で解放する
+ */
+RawPixelImage* RawPixelImage_load(GLApplication *app, const char* file_name, const int pixel_format) {
+    JNIEnv *env = ndk_current_JNIEnv();
+    RawPixelImage_loadClass(env);
+
+    NDKPlatform *platform = (NDKPlatform*) app->platform;
+
+    jstring jFileName = (*env)->NewStringUTF(env, file_name);
+
+    jobject jRawImage = (*env)->CallStaticObjectMethod(env, RawPixelImage_class, method_loadImage, platform->jGLApplication, jFileName, pixel_format);
+
+// 参照削除
+    (*env)->DeleteLocalRef(env, jFileName);
+
+// 読み込み失敗した
+    if (!jRawImage) {
+        __logf("image(%s) load fail...", file_name);
+        return NULL;
+    }
+
+    return RawPixelImage_createFromSDK(env, jRawImage, pixel_format);
+}
+
+/**
+ * 読み込み済みのPNG/JPEGファイルをデコードする。
+ */
+RawPixelImage* RawPixelImage_loadFromRawData(GLApplication *app, RawData *raw, const int pixel_format) {
+    JNIEnv *env = ndk_current_JNIEnv();
+    RawPixelImage_loadClass(env);
+
+    // ファイルを開き直さないよう、読込済みのメモリをそのままSDKへ渡す
+    jobject jBuffer = (*env)->NewDirectByteBuffer(env, raw->head, raw->length);
+    jobject jRawImage = (*env)->CallStaticObjectMethod(env, RawPixelImage_class, method_decodeImage, jBuffer, pixel_format);
+
+// 参照削除
+    (*env)->DeleteLocalRef(env, jBuffer);
+    RawData_freeFile(app, raw);
+
+// 読み込み失敗した
+    if (!jRawImage) {
+        __log("image decode fail...");
+        return NULL;
+    }
+
+    return RawPixelImage_createFromSDK(env, jRawImage, pixel_format);
+}
+
+/**
+ * ライン単位でデコードする画像のプラットフォーム固有データ
+ */
+typedef struct RawPixelImageStream_Android {
+    /**
+     * SDK側の画像(グローバル参照)
+     */
+    jobject jRawImage;
+} RawPixelImageStream_Android;
+
+/**
+ * 読み込み済みのPNG/JPEGファイルをライン単位でデコードできるよう開く。
+ */
+RawPixelImageStream* RawPixelImageStream_open(GLApplication *app, RawData *raw) {
+    JNIEnv *env = ndk_current_JNIEnv();
+    RawPixelImage_loadClass(env);
+
+    jobject jBuffer = (*env)->NewDirectByteBuffer(env, raw->head, raw->length);
+    jobject jRawImage = (*env)->CallStaticObjectMethod(env, RawPixelImage_class, method_openImage, jBuffer);
+
+// 参照削除
+    (*env)->DeleteLocalRef(env, jBuffer);
+
+// 開けなかった
+    if (!jRawImage) {
+        __log("image stream open fail...");
+        return NULL;
+    }
+
+    RawPixelImageStream *stream = (RawPixelImageStream*) malloc(sizeof(RawPixelImageStream));
+    RawPixelImageStream_Android *platform = (RawPixelImageStream_Android*) malloc(sizeof(RawPixelImageStream_Android));
+
+    stream->width = (*env)->GetIntField(env, jRawImage, field_width);
+    stream->height = (*env)->GetIntField(env, jRawImage, field_height);
+    stream->random_access = (Texture_detectFileFormat(raw) == TEXTURE_FILE_JPEG);
+    stream->platform = (void*) platform;
+
+// 複数回のJNI呼び出しを跨ぐため、グローバル参照へ切り替える
+    platform->jRawImage = (*env)->NewGlobalRef(env, jRawImage);
+    (*env)->DeleteLocalRef(env, jRawImage);
+
+    __logf("image stream size(%d x %d)", stream->width, stream->height);
+    return stream;
+}
+
+/**
+ * 指定ラインをデコードし、RGBA8888のピクセル配列を返す。
+ */
+const void* RawPixelImageStream_readLines(RawPixelImageStream *stream, const int y, const int lines) {
+    JNIEnv *env = ndk_current_JNIEnv();
+    RawPixelImageStream_Android *platform = (RawPixelImageStream_Android*) stream->platform;
+
+    assert(y >= 0 && (y + lines) <= stream->height);
+
+    jobject jpixel_data = (*env)->CallObjectMethod(env, platform->jRawImage, method_decodeLines, y, lines);
+
+// 例外が残ったままJNIを呼び出さないよう、ここで消去する
+    if ((*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionDescribe(env);
+        (*env)->ExceptionClear(env);
+        if (jpixel_data) {
+            (*env)->DeleteLocalRef(env, jpixel_data);
+        }
+        __logf("decode lines error(y=%d lines=%d)", y, lines);
+        return NULL;
+    }
+    if (!jpixel_data) {
+        __logf("decode lines error(y=%d lines=%d)", y, lines);
+        return NULL;
+    }
+
+// SDK側のバッファは呼び出しごとに再利用されるため、アドレスのみ返す
+    const void* result = (*env)->GetDirectBufferAddress(env, jpixel_data);
+    (*env)->DeleteLocalRef(env, jpixel_data);
+
+    return result;
+}
+
+/**
+ * RawPixelImageStream_open()で開いた画像を解放する
+ */
+void RawPixelImageStream_close(GLApplication *app, RawPixelImageStream *stream) {
+    if (!stream) {
+        return;
+    }
+
+    JNIEnv *env = ndk_current_JNIEnv();
+    RawPixelImageStream_Android *platform = (RawPixelImageStream_Android*) stream->platform;
+
+    (*env)->CallVoidMethod(env, platform->jRawImage, method_close);
+    (*env)->DeleteGlobalRef(env, platform->jRawImage);
+
+    free(platform);
+    free(stream);
+}
@@ -70,6 +70,12 @@ typedef struct NDKPlatform {
      * SDK側のGLApplication
      */
     jobject jGLApplication;
+
+    /**
+     * アプリのキャッシュディレクトリ
+     * 初回のGLApplication_getCacheDirectory()で取得する
+     */
+    char cache_directory[256];
 } NDKPlatform;
 
 #endif /* SUPPORT_NDK_H_ */
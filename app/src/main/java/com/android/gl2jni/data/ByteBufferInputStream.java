@@ -0,0 +1,76 @@
+package com.android.gl2jni.data;
+
+import java.io.InputStream;
+import java.nio.ByteBuffer;
+
+/**
+ * ByteBufferをコピーせずにInputStreamとして読み込む
+ * NDK側で読み込んだファイル(DirectByteBuffer)を、そのままBitmapFactory等へ渡すために利用する。
+ */
+public class ByteBufferInputStream extends InputStream {
+
+    /**
+     * 読み込み対象
+     * 元のバッファの読込位置を変更しないよう、duplicate()したものを保持する。
+     */
+    final ByteBuffer buffer;
+
+    /**
+     * mark()された位置
+     */
+    int mark_position = 0;
+
+    public ByteBufferInputStream(ByteBuffer buffer) {
+        this.buffer = buffer.duplicate();
+        this.buffer.position(0);
+    }
+
+    @Override
+    public int read() {
+        if (!buffer.hasRemaining()) {
+            return -1;
+        }
+        return buffer.get() & 0xFF;
+    }
+
+    @Override
+    public int read(byte[] bytes, int offset, int length) {
+        if (!buffer.hasRemaining()) {
+            return -1;
+        }
+
+        length = Math.min(length, buffer.remaining());
+        buffer.get(bytes, offset, length);
+        return length;
+    }
+
+    @Override
+    public long skip(long n) {
+        final int skip = (int) Math.max(0, Math.min(n, buffer.remaining()));
+        buffer.position(buffer.position() + skip);
+        return skip;
+    }
+
+    @Override
+    public int available() {
+        return buffer.remaining();
+    }
+
+    /**
+     * デコーダーが先読みしたヘッダへ戻れるよう、mark/resetに対応する
+     */
+    @Override
+    public boolean markSupported() {
+        return true;
+    }
+
+    @Override
+    public synchronized void mark(int readlimit) {
+        mark_position = buffer.position();
+    }
+
+    @Override
+    public synchronized void reset() {
+        buffer.position(mark_position);
+    }
+}
@@ -6,6 +6,8 @@ import java.nio.ByteBuffer;
 
 import android.graphics.Bitmap;
 import android.graphics.BitmapFactory;
+import android.graphics.BitmapRegionDecoder;
+import android.graphics.Rect;
 import android.util.Log;
 
 import com.android.gl2jni.app.GLApplication;
@@ -36,9 +38,104 @@ public class RawPixelImage {
      */
     public int format = 0;
 
+    /**
+     * ライン単位でデコードする場合のデコーダー
+     */
+    BitmapRegionDecoder decoder = null;
+
+    /**
+     * ライン単位でデコードする場合の作業用ピクセル配列
+     */
+    int[] line_pixels = null;
+
     public RawPixelImage() {
     }
 
+    /**
+     * 読み込み済みのファイル(PNG/JPEG)をライン単位でデコードできるよう開く
+     * ピクセル情報はdecodeLines()で取得し、終了後はclose()を呼び出す。
+     * @param file_data ファイル全体を保持したバッファ
+     * @return
+     */
+    public static RawPixelImage openImage(ByteBuffer file_data) {
+        try {
+            // ヘッダのみを解析し、ピクセルはデコードしない
+            // Java側へコピーせず、バッファを直接デコーダーへ読み込ませる
+            BitmapRegionDecoder decoder = BitmapRegionDecoder.newInstance(new ByteBufferInputStream(file_data), false);
+            if (decoder == null) {
+                return null;
+            }
+
+            RawPixelImage result = new RawPixelImage();
+            result.decoder = decoder;
+            result.width = decoder.getWidth();
+            result.height = decoder.getHeight();
+            return result;
+        } catch (Exception e) {
+            e.printStackTrace();
+        }
+
+        return null;
+    }
+
+    /**
+     * 指定ラインをRGBA8888でデコードし、pixel_dataへ格納する
+     * pixel_dataは呼び出しごとに再利用される。
+     * PNGは途中のラインから読み始められないため、呼び出しごとに先頭からデコードし直す。
+     * 呼び出し回数はNDK側でTEXTURE_STRIP_PNG_MAX_STRIPS以下に制限している。
+     * @return デコードしたpixel_data。デコードに失敗した場合はnull
+     */
+    public ByteBuffer decodeLines(int y, int lines) {
+        try {
+            final int bytes = width * lines * 4;
+            if (pixel_data == null || pixel_data.capacity() < bytes) {
+                pixel_data = ByteBuffer.allocateDirect(bytes);
+                line_pixels = new int[width];
+            }
+
+            BitmapFactory.Options options = new BitmapFactory.Options();
+            options.inPreferredConfig = Bitmap.Config.ARGB_8888;
+            Bitmap image = decoder.decodeRegion(new Rect(0, y, width, y + lines), options);
+            if (image == null) {
+                return null;
+            }
+
+            ByteBuffer pixelBuffer = (ByteBuffer) pixel_data;
+            pixelBuffer.position(0);
+            for (int i = 0; i < lines; ++i) {
+                image.getPixels(line_pixels, 0, width, 0, i, width, 1);
+                for (int k = 0; k < width; ++k) {
+                    final int pixel = line_pixels[k];
+
+                    pixelBuffer.put((byte) ((pixel >> 16) & 0xFF));
+                    pixelBuffer.put((byte) ((pixel >> 8) & 0xFF));
+                    pixelBuffer.put((byte) ((pixel) & 0xFF));
+                    pixelBuffer.put((byte) ((pixel >> 24) & 0xFF));
+                }
+            }
+            pixelBuffer.position(0);
+
+            image.recycle();
+            return pixelBuffer;
+        } catch (Exception e) {
+            e.printStackTrace();
+        }
+
+        return null;
+    }
+
+    /**
+     * openImage()で開いたデコーダーを解放する
+     */
+    public void close() {
+        if (decoder != null) {
+            decoder.recycle();
+            decoder = null;
+        }
+        pixel_data = null;
+        line_pixels = null;
+    }
+
     /**
      * 画像を読み込む
      * @param util
@@ -57,44 +154,7 @@ public class RawPixelImage {
                 return null;
             }
 
-            final int image_width = image.getWidth();
-            final int image_height = image.getHeight();
-            RawPixelImage result = new RawPixelImage();
-
-            // ピクセル情報の格納先
-            ByteBuffer pixelBuffer = ByteBuffer.allocateDirect(image_width * image_height * 4);
-            {
-                result.format = pixel_format;
-                result.width = image_width;
-                result.height = image_height;
-                result.pixel_data = pixelBuffer;
-            }
-
-            Log.d("RawPixelImage", String.format("image size(%d x %d)", image_width, image_height));
-
-            final int[] temp = new int[image_width];
-            final byte[] pixel_temp = new byte[4];
-            for (int i = 0; i < image_height; ++i) {
-                // 1ラインずつ読み込む
-                image.getPixels(temp, 0, image_width, 0, i, image_width, 1);
-                // 結果をByteArrayへ書き込む
-                for (int k = 0; k < image_width; ++k) {
-                    final int pixel = temp[k];
-
-                    pixel_temp[0] = (byte) ((pixel >> 16) & 0xFF);
-                    pixel_temp[1] = (byte) ((pixel >> 8) & 0xFF);
-                    pixel_temp[2] = (byte) ((pixel) & 0xFF);
-                    pixel_temp[3] = (byte) ((pixel >> 24) & 0xFF);
-
-                    pixelBuffer.put(pixel_temp);
-                }
-            }
-
-            // 書き込み位置をリセットする
-            pixelBuffer.position(0);
-
-            image.recycle();
-            return result;
+            return createImage(image, pixel_format);
         } catch (Exception e) {
             e.printStackTrace();
         } finally {
@@ -109,4 +169,71 @@ public class RawPixelImage {
 
         return null;
     }
+
+    /**
+     * 読み込み済みのファイル(PNG/JPEG)をデコードする
+     * @param file_data ファイル全体を保持したバッファ
+     * @param pixel_format GL_RGBA | GL_RGB
+     * @return
+     */
+    public static RawPixelImage decodeImage(ByteBuffer file_data, int pixel_format) {
+        try {
+            // Java側へコピーせず、バッファを直接デコーダーへ読み込ませる
+            Bitmap image = BitmapFactory.decodeStream(new ByteBufferInputStream(file_data));
+            if (image == null) {
+                return null;
+            }
+
+            return createImage(image, pixel_format);
+        } catch (Exception e) {
+            e.printStackTrace();
+        }
+
+        return null;
+    }
+
+    /**
+     * BitmapからRGBA8888のピクセル情報を作成する
+     * imageはrecycleされる。
+     */
+    private static RawPixelImage createImage(Bitmap image, int pixel_format) {
+        final int image_width = image.getWidth();
+        final int image_height = image.getHeight();
+        RawPixelImage result = new RawPixelImage();
+
+        // ピクセル情報の格納先
+        ByteBuffer pixelBuffer = ByteBuffer.allocateDirect(image_width * image_height * 4);
+        {
+            result.format = pixel_format;
+            result.width = image_width;
+            result.height = image_height;
+            result.pixel_data = pixelBuffer;
+        }
+
+        Log.d("RawPixelImage", String.format("image size(%d x %d)", image_width, image_height));
+
+        final int[] temp = new int[image_width];
+        final byte[] pixel_temp = new byte[4];
+        for (int i = 0; i < image_height; ++i) {
+            // 1ラインずつ読み込む
+            image.getPixels(temp, 0, image_width, 0, i, image_width, 1);
+            // 結果をByteArrayへ書き込む
+            for (int k = 0; k < image_width; ++k) {
+                final int pixel = temp[k];
+
+                pixel_temp[0] = (byte) ((pixel >> 16) & 0xFF);
+                pixel_temp[1] = (byte) ((pixel >> 8) & 0xFF);
+                pixel_temp[2] = (byte) ((pixel) & 0xFF);
+                pixel_temp[3] = (byte) ((pixel >> 24) & 0xFF);
+
+                pixelBuffer.put(pixel_temp);
+            }
+        }
+
+        // 書き込み位置をリセットする
+        pixelBuffer.position(0);
+
+        image.recycle();
+        return result;
+    }
 }
@@ -0,0 +1,129 @@
+/*
+ * RawPixelImage_host.c
+ *
+ *  Created on: 2026/10/19
+ */
+#include    <png.h>
+#include    "support.h"
+
+/**
+ * PNGファイルを読み込み、RGBA8888で展開する
+ */
+static RawPixelImage* RawPixelImage_decodePng(FILE *fp) {
+    png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    png_infop info = png_create_info_struct(png);
+    // setjmp後に変更する変数は、longjmpで戻った時に値が失われないようvolatileとする
+    RawPixelImage *volatile result = NULL;
+    png_bytep *volatile rows = NULL;
+
+    if (setjmp(png_jmpbuf(png))) {
+        // libpngのエラーはここへ戻る
+        png_destroy_read_struct(&png, &info, NULL);
+        free(rows);
+        if (result) {
+            free(result->pixel_data);
+            free(result);
+        }
+        return NULL;
+    }
+
+    png_init_io(png, fp);
+    png_read_info(png, info);
+
+    {
+        // 全ての形式をRGBA 8bitへ正規化する
+        const png_byte color_type = png_get_color_type(png, info);
+        const png_byte bit_depth = png_get_bit_depth(png, info);
+
+        if (bit_depth == 16) {
+            png_set_strip_16(png);
+        }
+        if (color_type == PNG_COLOR_TYPE_PALETTE) {
+            png_set_palette_to_rgb(png);
+        }
+        if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8) {
+            png_set_expand_gray_1_2_4_to_8(png);
+        }
+        if (png_get_valid(png, info, PNG_INFO_tRNS)) {
+            png_set_tRNS_to_alpha(png);
+        }
+        if (color_type == PNG_COLOR_TYPE_RGB || color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_PALETTE) {
+            png_set_filler(png, 0xFF, PNG_FILLER_AFTER);
+        }
+        if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA) {
+            png_set_gray_to_rgb(png);
+        }
+        png_read_update_info(png, info);
+    }
+
+    result = (RawPixelImage*) malloc(sizeof(RawPixelImage));
+    result->format = TEXTURE_RAW_RGBA8;
+    result->width = png_get_image_width(png, info);
+    result->height = png_get_image_height(png, info);
+    result->pixel_data = malloc(result->width * result->height * 4);
+
+    rows = (png_bytep*) malloc(sizeof(png_bytep) * result->height);
+    {
+        int y = 0;
+        for (y = 0; y < result->height; ++y) {
+            rows[y] = ((png_bytep) result->pixel_data) + y * result->width * 4;
+        }
+    }
+    png_read_image(png, rows);
+    png_read_end(png, NULL);
+
+    free(rows);
+    png_destroy_read_struct(&png, &info, NULL);
+    return result;
+}
+
+/**
+ * ホストのファイルパスから画像を読み込む。
+ * ツールはGLApplicationを持たないため、appにはNULLを渡してよい。
+ */
+RawPixelImage* RawPixelImage_load(GLApplication *app, const char* file_name, const int pixel_format) {
+    FILE *fp = fopen(file_name, "rb");
+    if (!fp) {
+        __logf("file not found(%s)", file_name);
+        return NULL;
+    }
+
+    RawPixelImage *image = RawPixelImage_decodePng(fp);
+    fclose(fp);
+
+    if (!image) {
+        __logf("png decode error(%s)", file_name);
+        return NULL;
+    }
+
+    if (pixel_format != TEXTURE_RAW_RGBA8) {
+        // 指定フォーマットへ変換する
+        void *pixels = malloc(image->width * image->height * RawPixelImage_getPixelBytes(pixel_format));
+        RawPixelImage_convertColorRGBA(image->pixel_data, pixel_format, pixels, image->width * image->height);
+        free(image->pixel_data);
+        image->pixel_data = pixels;
+        image->format = pixel_format;
+    }
+    return image;
+}
+
+/**
+ * ホストではライン単位の読込を行わないため、常に失敗させる。
+ * 呼び出し元はRawPixelImage_load()による読込へフォールバックする。
+ */
+RawPixelImageStream* RawPixelImageStream_open(GLApplication *app, RawData *raw) {
+    return NULL;
+}
+
+/**
+ * ホストではライン単位の読込を行わない。
+ */
+const void* RawPixelImageStream_readLines(RawPixelImageStream *stream, const int y, const int lines) {
+    return NULL;
+}
+
+/**
+ * ホストではライン単位の読込を行わない。
+ */
+void RawPixelImageStream_close(GLApplication *app, RawPixelImageStream *stream) {
+}
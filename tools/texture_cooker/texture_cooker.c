@@ -0,0 +1,1157 @@
+/*
+ * texture_cooker.c
+ *
+ *  Created on: 2026/10/19
+ */
+#include    <pthread.h>
+#include    <unistd.h>
+#include    <errno.h>
+#include    <sys/stat.h>
+#include    "support.h"
+
+/**
+ * 出力フォーマット
+ */
+#define COOKER_FORMAT_ETC1      0
+#define COOKER_FORMAT_ETC1A     1
+#define COOKER_FORMAT_RGB565    2
+#define COOKER_FORMAT_RGBA8     3
+
+/**
+ * 出力コンテナ
+ */
+#define COOKER_CONTAINER_KTX    0
+#define COOKER_CONTAINER_PKM    1
+
+/**
+ * アセットパックのマニフェスト名
+ * TextureManifest_load()でそのまま読み込める。
+ */
+#define COOKER_MANIFEST_FILE    "textures.manifest"
+
+/**
+ * GL_ETC1_RGB8_OES
+ * ホストのgl2ext.hには定義されていない場合がある
+ */
+#define COOKER_GL_ETC1_RGB8_OES     0x8D64
+
+/**
+ * GL_RGBA8_OES
+ * KTXのglInternalFormatにはサイズ付きのフォーマットを格納する
+ */
+#define COOKER_GL_RGBA8_OES         0x8058
+
+/**
+ * コマンドライン引数
+ */
+typedef struct CookerOption {
+    /**
+     * 出力先ディレクトリ
+     */
+    const char *output_dir;
+
+    /**
+     * COOKER_FORMAT_XXX
+     */
+    int format;
+
+    /**
+     * COOKER_CONTAINER_XXX
+     */
+    int container;
+
+    /**
+     * mipmapを生成する場合true
+     */
+    bool mipmaps;
+
+    /**
+     * 縮小に利用するフィルタ
+     * TEXTURE_RESAMPLE_XXX
+     */
+    int filter;
+
+    /**
+     * アトラス名
+     * NULLの場合は入力画像ごとに出力する
+     */
+    const char *atlas_name;
+
+    /**
+     * チャンネルパック名
+     * 指定された場合、入力画像を1枚のテクスチャの各チャンネルへまとめる
+     */
+    const char *channel_pack_name;
+
+    /**
+     * mipmapチェーン名
+     * 指定された場合、入力画像をレベル0から順に並べた1つのKTXを出力する
+     */
+    const char *mip_chain_name;
+
+    /**
+     * タイルパック名
+     * 指定された場合、入力画像をVirtualTexture用のタイルパックとして出力する
+     */
+    const char *virtual_texture_name;
+
+    /**
+     * タイルパックの1タイルの有効ピクセル数
+     */
+    int tile_size;
+
+    /**
+     * タイルパックのタイル外周に付加するピクセル数
+     */
+    int tile_border;
+
+    /**
+     * アトラスのページサイズ
+     */
+    int page_width;
+    int page_height;
+
+    /**
+     * アトラス内の画像の周囲に確保するピクセル数
+     */
+    int padding;
+
+    /**
+     * 並列実行数
+     */
+    int jobs;
+} CookerOption;
+
+/**
+ * 1ファイル分の出力
+ */
+typedef struct CookerOutput {
+    /**
+     * マニフェストへ記述する論理名
+     */
+    char name[64];
+
+    /**
+     * 入力ファイル
+     * アトラスのページの場合はNULL
+     */
+    const char *input;
+
+    /**
+     * 出力する画像
+     * 入力ファイルから読み込む場合は実行時に設定される
+     */
+    RawPixelImage *image;
+
+    /**
+     * 用意済みのmipmap
+     * 指定された場合、imageは利用せずにこの画像をレベル0から順に出力する
+     */
+    RawPixelImage **mip_images;
+
+    /**
+     * 用意済みのmipmap数
+     */
+    int mip_image_num;
+
+    /**
+     * 出力先のファイル名（出力ディレクトリからの相対パス）
+     */
+    char file_name[128];
+
+    /**
+     * 出力に成功した場合true
+     */
+    bool succeeded;
+} CookerOutput;
+
+/**
+ * 並列実行する処理
+ */
+typedef void (*Cooker_task)(void *context, const int index);
+
+/**
+ * ワーカースレッド間で共有する作業キュー
+ */
+typedef struct CookerQueue {
+    Cooker_task task;
+    void *context;
+    int task_num;
+    int next;
+    pthread_mutex_t mutex;
+} CookerQueue;
+
+/**
+ * アトラスへ格納した画像の位置
+ */
+typedef struct CookerRegion {
+    int page;
+    int x;
+    int y;
+} CookerRegion;
+
+/**
+ * 画像読込時のワーカーへ渡す情報
+ */
+typedef struct CookerLoadContext {
+    char **inputs;
+    RawPixelImage **images;
+} CookerLoadContext;
+
+/**
+ * 画像出力時のワーカーへ渡す情報
+ */
+typedef struct CookerOutputContext {
+    const CookerOption *option;
+    CookerOutput *outputs;
+} CookerOutputContext;
+
+static void Cooker_usage() {
+    printf("usage: texture_cooker [options] image.png...\n");
+    printf("  -o dir        output directory (default: .)\n");
+    printf("  -f format     etc1 / etc1a / rgb565 / rgba8 (default: etc1)\n");
+    printf("  -c container  ktx / pkm (default: ktx, etc1a is always pkm)\n");
+    printf("  -m            generate mipmaps (ktx only)\n");
+    printf("  -r filter     bilinear / bicubic / lanczos (default: bilinear)\n");
+    printf("  -a name       pack all images into atlas pages name_N and name.atlas (TextureAtlasTable_load)\n");
+    printf("  -k name       pack up to 4 masks into the channels of name (etc1: 3)\n");
+    printf("  -l name       write the images as mip levels 0..N of name.ktx\n");
+    printf("  -v name       split one image into the VirtualTexture tile pack name.vtx (rgb565 / rgba8)\n");
+    printf("  -t size       tile pack tile size (default: 256)\n");
+    printf("  -b border     tile pack border pixels (default: 2)\n");
+    printf("  -s WxH        atlas page size (default: 1024x1024)\n");
+    printf("  -p padding    atlas padding pixels (default: 2, use 4 for etc1)\n");
+    printf("  -j jobs       parallel jobs (default: all cores)\n");
+}
+
+/**
+ * キューから処理を取り出して実行する
+ */
+static void* Cooker_worker(void *arg) {
+    CookerQueue *queue = (CookerQueue*) arg;
+
+    while (true) {
+        pthread_mutex_lock(&queue->mutex);
+        const int index = queue->next++;
+        pthread_mutex_unlock(&queue->mutex);
+
+        if (index >= queue->task_num) {
+            return NULL;
+        }
+        queue->task(queue->context, index);
+    }
+}
+
+/**
+ * task(context, 0〜task_num-1)を並列に実行し、全ての完了を待つ。
+ * 各処理は結果を自分のindexの領域にだけ書き込むため、出力は実行順に依存しない。
+ */
+static void Cooker_parallelFor(const int jobs, const int task_num, Cooker_task task, void *context) {
+    CookerQueue queue;
+    queue.task = task;
+    queue.context = context;
+    queue.task_num = task_num;
+    queue.next = 0;
+    pthread_mutex_init(&queue.mutex, NULL);
+
+    const int thread_num = jobs < task_num ? jobs : task_num;
+    pthread_t *threads = (pthread_t*) malloc(sizeof(pthread_t) * (thread_num > 0 ? thread_num : 1));
+
+    int i = 0;
+    for (i = 0; i < thread_num; ++i) {
+        pthread_create(threads + i, NULL, Cooker_worker, &queue);
+    }
+    for (i = 0; i < thread_num; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    free(threads);
+    pthread_mutex_destroy(&queue.mutex);
+}
+
+/**
+ * sizeより大きい最小の2の累乗を取得する
+ */
+static int Cooker_nextPowerOfTwo(const int size) {
+    int result = 1;
+    while (result < size) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * パスからディレクトリと拡張子を取り除く
+ */
+static void Cooker_getBaseName(const char *path, char *result, const int result_size) {
+    const char *name = strrchr(path, '/');
+    name = name ? name + 1 : path;
+
+    snprintf(result, result_size, "%s", name);
+    char *ext = strrchr(result, '.');
+    if (ext && ext != result) {
+        (*ext) = '\0';
+    }
+}
+
+/**
+ * 1レベル分の画像をエンコードする。
+ * 戻り値はfree()で解放し、長さはresult_bytesへ格納される。
+ */
+static void* Cooker_encodeLevel(const RawPixelImage *image, const int format, int *result_bytes) {
+    const int pixel_num = image->width * image->height;
+
+    switch (format) {
+        case COOKER_FORMAT_ETC1: {
+            (*result_bytes) = ((image->width + 3) / 4) * ((image->height + 3) / 4) * 8;
+            void *result = malloc(*result_bytes);
+            Etc1_encodeImage(image->pixel_data, image->format, image->width, image->height, false, result);
+            return result;
+        }
+        case COOKER_FORMAT_RGB565: {
+            // KTXの各ラインは4byte境界に揃える
+            const int line_bytes = (image->width * 2 + 3) & ~0x3;
+            (*result_bytes) = line_bytes * image->height;
+            uint8_t *result = (uint8_t*) calloc(1, *result_bytes);
+            uint8_t *line = (uint8_t*) malloc(image->width * 2);
+
+            int y = 0;
+            for (y = 0; y < image->height; ++y) {
+                RawPixelImage_convertColorRGBA(((const uint8_t*) image->pixel_data) + y * image->width * 4, TEXTURE_RAW_RGB565, line, image->width);
+                memcpy(result + y * line_bytes, line, image->width * 2);
+            }
+            free(line);
+            return result;
+        }
+        default: {
+            (*result_bytes) = pixel_num * 4;
+            void *result = malloc(*result_bytes);
+            memcpy(result, image->pixel_data, *result_bytes);
+            return result;
+        }
+    }
+}
+
+/**
+ * mipmapを含むKTXファイルを書き込む
+ */
+static bool Cooker_writeKtx(const char *path, RawPixelImage **levels, const int level_num, const int format) {
+    FILE *fp = fopen(path, "wb");
+    if (!fp) {
+        __logf("file open error(%s)", path);
+        return false;
+    }
+
+    {
+        const uint8_t KTXFileIdentifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+        fwrite(KTXFileIdentifier, 1, sizeof(KTXFileIdentifier), fp);
+    }
+
+    {
+        // エンディアンチェックを含め、全てホストのバイトオーダーで書き込む
+        // glType, glTypeSize, glFormat, glInternalFormat, glBaseInternalFormat
+        uint32_t header[13] = { 0x04030201, 0, 1, 0, COOKER_GL_ETC1_RGB8_OES, GL_RGB };
+        if (format == COOKER_FORMAT_RGB565) {
+            header[1] = GL_UNSIGNED_SHORT_5_6_5;
+            header[2] = 2;
+            header[3] = header[5] = GL_RGB;
+            header[4] = GL_RGB565;
+        } else if (format == COOKER_FORMAT_RGBA8) {
+            header[1] = GL_UNSIGNED_BYTE;
+            header[2] = 1;
+            header[3] = header[5] = GL_RGBA;
+            header[4] = COOKER_GL_RGBA8_OES;
+        }
+        header[6] = levels[0]->width;
+        header[7] = levels[0]->height;
+        header[8] = 0; // pixelDepth
+        header[9] = 0; // numberOfArrayElements
+        header[10] = 1; // numberOfFaces
+        header[11] = level_num;
+        header[12] = 0; // bytesOfKeyValueData
+        fwrite(header, sizeof(uint32_t), 13, fp);
+    }
+
+    int i = 0;
+    for (i = 0; i < level_num; ++i) {
+        // 各レベルのサイズは4の倍数になるため、mipPaddingは不要
+        int bytes = 0;
+        void *data = Cooker_encodeLevel(levels[i], format, &bytes);
+        const uint32_t image_size = bytes;
+        fwrite(&image_size, sizeof(uint32_t), 1, fp);
+        fwrite(data, 1, bytes, fp);
+        free(data);
+    }
+
+    const bool result = (ferror(fp) == 0);
+    fclose(fp);
+    return result;
+}
+
+/**
+ * PKMファイルを書き込む
+ */
+static bool Cooker_writePkm(const char *path, const RawPixelImage *image, const bool with_alpha) {
+    FILE *fp = fopen(path, "wb");
+    if (!fp) {
+        __logf("file open error(%s)", path);
+        return false;
+    }
+
+    int bytes = 0;
+    void *data = PkmImage_encode(image, with_alpha, &bytes);
+    if (!data) {
+        fclose(fp);
+        return false;
+    }
+    fwrite(data, 1, bytes, fp);
+    free(data);
+
+    const bool result = (ferror(fp) == 0);
+    fclose(fp);
+    return result;
+}
+
+/**
+ * 1ファイル分の変換を行う
+ */
+static void Cooker_cookOutput(void *context, const int index) {
+    CookerOutputContext *ctx = (CookerOutputContext*) context;
+    const CookerOption *option = ctx->option;
+    CookerOutput *output = ctx->outputs + index;
+
+    if (!output->image && !output->mip_images) {
+        output->image = RawPixelImage_load(NULL, output->input, TEXTURE_RAW_RGBA8);
+        if (!output->image) {
+            return;
+        }
+    }
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", option->output_dir, output->file_name);
+
+    if (output->mip_images) {
+        output->succeeded = Cooker_writeKtx(path, output->mip_images, output->mip_image_num, option->format);
+
+        int i = 0;
+        for (i = 0; i < output->mip_image_num; ++i) {
+            RawPixelImage_free(NULL, output->mip_images[i]);
+        }
+        free(output->mip_images);
+        output->mip_images = NULL;
+    } else if (option->container == COOKER_CONTAINER_PKM) {
+        output->succeeded = Cooker_writePkm(path, output->image, option->format == COOKER_FORMAT_ETC1A);
+    } else {
+        int level_num = 1;
+        RawPixelImage *levels[32] = { output->image };
+        bool resampled = true;
+
+        if (option->mipmaps) {
+            if (Cooker_nextPowerOfTwo(levels[0]->width) != levels[0]->width || Cooker_nextPowerOfTwo(levels[0]->height) != levels[0]->height) {
+                // OpenGL ES 2.0ではNPOTテクスチャのmipmapを利用できないため、2の累乗へ拡大する
+                RawPixelImage *resized = RawPixelImage_resample(output->image, Cooker_nextPowerOfTwo(output->image->width), Cooker_nextPowerOfTwo(output->image->height), option->filter);
+                if (resized) {
+                    levels[0] = resized;
+                    __logf("%s : resize %d x %d -> %d x %d", output->name, output->image->width, output->image->height, levels[0]->width, levels[0]->height);
+                } else {
+                    resampled = false;
+                }
+            }
+
+            // 1つ前のレベルを縮小して次のレベルを作る
+            while (resampled && (levels[level_num - 1]->width > 1 || levels[level_num - 1]->height > 1)) {
+                const RawPixelImage *prev = levels[level_num - 1];
+                levels[level_num] = RawPixelImage_resample(prev, prev->width > 1 ? prev->width / 2 : 1, prev->height > 1 ? prev->height / 2 : 1, option->filter);
+                if (!levels[level_num]) {
+                    resampled = false;
+                    break;
+                }
+                ++level_num;
+            }
+        }
+
+        if (resampled) {
+            output->succeeded = Cooker_writeKtx(path, levels, level_num, option->format);
+        } else {
+            __logf("%s : mipmap resample error", output->name);
+            output->succeeded = false;
+        }
+
+        int i = 0;
+        for (i = 0; i < level_num; ++i) {
+            if (levels[i] != output->image) {
+                RawPixelImage_free(NULL, levels[i]);
+            }
+        }
+    }
+
+    __logf("%s -> %s%s", output->input ? output->input : output->name, output->file_name, output->succeeded ? "" : " (failed)");
+    RawPixelImage_free(NULL, output->image);
+    output->image = NULL;
+}
+
+/**
+ * アトラス / チャンネルパック用に画像を読み込む
+ */
+static void Cooker_loadImage(void *context, const int index) {
+    CookerLoadContext *ctx = (CookerLoadContext*) context;
+    ctx->images[index] = RawPixelImage_load(NULL, ctx->inputs[index], TEXTURE_RAW_RGBA8);
+}
+
+/**
+ * アトラスの配置順
+ * 高さの降順、同じ高さは入力順とし、実行ごとに同じ配置となるようにする
+ */
+static RawPixelImage **Cooker_sortImages = NULL;
+
+static int Cooker_compareImage(const void *a, const void *b) {
+    const int ia = *((const int*) a);
+    const int ib = *((const int*) b);
+    const int diff = Cooker_sortImages[ib]->height - Cooker_sortImages[ia]->height;
+    return diff ? diff : ia - ib;
+}
+
+/**
+ * 入力画像をアトラスのページへ配置し、ページ画像を出力対象として作成する。
+ * 戻り値はページ数で、失敗した場合は-1を返す。
+ */
+static int Cooker_packAtlas(const CookerOption *option, char **inputs, const int input_num, CookerOutput **result_pages) {
+    RawPixelImage **images = (RawPixelImage**) calloc(input_num, sizeof(RawPixelImage*));
+    CookerRegion *regions = (CookerRegion*) calloc(input_num, sizeof(CookerRegion));
+    int *order = (int*) malloc(sizeof(int) * input_num);
+    TextureAtlasPage *pages = NULL;
+    int page_num = 0;
+    int result = -1;
+    int i = 0;
+
+    {
+        // デコードは並列で行う
+        CookerLoadContext ctx = { inputs, images };
+        Cooker_parallelFor(option->jobs, input_num, Cooker_loadImage, &ctx);
+    }
+
+    for (i = 0; i < input_num; ++i) {
+        if (!images[i]) {
+            goto cleanup;
+        }
+        order[i] = i;
+    }
+
+    // 配置は順序に依存するため、単一スレッドで行う
+    Cooker_sortImages = images;
+    qsort(order, input_num, sizeof(int), Cooker_compareImage);
+
+    for (i = 0; i < input_num; ++i) {
+        const int index = order[i];
+        const int padded_width = images[index]->width + option->padding * 2;
+        const int padded_height = images[index]->height + option->padding * 2;
+
+        if (padded_width > option->page_width || padded_height > option->page_height) {
+            __logf("atlas image too large(%s %d x %d)", inputs[index], images[index]->width, images[index]->height);
+            goto cleanup;
+        }
+
+        int page = 0;
+        int x = 0;
+        int y = 0;
+        for (page = 0; page < page_num; ++page) {
+            if (TextureAtlasPage_allocRect(pages + page, option->page_width, option->page_height, padded_width, padded_height, &x, &y)) {
+                break;
+            }
+        }
+        if (page == page_num) {
+            pages = (TextureAtlasPage*) realloc(pages, sizeof(TextureAtlasPage) * (page_num + 1));
+            pages[page_num].texture = NULL;
+            TextureAtlasPage_initSkyline(pages + page_num, option->page_width);
+            ++page_num;
+            TextureAtlasPage_allocRect(pages + page, option->page_width, option->page_height, padded_width, padded_height, &x, &y);
+        }
+
+        regions[index].page = page;
+        regions[index].x = x + option->padding;
+        regions[index].y = y + option->padding;
+    }
+
+    {
+        // 画像ごとの配置を書き出す
+        // ページ画像を作成する前に行い、失敗時に解放するものを増やさない
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.atlas", option->output_dir, option->atlas_name);
+        FILE *fp = fopen(path, "w");
+        if (!fp) {
+            __logf("file open error(%s)", path);
+            goto cleanup;
+        }
+
+        fprintf(fp, "# image page x y width height\n");
+        for (i = 0; i < input_num; ++i) {
+            char name[64];
+            Cooker_getBaseName(inputs[i], name, sizeof(name));
+            fprintf(fp, "%s %d %d %d %d %d\n", name, regions[i].page, regions[i].x, regions[i].y, images[i]->width, images[i]->height);
+        }
+        fclose(fp);
+        __logf("%s.atlas : %d images / %d pages", option->atlas_name, input_num, page_num);
+    }
+
+    {
+        // ページ画像を作成する
+        CookerOutput *outputs = (CookerOutput*) calloc(page_num, sizeof(CookerOutput));
+        for (i = 0; i < page_num; ++i) {
+            RawPixelImage *image = (RawPixelImage*) malloc(sizeof(RawPixelImage));
+            image->format = TEXTURE_RAW_RGBA8;
+            image->width = option->page_width;
+            image->height = option->page_height;
+            image->pixel_data = calloc(1, option->page_width * option->page_height * 4);
+
+            snprintf(outputs[i].name, sizeof(outputs[i].name), "%s_%d", option->atlas_name, i);
+            outputs[i].image = image;
+        }
+
+        for (i = 0; i < input_num; ++i) {
+            // 画像の端を引き伸ばして余白を埋める
+            const RawPixelImage *src = images[i];
+            uint8_t *dst = (uint8_t*) outputs[regions[i].page].image->pixel_data;
+            const int padding = option->padding;
+
+            int px = 0;
+            int py = 0;
+            for (py = -padding; py < src->height + padding; ++py) {
+                const int sy = py < 0 ? 0 : (py >= src->height ? src->height - 1 : py);
+                for (px = -padding; px < src->width + padding; ++px) {
+                    const int sx = px < 0 ? 0 : (px >= src->width ? src->width - 1 : px);
+                    memcpy(dst + ((regions[i].y + py) * option->page_width + regions[i].x + px) * 4, ((const uint8_t*) src->pixel_data) + (sy * src->width + sx) * 4, 4);
+                }
+            }
+        }
+        (*result_pages) = outputs;
+        result = page_num;
+    }
+
+    cleanup: {
+        for (i = 0; i < input_num; ++i) {
+            RawPixelImage_free(NULL, images[i]);
+        }
+        if (pages) {
+            for (i = 0; i < page_num; ++i) {
+                free(pages[i].skyline);
+            }
+            free(pages);
+        }
+        free(images);
+        free(regions);
+        free(order);
+    }
+    return result;
+}
+
+/**
+ * 入力画像を1枚の画像の各チャンネルへまとめ、出力対象として作成する。
+ */
+static bool Cooker_packChannels(const CookerOption *option, char **inputs, const int input_num, CookerOutput **result_output) {
+    const RawPixelImage *images[TEXTURE_CHANNEL_PACK_MAX] = { NULL };
+    bool result = false;
+    int i = 0;
+
+    {
+        CookerLoadContext ctx = { inputs, (RawPixelImage**) images };
+        Cooker_parallelFor(option->jobs, input_num, Cooker_loadImage, &ctx);
+    }
+
+    for (i = 0; i < input_num; ++i) {
+        if (!images[i]) {
+            goto cleanup;
+        }
+    }
+
+    RawPixelImage *packed = RawPixelImage_packChannels(images, input_num);
+    if (!packed) {
+        goto cleanup;
+    }
+
+    {
+        // 画像ごとの格納チャンネルを書き出す
+        const char CHANNEL_NAMES[TEXTURE_CHANNEL_PACK_MAX] = { 'r', 'g', 'b', 'a' };
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.channels", option->output_dir, option->channel_pack_name);
+        FILE *fp = fopen(path, "w");
+        if (!fp) {
+            __logf("file open error(%s)", path);
+            RawPixelImage_free(NULL, packed);
+            goto cleanup;
+        }
+
+        fprintf(fp, "# image channel\n");
+        for (i = 0; i < input_num; ++i) {
+            char name[64];
+            Cooker_getBaseName(inputs[i], name, sizeof(name));
+            fprintf(fp, "%s %c\n", name, CHANNEL_NAMES[i]);
+        }
+        fclose(fp);
+        __logf("%s.channels : %d masks", option->channel_pack_name, input_num);
+    }
+
+    CookerOutput *output = (CookerOutput*) calloc(1, sizeof(CookerOutput));
+    snprintf(output->name, sizeof(output->name), "%s", option->channel_pack_name);
+    output->image = packed;
+    (*result_output) = output;
+    result = true;
+
+    cleanup: {
+        for (i = 0; i < input_num; ++i) {
+            RawPixelImage_free(NULL, (RawPixelImage*) images[i]);
+        }
+    }
+    return result;
+}
+
+/**
+ * 入力画像をmipmapとして並べ、出力対象として作成する。
+ * 各画像は1つ前の画像の半分のサイズ(最小1)である必要がある。
+ */
+static bool Cooker_loadMipChain(const CookerOption *option, char **inputs, const int input_num, CookerOutput **result_output) {
+    RawPixelImage **images = (RawPixelImage**) calloc(input_num, sizeof(RawPixelImage*));
+    int i = 0;
+
+    {
+        CookerLoadContext ctx = { inputs, images };
+        Cooker_parallelFor(option->jobs, input_num, Cooker_loadImage, &ctx);
+    }
+
+    for (i = 0; i < input_num; ++i) {
+        if (!images[i]) {
+            goto error;
+        }
+
+        const int width = images[0]->width >> i;
+        const int height = images[0]->height >> i;
+        if (images[i]->width != (width > 1 ? width : 1) || images[i]->height != (height > 1 ? height : 1)) {
+            __logf("invalid mipmap size(%s level %d : %d x %d)", inputs[i], i, images[i]->width, images[i]->height);
+            goto error;
+        }
+    }
+
+    if (Cooker_nextPowerOfTwo(images[0]->width) != images[0]->width || Cooker_nextPowerOfTwo(images[0]->height) != images[0]->height) {
+        __logf("mipmap requires power of two(%s %d x %d)", inputs[0], images[0]->width, images[0]->height);
+        goto error;
+    }
+
+    CookerOutput *output = (CookerOutput*) calloc(1, sizeof(CookerOutput));
+    snprintf(output->name, sizeof(output->name), "%s", option->mip_chain_name);
+    output->mip_images = images;
+    output->mip_image_num = input_num;
+    (*result_output) = output;
+    return true;
+
+    error: {
+        for (i = 0; i < input_num; ++i) {
+            RawPixelImage_free(NULL, images[i]);
+        }
+        free(images);
+    }
+    return false;
+}
+
+/**
+ * Little Endianで整数を書き込む
+ */
+static void Cooker_writeLE(FILE *fp, const uint64_t value, const int bytes) {
+    int i = 0;
+    for (i = 0; i < bytes; ++i) {
+        fputc((int) ((value >> (i * 8)) & 0xFF), fp);
+    }
+}
+
+/**
+ * 1レベル分の画像を外周付きのタイルへ分割して書き込む。
+ * 画像外の領域は端のピクセルで埋める。
+ */
+static void Cooker_writeTiles(FILE *fp, const RawPixelImage *image, const CookerOption *option, const int pixel_format) {
+    const int stride = option->tile_size + option->tile_border * 2;
+    const int pixel_bytes = RawPixelImage_getPixelBytes(pixel_format);
+    const int tiles_x = (image->width + option->tile_size - 1) / option->tile_size;
+    const int tiles_y = (image->height + option->tile_size - 1) / option->tile_size;
+    uint8_t *rgba_line = (uint8_t*) malloc(stride * 4);
+    uint8_t *line = (uint8_t*) malloc(stride * pixel_bytes);
+
+    int tile_x = 0;
+    int tile_y = 0;
+    for (tile_y = 0; tile_y < tiles_y; ++tile_y) {
+        for (tile_x = 0; tile_x < tiles_x; ++tile_x) {
+            int x = 0;
+            int y = 0;
+            for (y = 0; y < stride; ++y) {
+                int src_y = tile_y * option->tile_size + y - option->tile_border;
+                src_y = src_y < 0 ? 0 : (src_y >= image->height ? image->height - 1 : src_y);
+                const uint32_t *src = ((const uint32_t*) image->pixel_data) + src_y * image->width;
+
+                for (x = 0; x < stride; ++x) {
+                    int src_x = tile_x * option->tile_size + x - option->tile_border;
+                    src_x = src_x < 0 ? 0 : (src_x >= image->width ? image->width - 1 : src_x);
+                    memcpy(rgba_line + x * 4, src + src_x, 4);
+                }
+
+                RawPixelImage_convertColorRGBA(rgba_line, pixel_format, line, stride);
+                fwrite(line, pixel_bytes, stride, fp);
+            }
+        }
+    }
+
+    free(line);
+    free(rgba_line);
+}
+
+/**
+ * 入力画像をVirtualTexture用のタイルパックとして書き込む。
+ * レベル0から1/2ずつ縮小し、1タイルに収まるレベルまでを格納する。
+ * ヘッダとオフセット表の形式はsupport_gl_VirtualTexture.hを参照。
+ */
+static bool Cooker_writeVirtualTexture(const CookerOption *option, const char *input) {
+    RawPixelImage *level_image = RawPixelImage_load(NULL, input, TEXTURE_RAW_RGBA8);
+    if (!level_image) {
+        return false;
+    }
+
+    const int pixel_format = option->format == COOKER_FORMAT_RGB565 ? TEXTURE_RAW_RGB565 : TEXTURE_RAW_RGBA8;
+    const int stride = option->tile_size + option->tile_border * 2;
+    const int64_t tile_bytes = (int64_t) stride * stride * RawPixelImage_getPixelBytes(pixel_format);
+    const int width = level_image->width;
+    const int height = level_image->height;
+
+    // レベル数と総タイル数を求める
+    int levels = 0;
+    int page_num = 0;
+    while (true) {
+        const int level_width = (width >> levels) > 0 ? (width >> levels) : 1;
+        const int level_height = (height >> levels) > 0 ? (height >> levels) : 1;
+        page_num += ((level_width + option->tile_size - 1) / option->tile_size) * ((level_height + option->tile_size - 1) / option->tile_size);
+        ++levels;
+
+        if (level_width <= option->tile_size && level_height <= option->tile_size) {
+            break;
+        }
+    }
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.vtx", option->output_dir, option->virtual_texture_name);
+    FILE *fp = fopen(path, "wb");
+    if (!fp) {
+        __logf("file open error(%s)", path);
+        RawPixelImage_free(NULL, level_image);
+        return false;
+    }
+
+    {
+        fwrite("VTX2", 1, 4, fp);
+        Cooker_writeLE(fp, width, 4);
+        Cooker_writeLE(fp, height, 4);
+        Cooker_writeLE(fp, option->tile_size, 4);
+        Cooker_writeLE(fp, option->tile_border, 4);
+        Cooker_writeLE(fp, pixel_format, 4);
+        Cooker_writeLE(fp, levels, 4);
+
+        // 全タイルは同じサイズのため、オフセットはページ番号から決まる
+        const int64_t first_tile = 28 + (int64_t) sizeof(int64_t) * (page_num + 1);
+        int page = 0;
+        for (page = 0; page <= page_num; ++page) {
+            Cooker_writeLE(fp, (uint64_t) (first_tile + tile_bytes * page), 8);
+        }
+    }
+
+    int level = 0;
+    for (level = 0; level < levels; ++level) {
+        if (level > 0) {
+            const int level_width = (width >> level) > 0 ? (width >> level) : 1;
+            const int level_height = (height >> level) > 0 ? (height >> level) : 1;
+            RawPixelImage *next = RawPixelImage_resample(level_image, level_width, level_height, option->filter);
+            RawPixelImage_free(NULL, level_image);
+            level_image = next;
+            if (!level_image) {
+                // 書きかけのタイルパックは読み込めないため削除する
+                __logf("%s : level(%d) resample error", input, level);
+                fclose(fp);
+                remove(path);
+                return false;
+            }
+        }
+        Cooker_writeTiles(fp, level_image, option, pixel_format);
+    }
+    RawPixelImage_free(NULL, level_image);
+
+    const bool result = (ferror(fp) == 0);
+    fclose(fp);
+    __logf("%s -> %s.vtx : %d x %d, %d levels, %d tiles%s", input, option->virtual_texture_name, width, height, levels, page_num, result ? "" : " (failed)");
+    return result;
+}
+
+/**
+ * マニフェストへ記述するフォーマット名を取得する
+ */
+static const char* Cooker_getManifestFormat(const CookerOption *option) {
+    switch (option->format) {
+        case COOKER_FORMAT_ETC1:
+            return option->container == COOKER_CONTAINER_KTX ? "ktx_etc1" : "etc1";
+        case COOKER_FORMAT_ETC1A:
+            return "etc1a";
+        case COOKER_FORMAT_RGB565:
+            return "rgb565";
+        default:
+            return "rgba8";
+    }
+}
+
+/**
+ * 引数を解析する
+ */
+static bool Cooker_parseOption(int argc, char **argv, CookerOption *option) {
+    option->output_dir = ".";
+    option->format = COOKER_FORMAT_ETC1;
+    option->container = COOKER_CONTAINER_KTX;
+    option->mipmaps = false;
+    option->filter = TEXTURE_RESAMPLE_BILINEAR;
+    option->atlas_name = NULL;
+    option->channel_pack_name = NULL;
+    option->mip_chain_name = NULL;
+    option->virtual_texture_name = NULL;
+    option->tile_size = 256;
+    option->tile_border = 2;
+    option->page_width = 1024;
+    option->page_height = 1024;
+    option->padding = 2;
+    option->jobs = (int) sysconf(_SC_NPROCESSORS_ONLN);
+
+    int opt = 0;
+    while ((opt = getopt(argc, argv, "o:f:c:mr:a:k:l:v:t:b:s:p:j:h")) != -1) {
+        switch (opt) {
+            case 'o':
+                option->output_dir = optarg;
+                break;
+            case 'f':
+                if (!strcmp(optarg, "etc1")) {
+                    option->format = COOKER_FORMAT_ETC1;
+                } else if (!strcmp(optarg, "etc1a")) {
+                    option->format = COOKER_FORMAT_ETC1A;
+                } else if (!strcmp(optarg, "rgb565")) {
+                    option->format = COOKER_FORMAT_RGB565;
+                } else if (!strcmp(optarg, "rgba8")) {
+                    option->format = COOKER_FORMAT_RGBA8;
+                } else {
+                    __logf("unknown format(%s)", optarg);
+                    return false;
+                }
+                break;
+            case 'c':
+                if (!strcmp(optarg, "ktx")) {
+                    option->container = COOKER_CONTAINER_KTX;
+                } else if (!strcmp(optarg, "pkm")) {
+                    option->container = COOKER_CONTAINER_PKM;
+                } else {
+                    __logf("unknown container(%s)", optarg);
+                    return false;
+                }
+                break;
+            case 'm':
+                option->mipmaps = true;
+                break;
+            case 'r':
+                if (!strcmp(optarg, "bilinear")) {
+                    option->filter = TEXTURE_RESAMPLE_BILINEAR;
+                } else if (!strcmp(optarg, "bicubic")) {
+                    option->filter = TEXTURE_RESAMPLE_BICUBIC;
+                } else if (!strcmp(optarg, "lanczos")) {
+                    option->filter = TEXTURE_RESAMPLE_LANCZOS;
+                } else {
+                    __logf("unknown filter(%s)", optarg);
+                    return false;
+                }
+                break;
+            case 'a':
+                option->atlas_name = optarg;
+                break;
+            case 'k':
+                option->channel_pack_name = optarg;
+                break;
+            case 'l':
+                option->mip_chain_name = optarg;
+                break;
+            case 'v':
+                option->virtual_texture_name = optarg;
+                break;
+            case 't':
+                option->tile_size = atoi(optarg);
+                break;
+            case 'b':
+                option->tile_border = atoi(optarg);
+                break;
+            case 's':
+                if (sscanf(optarg, "%dx%d", &option->page_width, &option->page_height) != 2 || option->page_width <= 0 || option->page_height <= 0) {
+                    __logf("invalid page size(%s)", optarg);
+                    return false;
+                }
+                break;
+            case 'p':
+                option->padding = atoi(optarg);
+                break;
+            case 'j':
+                option->jobs = atoi(optarg);
+                break;
+            default:
+                return false;
+        }
+    }
+
+    if (option->jobs < 1) {
+        option->jobs = 1;
+    }
+    if (option->padding < 0) {
+        option->padding = 0;
+    }
+
+    if (option->virtual_texture_name) {
+        if (option->format != COOKER_FORMAT_RGB565 && option->format != COOKER_FORMAT_RGBA8) {
+            __log("tile pack supports rgb565 / rgba8 only");
+            return false;
+        }
+        if (option->atlas_name || option->channel_pack_name || option->mip_chain_name) {
+            __log("-v cannot be used with -a / -k / -l");
+            return false;
+        }
+        if (option->tile_size <= 0 || option->tile_border < 0) {
+            __log("invalid tile size / border");
+            return false;
+        }
+        if ((argc - optind) != 1) {
+            __log("tile pack accepts one image");
+            return false;
+        }
+        return true;
+    }
+
+    if (option->format == COOKER_FORMAT_ETC1A) {
+        // ETC1AはPKM形式でのみ扱える
+        option->container = COOKER_CONTAINER_PKM;
+    }
+    if (option->container == COOKER_CONTAINER_PKM) {
+        if (option->format == COOKER_FORMAT_RGB565 || option->format == COOKER_FORMAT_RGBA8) {
+            __log("pkm container supports etc1 / etc1a only");
+            return false;
+        }
+        if (option->mipmaps) {
+            __log("pkm container has no mipmaps, -m is ignored");
+            option->mipmaps = false;
+        }
+    }
+    if (option->mip_chain_name) {
+        if (option->container != COOKER_CONTAINER_KTX) {
+            __log("mipmap chain requires ktx container");
+            return false;
+        }
+        if (option->atlas_name || option->channel_pack_name) {
+            __log("-l cannot be used with -a / -k");
+            return false;
+        }
+        option->mipmaps = false;
+    }
+    if (option->channel_pack_name) {
+        const int max_channels = option->format == COOKER_FORMAT_ETC1 ? 3 : TEXTURE_CHANNEL_PACK_MAX;
+        if (option->format != COOKER_FORMAT_ETC1 && option->format != COOKER_FORMAT_RGBA8) {
+            __log("channel pack supports etc1 / rgba8 only");
+            return false;
+        }
+        if (option->atlas_name) {
+            __log("-a and -k cannot be used together");
+            return false;
+        }
+        if (argc - optind > max_channels) {
+            __logf("channel pack accepts up to %d images", max_channels);
+            return false;
+        }
+    }
+    return optind < argc;
+}
+
+int main(int argc, char **argv) {
+    CookerOption option;
+    if (!Cooker_parseOption(argc, argv, &option)) {
+        Cooker_usage();
+        return 1;
+    }
+
+    if (mkdir(option.output_dir, 0755) != 0 && errno != EEXIST) {
+        __logf("mkdir error(%s)", option.output_dir);
+        return 1;
+    }
+
+    char **inputs = argv + optind;
+    const int input_num = argc - optind;
+
+    if (option.virtual_texture_name) {
+        // タイルパックはTextureManifestの対象外のため、マニフェストは書き込まない
+        return Cooker_writeVirtualTexture(&option, inputs[0]) ? 0 : 1;
+    }
+
+    const char *extension = option.container == COOKER_CONTAINER_KTX ? "ktx" : "pkm";
+
+    CookerOutput *outputs = NULL;
+    int output_num = 0;
+    int i = 0;
+
+    if (option.mip_chain_name) {
+        if (!Cooker_loadMipChain(&option, inputs, input_num, &outputs)) {
+            return 1;
+        }
+        output_num = 1;
+    } else if (option.channel_pack_name) {
+        if (!Cooker_packChannels(&option, inputs, input_num, &outputs)) {
+            return 1;
+        }
+        output_num = 1;
+    } else if (option.atlas_name) {
+        output_num = Cooker_packAtlas(&option, inputs, input_num, &outputs);
+        if (output_num < 0) {
+            return 1;
+        }
+    } else {
+        output_num = input_num;
+        outputs = (CookerOutput*) calloc(output_num, sizeof(CookerOutput));
+        for (i = 0; i < input_num; ++i) {
+            Cooker_getBaseName(inputs[i], outputs[i].name, sizeof(outputs[i].name));
+            outputs[i].input = inputs[i];
+        }
+    }
+
+    for (i = 0; i < output_num; ++i) {
+        snprintf(outputs[i].file_name, sizeof(outputs[i].file_name), "%s.%s", outputs[i].name, extension);
+    }
+
+    {
+        // デコード / mipmap生成 / エンコードはファイル単位で並列に行う
+        CookerOutputContext ctx = { &option, outputs };
+        Cooker_parallelFor(option.jobs, output_num, Cooker_cookOutput, &ctx);
+    }
+
+    bool succeeded = true;
+    {
+        // マニフェストは入力順に書き込み、並列数によらず同じ内容にする
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", option.output_dir, COOKER_MANIFEST_FILE);
+        FILE *fp = fopen(path, "w");
+        if (!fp) {
+            __logf("file open error(%s)", path);
+            free(outputs);
+            return 1;
+        }
+
+        fprintf(fp, "# generated by texture_cooker\n");
+        for (i = 0; i < output_num; ++i) {
+            if (outputs[i].succeeded) {
+                fprintf(fp, "%s %s %s\n", outputs[i].name, Cooker_getManifestFormat(&option), outputs[i].file_name);
+            } else {
+                succeeded = false;
+            }
+        }
+        fclose(fp);
+    }
+
+    free(outputs);
+    return succeeded ? 0 : 1;
+}